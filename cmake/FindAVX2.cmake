@@ -0,0 +1,18 @@
+# Autodetect if AVX2 can be used. This only checks whether the compiler can
+# generate AVX2 code; whether the CPU supports it is checked at runtime.
+
+include(CheckCXXSourceCompiles)
+set(OLD_CMAKE_REQUIRED_FLAGS ${CMAKE_REQUIRED_FLAGS})
+set(CMAKE_REQUIRED_FLAGS "")
+
+if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID STREQUAL "Clang" OR CMAKE_CXX_COMPILER_ID STREQUAL "AppleClang")
+    set(CMAKE_REQUIRED_FLAGS "-mavx2")
+endif()
+
+check_cxx_source_compiles("
+    #include <immintrin.h>
+    int main() { __m256i a = _mm256_setzero_si256(); a = _mm256_add_epi16(a, a); return _mm256_movemask_epi8(a); }"
+    AVX2_FOUND
+)
+
+set(CMAKE_REQUIRED_FLAGS ${OLD_CMAKE_REQUIRED_FLAGS})
@@ -15,6 +15,7 @@
 #include "../network/network.h"
 #include "../window_func.h"
 #include "../framerate_type.h"
+#include "../zone_profiler.h"
 #include "../scope_info.h"
 #include "../string_func.h"
 #include "ai_scanner.hpp"
@@ -99,10 +100,14 @@ size_t previous_index = 0;
 			continue;
 		}
 		if (c->is_ai) {
-			SCOPE_INFO_FMT([&], "AI::GameLoop: {}: {} (v{})\n", (int)c->index, c->ai_info->GetName(), c->ai_info->GetVersion());
 			PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
-			cur_company.Change(c->index);
-			c->ai_instance->GameLoop();
+			/* Most AIs are sleeping for most ticks, those do not need to switch to the AI and its VM. */
+			if (!c->ai_instance->SkipSleepingTick()) {
+				SCOPE_INFO_FMT([&], "AI::GameLoop: {}: {} (v{})\n", (int)c->index, c->ai_info->GetName(), c->ai_info->GetVersion());
+				ZoneProfilerScope zone(ZPZ_SCRIPT_AI, c->index);
+				cur_company.Change(c->index);
+				c->ai_instance->GameLoop();
+			}
 			/* Occasionally collect garbage; every 255 ticks do one company.
 			 * Effectively collecting garbage once every two months per AI. */
 			if ((AI::frame_counter & 255) == 0 && (CompanyID)GB(AI::frame_counter, 8, 4) == c->index) {
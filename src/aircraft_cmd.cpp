@@ -1347,7 +1347,7 @@ static void HandleAircraftSmoke(Aircraft *v, bool mode)
 
 	/* Spawn effect et most once per Tick, i.e. !mode */
 	if (!mode && (v->tick_counter & 0x0F) == 0) {
-		CreateEffectVehicleRel(v,
+		CreateEffectParticleRel(v,
 			smoke_pos[v->direction].x,
 			smoke_pos[v->direction].y,
 			2,
@@ -359,6 +359,29 @@ void Blitter_32bppAnim::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomL
 	}
 }
 
+void Blitter_32bppAnim::DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+{
+	if (_screen_disable_anim) {
+		/* This means our output is not to the screen, so we can't be doing any animation stuff, so use our parent DrawGlyphRun() */
+		Blitter_32bppOptimized::DrawGlyphRun(glyphs, mode);
+		return;
+	}
+
+	if (mode != BlitterMode::ColourRemap) {
+		this->Blitter::DrawGlyphRun(glyphs, mode);
+		return;
+	}
+
+	for (Blitter::BlitterParams &bp : glyphs) {
+		if (((const SpriteData *) bp.sprite)->flags & BSF_NO_REMAP) {
+			/* Glyphs with their own colours, e.g. emoji. */
+			this->Draw(&bp, mode, ZOOM_LVL_MIN);
+		} else {
+			Draw<BlitterMode::ColourRemap, false>(&bp, ZOOM_LVL_MIN);
+		}
+	}
+}
+
 void Blitter_32bppAnim::DrawColourMappingRect(void *dst, int width, int height, PaletteID pal)
 {
 	if (_screen_disable_anim) {
@@ -33,6 +33,7 @@ public:
 	}
 
 	void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) override;
+	void DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode) override;
 	void DrawColourMappingRect(void *dst, int width, int height, PaletteID pal) override;
 	void SetPixel(void *video, int x, int y, uint16_t colour) override;
 	void SetPixel32(void *video, int x, int y, uint8_t colour, uint32_t colour32) override;
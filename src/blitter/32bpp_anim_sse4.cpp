@@ -518,4 +518,33 @@ bm_normal:
 	}
 }
 
+/**
+ * Draws a run of glyphs, the blitter mode is only dispatched once for the whole run.
+ *
+ * @param glyphs blitting parameters of each glyph
+ * @param mode blitter mode
+ */
+void Blitter_32bppSSE4_Anim::DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+{
+	if (_screen_disable_anim) {
+		/* This means our output is not to the screen, so we can't be doing any animation stuff, so use our parent DrawGlyphRun() */
+		Blitter_32bppSSE4::DrawGlyphRun(glyphs, mode);
+		return;
+	}
+
+	for (Blitter::BlitterParams &bp : glyphs) {
+		const BlitterSpriteFlags sprite_flags = ((const Blitter_32bppSSE_Base::SpriteData *) bp.sprite)->flags;
+		if (mode != BlitterMode::ColourRemap || (sprite_flags & BSF_NO_REMAP)) {
+			/* Other modes, and glyphs with their own colours, e.g. emoji. */
+			this->Draw(&bp, mode, ZOOM_LVL_MIN);
+		} else if (bp.skip_left != 0 || bp.width <= MARGIN_REMAP_THRESHOLD) {
+			if (sprite_flags & BSF_NO_ANIM) Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, BT_NONE, true, false>(&bp, ZOOM_LVL_MIN);
+			else                            Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, BT_NONE, true, true>(&bp, ZOOM_LVL_MIN);
+		} else {
+			if (sprite_flags & BSF_NO_ANIM) Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, BT_NONE, true, false>(&bp, ZOOM_LVL_MIN);
+			else                            Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, BT_NONE, true, true>(&bp, ZOOM_LVL_MIN);
+		}
+	}
+}
+
 #endif /* WITH_SSE */
@@ -0,0 +1,259 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_avx2.cpp Implementation of the AVX2 32 bpp blitter. */
+
+#if defined(WITH_SSE) && defined(WITH_AVX2)
+
+#include "../stdafx.h"
+#include "../zoom_func.h"
+#include "../settings_type.h"
+
+/* Only the helper functions of the SSE blitters are needed here, not another copy of the drawing of the SSE4 blitter. */
+#define FULL_ANIMATION 1
+
+#include "32bpp_avx2.hpp"
+#include "32bpp_sse_func.hpp"
+#include "32bpp_avx2_func.hpp"
+
+#include "../safeguards.h"
+
+/** Instantiation of the AVX2 32bpp blitter factory. */
+static FBlitter_32bppAVX2 iFBlitter_32bppAVX2;
+
+/**
+ * Draws a sprite to a (screen) buffer. It is templated to allow faster operation.
+ * Eight pixels are drawn at a time, the remaining pixels of a line are drawn like the SSE4 blitter does.
+ *
+ * @tparam mode blitter mode
+ * @param bp further blitting parameters
+ * @param zoom zoom level at which we are drawing
+ */
+IGNORE_UNINITIALIZED_WARNING_START
+template <BlitterMode mode, Blitter_32bppSSE_Base::ReadMode read_mode, bool translucent>
+GNU_TARGET("avx2")
+inline void Blitter_32bppAVX2::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
+{
+	const uint8_t * const remap = bp->remap;
+	Colour *dst_line = (Colour *) bp->dst + bp->top * bp->pitch + bp->left;
+	int effective_width = bp->width;
+
+	/* Find where to start reading in the source sprite. */
+	const SpriteData * const sd = (const SpriteData *) bp->sprite;
+	const SpriteInfo * const si = &sd->infos[zoom];
+	const MapValue *src_mv_line = (const MapValue *) &sd->data[si->mv_offset] + bp->skip_top * si->sprite_width;
+	const Colour *src_rgba_line = (const Colour *) ((const uint8_t *) &sd->data[si->sprite_offset] + bp->skip_top * si->sprite_line_size);
+
+	if (read_mode != RM_WITH_MARGIN) {
+		src_rgba_line += bp->skip_left;
+		src_mv_line += bp->skip_left;
+	}
+
+	auto lookup = [](uint index) { return Blitter_32bppBase::LookupColourInPalette(index); };
+
+	/* Load these variables into register before loop. */
+	const __m128i a_cm         = ALPHA_CONTROL_MASK;
+	const __m128i pack_low_cm  = PACK_LOW_CONTROL_MASK;
+	const __m128i tr_nom_base  = TRANSPARENT_NOM_BASE;
+	const __m128i a_am         = ALPHA_AND_MASK;
+	const __m256i a_cm8        = _mm256_broadcastsi128_si256(a_cm);
+	const __m256i tr_nom_base8 = _mm256_broadcastsi128_si256(tr_nom_base);
+	const __m256i a_am8        = _mm256_broadcastsi128_si256(a_am);
+
+	for (int y = bp->height; y != 0; y--) {
+		Colour *dst = dst_line;
+		const Colour *src = src_rgba_line + META_LENGTH;
+		const MapValue *src_mv = src_mv_line;
+
+		if (read_mode == RM_WITH_MARGIN) {
+			src += src_rgba_line[0].data;
+			dst += src_rgba_line[0].data;
+			if (mode == BlitterMode::ColourRemap) src_mv += src_rgba_line[0].data;
+			const int width_diff = si->sprite_width - bp->width;
+			effective_width = bp->width - (int) src_rgba_line[0].data;
+			const int delta_diff = (int) src_rgba_line[1].data - width_diff;
+			const int new_width = effective_width - delta_diff;
+			effective_width = delta_diff > 0 ? new_width : effective_width;
+			if (effective_width <= 0) goto next_line;
+		}
+
+		{
+			uint x = (uint) effective_width;
+			switch (mode) {
+				default:
+					for (; x >= 8; x -= 8) {
+						const __m256i srcs = _mm256_loadu_si256((const __m256i *) src);
+						const __m256i dsts = _mm256_loadu_si256((const __m256i *) dst);
+						_mm256_storeu_si256((__m256i *) dst, translucent ? AlphaBlendEightPixels(srcs, dsts, a_cm8, a_am8) : SelectOpaqueEightPixels(srcs, dsts));
+						src += 8;
+						dst += 8;
+					}
+
+					if (!translucent) {
+						for (; x > 0; x--) {
+							if (src->a) *dst = *src;
+							src++;
+							dst++;
+						}
+						break;
+					}
+
+					for (; x >= 2; x -= 2) {
+						__m128i srcABCD = _mm_loadl_epi64((const __m128i *) src);
+						__m128i dstABCD = _mm_loadl_epi64((__m128i *) dst);
+						_mm_storel_epi64((__m128i *) dst, AlphaBlendTwoPixels(srcABCD, dstABCD, a_cm, pack_low_cm, a_am));
+						src += 2;
+						dst += 2;
+					}
+
+					if (x != 0) {
+						__m128i srcABCD = _mm_cvtsi32_si128(src->data);
+						__m128i dstABCD = _mm_cvtsi32_si128(dst->data);
+						dst->data = _mm_cvtsi128_si32(AlphaBlendTwoPixels(srcABCD, dstABCD, a_cm, pack_low_cm, a_am));
+					}
+					break;
+
+				case BlitterMode::ColourRemap:
+					for (; x >= 8; x -= 8) {
+						const __m256i srcs = RemapEightPixels(_mm256_loadu_si256((const __m256i *) src), src_mv, remap, lookup);
+						const __m256i dsts = _mm256_loadu_si256((const __m256i *) dst);
+						_mm256_storeu_si256((__m256i *) dst, AlphaBlendEightPixels(srcs, dsts, a_cm8, a_am8));
+						src += 8;
+						dst += 8;
+						src_mv += 8;
+					}
+
+					for (; x >= 2; x -= 2) {
+						__m128i srcABCD = RemapTwoPixels(_mm_loadl_epi64((const __m128i *) src), *((const uint32_t *) src_mv), remap, lookup);
+						__m128i dstABCD = _mm_loadl_epi64((__m128i *) dst);
+						_mm_storel_epi64((__m128i *) dst, AlphaBlendTwoPixels(srcABCD, dstABCD, a_cm, pack_low_cm, a_am));
+						src += 2;
+						dst += 2;
+						src_mv += 2;
+					}
+
+					if (x != 0) {
+						/* In case the m-channel is zero, do not remap this pixel in any way. */
+						if (src_mv->m) {
+							const uint r = remap[src_mv->m];
+							if (r != 0) {
+								Colour remapped_colour = AdjustBrightneSSE(this->LookupColourInPalette(r), src_mv->v);
+								if (src->a == 255) {
+									*dst = remapped_colour;
+								} else {
+									remapped_colour.a = src->a;
+									dst->data = _mm_cvtsi128_si32(AlphaBlendTwoPixels(_mm_cvtsi32_si128(remapped_colour.data), _mm_cvtsi32_si128(dst->data), a_cm, pack_low_cm, a_am));
+								}
+							}
+						} else if (src->a == 255) {
+							*dst = *src;
+						} else {
+							dst->data = _mm_cvtsi128_si32(AlphaBlendTwoPixels(_mm_cvtsi32_si128(src->data), _mm_cvtsi32_si128(dst->data), a_cm, pack_low_cm, a_am));
+						}
+					}
+					break;
+
+				case BlitterMode::Transparent:
+					/* Make the current colour a bit more black, so it looks like this image is transparent. */
+					for (; x >= 8; x -= 8) {
+						const __m256i srcs = _mm256_loadu_si256((const __m256i *) src);
+						const __m256i dsts = _mm256_loadu_si256((const __m256i *) dst);
+						_mm256_storeu_si256((__m256i *) dst, DarkenEightPixels(srcs, dsts, a_cm8, tr_nom_base8));
+						src += 8;
+						dst += 8;
+					}
+
+					for (; x >= 2; x -= 2) {
+						__m128i srcABCD = _mm_loadl_epi64((const __m128i *) src);
+						__m128i dstABCD = _mm_loadl_epi64((__m128i *) dst);
+						_mm_storel_epi64((__m128i *) dst, DarkenTwoPixels(srcABCD, dstABCD, a_cm, tr_nom_base));
+						src += 2;
+						dst += 2;
+					}
+
+					if (x != 0) {
+						__m128i srcABCD = _mm_cvtsi32_si128(src->data);
+						__m128i dstABCD = _mm_cvtsi32_si128(dst->data);
+						dst->data = _mm_cvtsi128_si32(DarkenTwoPixels(srcABCD, dstABCD, a_cm, tr_nom_base));
+					}
+					break;
+			}
+		}
+
+next_line:
+		if (mode == BlitterMode::ColourRemap) src_mv_line += si->sprite_width;
+		src_rgba_line = (const Colour*) ((const uint8_t*) src_rgba_line + si->sprite_line_size);
+		dst_line += bp->pitch;
+	}
+}
+IGNORE_UNINITIALIZED_WARNING_STOP
+
+/**
+ * Draws a sprite to a (screen) buffer. Calls adequate templated function.
+ *
+ * @param bp further blitting parameters
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_32bppAVX2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+{
+	const BlitterSpriteFlags sprite_flags = ((const Blitter_32bppSSE_Base::SpriteData *) bp->sprite)->flags;
+	switch (mode) {
+		case BlitterMode::Normal:
+bm_normal:
+			if (bp->skip_left != 0 || bp->width <= MARGIN_NORMAL_THRESHOLD) {
+				Draw<BlitterMode::Normal, RM_WITH_SKIP, true>(bp, zoom);
+			} else if (sprite_flags & BSF_TRANSLUCENT) {
+				Draw<BlitterMode::Normal, RM_WITH_MARGIN, true>(bp, zoom);
+			} else {
+				Draw<BlitterMode::Normal, RM_WITH_MARGIN, false>(bp, zoom);
+			}
+			return;
+
+		case BlitterMode::ColourRemap:
+			if (sprite_flags & BSF_NO_REMAP) goto bm_normal;
+			if (bp->skip_left != 0 || bp->width <= MARGIN_REMAP_THRESHOLD) {
+				Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, true>(bp, zoom);
+			} else {
+				Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, true>(bp, zoom);
+			}
+			return;
+
+		case BlitterMode::Transparent: Draw<BlitterMode::Transparent, RM_NONE, true>(bp, zoom); return;
+
+		default:
+			this->Blitter_32bppSSE4::Draw(bp, mode, zoom);
+			return;
+	}
+}
+
+/**
+ * Draws a run of glyphs, the blitter mode is only dispatched once for the whole run.
+ *
+ * @param glyphs blitting parameters of each glyph
+ * @param mode blitter mode
+ */
+void Blitter_32bppAVX2::DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+{
+	if (mode != BlitterMode::ColourRemap) {
+		this->Blitter::DrawGlyphRun(glyphs, mode);
+		return;
+	}
+
+	for (Blitter::BlitterParams &bp : glyphs) {
+		if (((const Blitter_32bppSSE_Base::SpriteData *) bp.sprite)->flags & BSF_NO_REMAP) {
+			/* Glyphs with their own colours, e.g. emoji. */
+			this->Draw(&bp, mode, ZOOM_LVL_MIN);
+		} else if (bp.skip_left != 0 || bp.width <= MARGIN_REMAP_THRESHOLD) {
+			Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, true>(&bp, ZOOM_LVL_MIN);
+		} else {
+			Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, true>(&bp, ZOOM_LVL_MIN);
+		}
+	}
+}
+
+#endif /* WITH_SSE && WITH_AVX2 */
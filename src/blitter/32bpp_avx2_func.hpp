@@ -0,0 +1,159 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_avx2_func.hpp Functions related to AVX2 32 bpp blitter. */
+
+#ifndef BLITTER_32BPP_AVX2_FUNC_HPP
+#define BLITTER_32BPP_AVX2_FUNC_HPP
+
+/* ATTENTION
+ * This file is compiled by both the AVX2 blitters, after the SSE functions.
+ * Be careful when declaring things with external linkage.
+ * Use internal linkage instead, i.e. "static".
+ */
+
+#if defined(WITH_SSE) && defined(WITH_AVX2)
+
+#include <immintrin.h>
+
+#define MAP_VALUE_M_MASK _mm_setr_epi8(-1, 0, -1, 0, -1, 0, -1, 0, -1, 0, -1, 0, -1, 0, -1, 0)
+
+/**
+ * Alpha blend 8 pixels, the same as #AlphaBlendTwoPixels for each pair of pixels.
+ * Each 128 bit lane holds 4 pixels, the unpacking and packing is per lane so the pixel order is kept.
+ */
+GNU_TARGET("avx2")
+INTERNAL_LINKAGE inline __m256i AlphaBlendEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &alpha_mask)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i low_bytes = _mm256_set1_epi16(0xFF);
+	__m256i blended[2];
+	for (int i = 0; i < 2; i++) {
+		__m256i srcX = (i == 0) ? _mm256_unpacklo_epi8(src, zero) : _mm256_unpackhi_epi8(src, zero);
+		__m256i dstX = (i == 0) ? _mm256_unpacklo_epi8(dst, zero) : _mm256_unpackhi_epi8(dst, zero);
+
+		__m256i alpha_maskX = _mm256_cmpgt_epi16(srcX, zero);  // (alpha > 0) ? 0xFFFF : 0
+		__m256i alphaX = _mm256_sub_epi16(srcX, alpha_maskX);  // if (alpha > 0) a++;
+		alphaX = _mm256_shuffle_epi8(alphaX, distribution_mask);
+
+		srcX = _mm256_sub_epi16(srcX, dstX);    //   (r - Cr)
+		srcX = _mm256_mullo_epi16(srcX, alphaX); // a*(r - Cr)
+		srcX = _mm256_srli_epi16(srcX, 8);       // a*(r - Cr)/256
+		srcX = _mm256_add_epi16(srcX, dstX);     // a*(r - Cr)/256 + Cr
+
+		alpha_maskX = _mm256_and_si256(alpha_maskX, alpha_mask); // set non alpha fields to 0
+		srcX = _mm256_or_si256(srcX, alpha_maskX);                // set alpha fields to 0xFFFF if src alpha was > 0
+		blended[i] = _mm256_and_si256(srcX, low_bytes);           // keep the low bytes, so packing does not saturate
+	}
+	return _mm256_packus_epi16(blended[0], blended[1]);
+}
+
+/**
+ * Darken 8 pixels, the same as #DarkenTwoPixels for each pair of pixels.
+ */
+GNU_TARGET("avx2")
+INTERNAL_LINKAGE inline __m256i DarkenEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &tr_nom_base)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i darkened[2];
+	for (int i = 0; i < 2; i++) {
+		__m256i srcX = (i == 0) ? _mm256_unpacklo_epi8(src, zero) : _mm256_unpackhi_epi8(src, zero);
+		__m256i dstX = (i == 0) ? _mm256_unpacklo_epi8(dst, zero) : _mm256_unpackhi_epi8(dst, zero);
+		__m256i alphaX = _mm256_shuffle_epi8(srcX, distribution_mask);
+		alphaX = _mm256_srli_epi16(alphaX, 2); // Reduce to 64 levels of shades so the max value fits in 16 bits.
+		__m256i nom = _mm256_sub_epi16(tr_nom_base, alphaX);
+		dstX = _mm256_mullo_epi16(dstX, nom);
+		darkened[i] = _mm256_srli_epi16(dstX, 8);
+	}
+	return _mm256_packus_epi16(darkened[0], darkened[1]);
+}
+
+/**
+ * Take the source of the 8 pixels which are not fully transparent, and the destination otherwise.
+ * This is what alpha blending does for sprites without translucent pixels.
+ */
+GNU_TARGET("avx2")
+INTERNAL_LINKAGE inline __m256i SelectOpaqueEightPixels(__m256i src, __m256i dst)
+{
+	const __m256i transparent = _mm256_cmpeq_epi32(_mm256_srli_epi32(src, 24), _mm256_setzero_si256());
+	return _mm256_blendv_epi8(src, dst, transparent);
+}
+
+/**
+ * Clear the animation buffer of the 8 pixels which are not fully transparent.
+ * @param anim The animation buffer of the pixels.
+ * @param src The source pixels.
+ */
+GNU_TARGET("avx2")
+INTERNAL_LINKAGE inline void ClearAnimOfEightPixels(uint16_t *anim, __m256i src)
+{
+	const __m256i transparent = _mm256_cmpeq_epi32(_mm256_srli_epi32(src, 24), _mm256_setzero_si256());
+	const __m128i keep = _mm_packs_epi32(_mm256_castsi256_si128(transparent), _mm256_extracti128_si256(transparent, 1));
+	_mm_storeu_si128((__m128i *) anim, _mm_and_si128(_mm_loadu_si128((const __m128i *) anim), keep));
+}
+
+/**
+ * Remap the colours of 2 pixels, the same as the colour remap of the SSE blitters without animation.
+ * @param srcAB The pixels, in the low half.
+ * @param mvX2 The map values of both pixels.
+ * @param remap The remap table.
+ * @param lookup Function to look up a colour in the palette.
+ * @return The remapped pixels, in the low half.
+ */
+template <typename TLookup>
+GNU_TARGET("avx2")
+INTERNAL_LINKAGE inline __m128i RemapTwoPixels(__m128i srcAB, uint32_t mvX2, const uint8_t *remap, TLookup lookup)
+{
+	if (!(mvX2 & 0x00FF00FF)) return srcAB;
+
+	uint32_t colours[2] = { (uint32_t) _mm_cvtsi128_si32(srcAB), (uint32_t) _mm_extract_epi32(srcAB, 1) };
+	for (int i = 0; i < 2; i++) {
+		/* Written so the compiler uses CMOV. */
+		const Colour srcm = (Colour) colours[i];
+		const uint m = (uint8_t) (mvX2 >> (16 * i));
+		const uint r = remap[m];
+		const Colour cmap = (lookup(r).data & 0x00FFFFFF) | (srcm.data & 0xFF000000);
+		Colour colour = 0;
+		colour = r == 0 ? colour : cmap;
+		colour = m != 0 ? colour : srcm;
+		colours[i] = colour.data;
+	}
+	srcAB = _mm_setr_epi32(colours[0], colours[1], 0, 0);
+
+	if ((mvX2 & 0xFF00FF00) != 0x80008000) srcAB = AdjustBrightnessOfTwoPixels(srcAB, mvX2);
+	return srcAB;
+}
+
+/**
+ * Remap the colours of 8 pixels, as 4 pairs of #RemapTwoPixels.
+ * The palette lookups cannot be vectorised, but the common case of pixels without remap is only a single test.
+ * @param src The pixels.
+ * @param src_mv The map values of the pixels.
+ * @param remap The remap table.
+ * @param lookup Function to look up a colour in the palette.
+ * @return The remapped pixels.
+ */
+template <typename TLookup>
+GNU_TARGET("avx2")
+INTERNAL_LINKAGE inline __m256i RemapEightPixels(__m256i src, const Blitter_32bppSSE_Base::MapValue *src_mv, const uint8_t *remap, TLookup lookup)
+{
+	const __m128i mvs = _mm_loadu_si128((const __m128i *) src_mv);
+	if (_mm_testz_si128(mvs, MAP_VALUE_M_MASK)) return src;
+
+	__m128i lo = _mm256_castsi256_si128(src);
+	__m128i hi = _mm256_extracti128_si256(src, 1);
+	const __m128i lo_remapped = _mm_unpacklo_epi64(
+			RemapTwoPixels(lo, _mm_cvtsi128_si32(mvs), remap, lookup),
+			RemapTwoPixels(_mm_unpackhi_epi64(lo, lo), _mm_extract_epi32(mvs, 1), remap, lookup));
+	const __m128i hi_remapped = _mm_unpacklo_epi64(
+			RemapTwoPixels(hi, _mm_extract_epi32(mvs, 2), remap, lookup),
+			RemapTwoPixels(_mm_unpackhi_epi64(hi, hi), _mm_extract_epi32(mvs, 3), remap, lookup));
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(lo_remapped), hi_remapped, 1);
+}
+
+#endif /* WITH_SSE && WITH_AVX2 */
+#endif /* BLITTER_32BPP_AVX2_FUNC_HPP */
@@ -295,6 +295,23 @@ void Blitter_32bppOptimized::Draw(Blitter::BlitterParams *bp, BlitterMode mode,
 	this->Draw<false>(bp, mode, zoom);
 }
 
+/**
+ * Draws a run of glyphs, the blitter mode is only dispatched once for the whole run.
+ *
+ * @param glyphs blitting parameters of each glyph
+ * @param mode blitter mode
+ */
+void Blitter_32bppOptimized::DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+{
+	if (mode != BlitterMode::ColourRemap) {
+		this->Blitter::DrawGlyphRun(glyphs, mode);
+		return;
+	}
+	for (const Blitter::BlitterParams &bp : glyphs) {
+		this->Draw<BlitterMode::ColourRemap>(&bp, ZOOM_LVL_MIN);
+	}
+}
+
 template <bool Tpal_to_rgb> Sprite *Blitter_32bppOptimized::EncodeInternal(const SpriteLoader::SpriteCollection &sprite, SpriteAllocator &allocator)
 {
 	/* streams of pixels (a, r, g, b channels)
@@ -28,6 +28,7 @@ public:
 	}
 
 	void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) override;
+	void DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode) override;
 	Sprite *Encode(const SpriteLoader::SpriteCollection &sprite, SpriteAllocator &allocator) override;
 
 	const char *GetName() override { return "32bpp-optimized"; }
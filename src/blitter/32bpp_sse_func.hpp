@@ -575,6 +575,37 @@ bm_normal:
 			return;
 	}
 }
+
+/**
+ * Draws a run of glyphs, the blitter mode is only dispatched once for the whole run.
+ *
+ * @param glyphs blitting parameters of each glyph
+ * @param mode blitter mode
+ */
+#if (SSE_VERSION == 2)
+void Blitter_32bppSSE2::DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+#elif (SSE_VERSION == 3)
+void Blitter_32bppSSSE3::DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+#elif (SSE_VERSION == 4)
+void Blitter_32bppSSE4::DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+#endif
+{
+	if (mode != BlitterMode::ColourRemap) {
+		this->Blitter::DrawGlyphRun(glyphs, mode);
+		return;
+	}
+
+	for (Blitter::BlitterParams &bp : glyphs) {
+		if (((const Blitter_32bppSSE_Base::SpriteData *) bp.sprite)->flags & BSF_NO_REMAP) {
+			/* Glyphs with their own colours, e.g. emoji. */
+			this->Draw(&bp, mode, ZOOM_LVL_MIN);
+		} else if (bp.skip_left != 0 || bp.width <= MARGIN_REMAP_THRESHOLD) {
+			Draw<BlitterMode::ColourRemap, RM_WITH_SKIP, BT_NONE, true>(&bp, ZOOM_LVL_MIN);
+		} else {
+			Draw<BlitterMode::ColourRemap, RM_WITH_MARGIN, BT_NONE, true>(&bp, ZOOM_LVL_MIN);
+		}
+	}
+}
 #endif /* FULL_ANIMATION */
 
 #endif /* WITH_SSE */
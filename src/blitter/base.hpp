@@ -14,6 +14,7 @@
 #include "../spriteloader/spriteloader.hpp"
 #include "../core/math_func.hpp"
 
+#include <span>
 #include <utility>
 
 /** The modes of blitting we can do. */
@@ -95,6 +96,19 @@ public:
 	 */
 	virtual void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) = 0;
 
+	/**
+	 * Draw a run of glyphs of a line of text to the screen.
+	 *  The glyphs are font sprites at the normal zoom level, which are already clipped and are drawn in order with the same remap.
+	 * @param glyphs The blitting parameters of each glyph.
+	 * @param mode The blitter mode used for all glyphs.
+	 */
+	virtual void DrawGlyphRun(std::span<Blitter::BlitterParams> glyphs, BlitterMode mode)
+	{
+		for (Blitter::BlitterParams &bp : glyphs) {
+			this->Draw(&bp, mode, ZOOM_LVL_MIN);
+		}
+	}
+
 	/**
 	 * Draw a colourtable to the screen. This is: the colour of the screen is read
 	 *  and is looked-up in the palette to match a new colour, which then is put
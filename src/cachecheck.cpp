@@ -33,6 +33,11 @@
 #include "train.h"
 #include "tunnelbridge.h"
 #include "vehicle_base.h"
+#include "worker_thread.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #include "safeguards.h"
 
@@ -40,6 +45,135 @@ extern void AfterLoadCompanyStats();
 extern void RebuildTownCaches(bool cargo_update_required);
 extern void WriteVehicleInfo(format_target &buffer, const Vehicle *u, const Vehicle *v, uint length);
 
+/** Name of each family of caches, indexed by the bit of its flag. */
+static const std::array<std::string_view, CHECK_CACHE_FAMILY_COUNT> _check_caches_family_names = {
+	"towns", "infrastructure", "water_regions", "road_regions", "vehicles", "cargo", "stations", "orders",
+};
+
+/** Duration of the last check of each family of caches, in microseconds, or -1 if it has not been checked yet. */
+static std::array<int64_t, CHECK_CACHE_FAMILY_COUNT> _check_caches_costs = { -1, -1, -1, -1, -1, -1, -1, -1 };
+
+/** Families of caches which are checked by the periodic checks. */
+static CheckCachesFlags _check_caches_periodic_families = CHECK_CACHE_ALL;
+
+/** Records the duration of the check of a family of caches. */
+struct CheckCachesFamilyTimer {
+	uint8_t family;
+	std::chrono::steady_clock::time_point start;
+
+	CheckCachesFamilyTimer(CheckCachesFlags family) : family(FindFirstBit(family)), start(std::chrono::steady_clock::now()) {}
+
+	~CheckCachesFamilyTimer()
+	{
+		_check_caches_costs[this->family] = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->start).count();
+	}
+};
+
+/**
+ * Get the flag of a family of caches by its name.
+ * @param name The name of the family, or "all".
+ * @return The flag of the family, or CHECK_CACHE_NONE if there is no family with that name.
+ */
+CheckCachesFlags ParseCheckCachesFamily(std::string_view name)
+{
+	if (name == "all") return CHECK_CACHE_ALL;
+	for (uint i = 0; i < CHECK_CACHE_FAMILY_COUNT; i++) {
+		if (_check_caches_family_names[i] == name) return static_cast<CheckCachesFlags>(1 << i);
+	}
+	return CHECK_CACHE_NONE;
+}
+
+/**
+ * Write the duration of the last check of each family of caches, and whether it is included in the periodic checks.
+ * @param buffer The buffer to write to.
+ */
+void DumpCheckCachesCosts(format_target &buffer)
+{
+	for (uint i = 0; i < CHECK_CACHE_FAMILY_COUNT; i++) {
+		buffer.format("{:<15} ", _check_caches_family_names[i]);
+		if (_check_caches_costs[i] < 0) {
+			buffer.append("not checked yet");
+		} else {
+			buffer.format("{} us", _check_caches_costs[i]);
+		}
+		buffer.append(HasBit(_check_caches_periodic_families, i) ? ", periodic\n" : "\n");
+	}
+}
+
+/**
+ * Set the families of caches which are checked by the periodic checks of the desync debug level.
+ * Forced checks always check the families they ask for.
+ * @param families The families to check.
+ */
+void SetCheckCachesPeriodicFamilies(CheckCachesFlags families)
+{
+	_check_caches_periodic_families = families;
+}
+
+/** Mismatch of the cache of a single pool item, found by a check which runs on the worker threads. */
+struct CheckCachesFinding {
+	uint32_t index;  ///< Pool index of the item.
+	uint32_t detail; ///< Details of the mismatch, specific to the check.
+};
+
+using CheckCachesSliceFunc = std::function<void(size_t begin, size_t end, std::vector<CheckCachesFinding> &findings)>;
+
+/** Number of pool items which are checked by a single job. */
+static const size_t CHECK_CACHES_SLICE_SIZE = 2048;
+
+/** Shared state of a check which is split in slices of a pool. */
+struct CheckCachesSlices {
+	CheckCachesSliceFunc check;                            ///< Check of a single slice.
+	size_t pool_size;                                      ///< Number of pool indices to check.
+	std::vector<std::vector<CheckCachesFinding>> findings; ///< Findings of each slice.
+	uint remaining;                                        ///< Number of slices which are not finished, protected by #lock.
+	std::mutex lock;
+	std::condition_variable done_cv;
+};
+
+/* This is run in a worker thread */
+static void CheckCachesSliceJob(CheckCachesSlices *slices, uint slice)
+{
+	size_t begin = slice * CHECK_CACHES_SLICE_SIZE;
+	slices->check(begin, std::min(begin + CHECK_CACHES_SLICE_SIZE, slices->pool_size), slices->findings[slice]);
+
+	std::lock_guard<std::mutex> lk(slices->lock);
+	if (--slices->remaining == 0) slices->done_cv.notify_all();
+}
+
+/**
+ * Run a check over slices of the indices of a pool on the worker threads, and wait for it to finish.
+ * The check of a slice may only modify the items of its own slice, and must not use global state
+ * such as string parameters: mismatches are returned, to be logged by the caller.
+ * @param pool_size Number of pool indices to check.
+ * @param check The check of a single slice.
+ * @return The findings of all slices, in pool index order.
+ */
+static std::vector<CheckCachesFinding> RunCheckCachesSlices(size_t pool_size, CheckCachesSliceFunc check)
+{
+	CheckCachesSlices slices;
+	slices.check = std::move(check);
+	slices.pool_size = pool_size;
+	uint count = CeilDivT<size_t>(pool_size, CHECK_CACHES_SLICE_SIZE);
+	if (count == 0) return {};
+	slices.findings.resize(count);
+	slices.remaining = count;
+
+	for (uint i = 1; i < count; i++) {
+		_general_worker_pool.EnqueueJob<CheckCachesSliceJob>(&slices, i);
+	}
+	CheckCachesSliceJob(&slices, 0);
+
+	std::unique_lock<std::mutex> lk(slices.lock);
+	slices.done_cv.wait(lk, [&]() { return slices.remaining == 0; });
+
+	std::vector<CheckCachesFinding> findings;
+	for (std::vector<CheckCachesFinding> &slice_findings : slices.findings) {
+		findings.insert(findings.end(), slice_findings.begin(), slice_findings.end());
+	}
+	return findings;
+}
+
 static bool SignalInfraTotalMatches()
 {
 	std::array<int, MAX_COMPANIES> old_signal_totals = {};
@@ -101,6 +235,20 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 		if (desync_level < 1) return;
 
 		if (desync_level == 1 && _state_ticks.base() % 500 != 0) return;
+
+		flags &= _check_caches_periodic_families | CHECK_CACHE_EMIT_LOG;
+
+		if (_state_ticks.base() % 500 == 0) {
+			/* Record the hashes of the parts of the game state, so that comparing the desync logs
+			 * of a client and the server shows which part of the state diverged first. */
+			const StateHashTree tree = BuildStateHashTree();
+			format_buffer hash_buffer;
+			hash_buffer.format("State hash: {:016X}", tree.root);
+			for (const StateHashSection &section : tree.sections) {
+				hash_buffer.format(", {}: {:016X}", section.name, section.hash);
+			}
+			LogDesyncMsg(hash_buffer.to_string());
+		}
 	}
 
 	SCOPE_INFO_FMT([flags], "CheckCaches: {:X}", flags);
@@ -159,7 +307,9 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 	cclog_output(cc_buffer); \
 }
 
-	if (flags & CHECK_CACHE_GENERAL) {
+	if (flags & CHECK_CACHE_TOWNS) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_TOWNS);
+
 		/* Check the town caches. */
 		std::vector<TownCache> old_town_caches;
 		std::vector<StationList> old_town_stations_nears;
@@ -248,6 +398,8 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 	}
 
 	if (flags & CHECK_CACHE_INFRA_TOTALS) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_INFRA_TOTALS);
+
 		/* Check company infrastructure cache. */
 		std::vector<CompanyInfrastructure> old_infrastructure;
 		for (const Company *c : Company::Iterate()) old_infrastructure.push_back(c->infrastructure);
@@ -278,7 +430,9 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 		}
 	}
 
-	if (flags & CHECK_CACHE_GENERAL) {
+	if (flags & CHECK_CACHE_STATIONS) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_STATIONS);
+
 		/* Strict checking of the road stop cache entries */
 		for (const RoadStop *rs : RoadStop::Iterate()) {
 			if (IsBayRoadStopTile(rs->xy)) continue;
@@ -288,6 +442,30 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 			rs->GetEntry(DIAGDIR_NW)->CheckIntegrity(rs);
 		}
 
+		/* Check docking tiles */
+		for (Station *st : Station::Iterate()) {
+			TileArea ta;
+			btree::btree_set<TileIndex> docking_tiles;
+			for (TileIndex tile : st->docking_station) {
+				ta.Add(tile);
+				if (IsDockingTile(tile)) docking_tiles.insert(tile);
+			}
+			UpdateStationDockingTiles(st);
+			if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
+				cclog("station docking mismatch: station {}, company {}, prev: ({:X}, {}, {}), recalc: ({:X}, {}, {})",
+						st->index, (int)st->owner, ta.tile, ta.w, ta.h, st->docking_station.tile, st->docking_station.w, st->docking_station.h);
+			}
+			for (TileIndex tile : ta) {
+				if ((docking_tiles.find(tile) != docking_tiles.end()) != IsDockingTile(tile)) {
+					cclog("docking tile mismatch: tile {}", tile);
+				}
+			}
+		}
+	}
+
+	if (flags & CHECK_CACHE_VEHICLES) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_VEHICLES);
+
 		struct SavedVehicleInfo {
 			NewGRFCache grf_cache;
 			VehicleCache vcache;
@@ -484,71 +662,6 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 			air_cache.clear();
 		}
 
-		/* Check whether the caches are still valid */
-		for (Vehicle *v : Vehicle::Iterate()) {
-			Money old_feeder_share = v->cargo.GetFeederShare();
-			uint old_count = v->cargo.TotalCount();
-			uint64_t old_cargo_periods_in_transit = v->cargo.CargoPeriodsInTransit();
-
-			v->cargo.InvalidateCache();
-
-			uint changed = 0;
-			if (v->cargo.GetFeederShare() != old_feeder_share) SetBit(changed, 0);
-			if (v->cargo.TotalCount() != old_count) SetBit(changed, 1);
-			if (v->cargo.CargoPeriodsInTransit() != old_cargo_periods_in_transit) SetBit(changed, 2);
-			if (changed != 0) {
-				CCLOGV1("vehicle cargo cache mismatch: {}{}{}",
-						HasBit(changed, 0) ? 'f' : '-',
-						HasBit(changed, 1) ? 't' : '-',
-						HasBit(changed, 2) ? 'p' : '-');
-			}
-		}
-
-		for (Station *st : Station::Iterate()) {
-			for (CargoType c = 0; c < NUM_CARGO; c++) {
-				if (st->goods[c].data == nullptr) continue;
-
-				uint old_count = st->goods[c].data->cargo.TotalCount();
-				uint64_t old_cargo_periods_in_transit = st->goods[c].data->cargo.CargoPeriodsInTransit();
-
-				st->goods[c].data->cargo.InvalidateCache();
-
-				uint changed = 0;
-				if (st->goods[c].data->cargo.TotalCount() != old_count) SetBit(changed, 0);
-				if (st->goods[c].data->cargo.CargoPeriodsInTransit() != old_cargo_periods_in_transit) SetBit(changed, 1);
-				if (changed != 0) {
-					cclog("station cargo cache mismatch: station {}, company {}, cargo {}: {}{}",
-							st->index, (int)st->owner, c,
-							HasBit(changed, 0) ? 't' : '-',
-							HasBit(changed, 1) ? 'd' : '-');
-				}
-			}
-
-			/* Check docking tiles */
-			TileArea ta;
-			btree::btree_set<TileIndex> docking_tiles;
-			for (TileIndex tile : st->docking_station) {
-				ta.Add(tile);
-				if (IsDockingTile(tile)) docking_tiles.insert(tile);
-			}
-			UpdateStationDockingTiles(st);
-			if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
-				cclog("station docking mismatch: station {}, company {}, prev: ({:X}, {}, {}), recalc: ({:X}, {}, {})",
-						st->index, (int)st->owner, ta.tile, ta.w, ta.h, st->docking_station.tile, st->docking_station.w, st->docking_station.h);
-			}
-			for (TileIndex tile : ta) {
-				if ((docking_tiles.find(tile) != docking_tiles.end()) != IsDockingTile(tile)) {
-					cclog("docking tile mismatch: tile {}", tile);
-				}
-			}
-		}
-
-#ifdef WITH_ASSERT
-		for (OrderList *order_list : OrderList::Iterate()) {
-			order_list->DebugCheckSanity();
-		}
-#endif
-
 		extern void ValidateVehicleTickCaches();
 		ValidateVehicleTickCaches();
 
@@ -568,13 +681,80 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 				cclog("Template replacement cache validation failed: {}", template_validation_result);
 			}
 		}
+	}
+
+	if (flags & CHECK_CACHE_CARGO) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_CARGO);
+
+		/* Check whether the cargo list caches are still valid, each list is only touched by the slice of its vehicle or station. */
+		std::vector<CheckCachesFinding> vehicle_findings = RunCheckCachesSlices(Vehicle::GetPoolSize(), [](size_t begin, size_t end, std::vector<CheckCachesFinding> &findings) {
+			for (Vehicle *v : Vehicle::Iterate(begin)) {
+				if (v->index >= end) break;
+
+				Money old_feeder_share = v->cargo.GetFeederShare();
+				uint old_count = v->cargo.TotalCount();
+				uint64_t old_cargo_periods_in_transit = v->cargo.CargoPeriodsInTransit();
+
+				v->cargo.InvalidateCache();
+
+				uint changed = 0;
+				if (v->cargo.GetFeederShare() != old_feeder_share) SetBit(changed, 0);
+				if (v->cargo.TotalCount() != old_count) SetBit(changed, 1);
+				if (v->cargo.CargoPeriodsInTransit() != old_cargo_periods_in_transit) SetBit(changed, 2);
+				if (changed != 0) findings.push_back({ v->index, changed });
+			}
+		});
+		for (const CheckCachesFinding &finding : vehicle_findings) {
+			const Vehicle *v = Vehicle::Get(finding.index);
+			CCLOGV1("vehicle cargo cache mismatch: {}{}{}",
+					HasBit(finding.detail, 0) ? 'f' : '-',
+					HasBit(finding.detail, 1) ? 't' : '-',
+					HasBit(finding.detail, 2) ? 'p' : '-');
+		}
+
+		std::vector<CheckCachesFinding> station_findings = RunCheckCachesSlices(Station::GetPoolSize(), [](size_t begin, size_t end, std::vector<CheckCachesFinding> &findings) {
+			for (Station *st : Station::Iterate(begin)) {
+				if (st->index >= end) break;
+
+				for (CargoType c = 0; c < NUM_CARGO; c++) {
+					if (st->goods[c].data == nullptr) continue;
+
+					uint old_count = st->goods[c].data->cargo.TotalCount();
+					uint64_t old_cargo_periods_in_transit = st->goods[c].data->cargo.CargoPeriodsInTransit();
+
+					st->goods[c].data->cargo.InvalidateCache();
+
+					uint changed = 0;
+					if (st->goods[c].data->cargo.TotalCount() != old_count) SetBit(changed, 0);
+					if (st->goods[c].data->cargo.CargoPeriodsInTransit() != old_cargo_periods_in_transit) SetBit(changed, 1);
+					if (changed != 0) findings.push_back({ st->index, static_cast<uint32_t>(c << 8) | changed });
+				}
+			}
+		});
+		for (const CheckCachesFinding &finding : station_findings) {
+			const Station *st = Station::Get(finding.index);
+			cclog("station cargo cache mismatch: station {}, company {}, cargo {}: {}{}",
+					st->index, (int)st->owner, GB(finding.detail, 8, 8),
+					HasBit(finding.detail, 0) ? 't' : '-',
+					HasBit(finding.detail, 1) ? 'd' : '-');
+		}
+
+		if (!CargoPacket::ValidateDeferredCargoPayments()) cclog("Cargo packets deferred payments validation failed");
+	}
+
+	if (flags & CHECK_CACHE_ORDERS) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_ORDERS);
+
+#ifdef WITH_ASSERT
+		for (OrderList *order_list : OrderList::Iterate()) {
+			order_list->DebugCheckSanity();
+		}
+#endif
 
 		if (!TraceRestrictSlot::ValidateVehicleIndex()) cclog("Trace restrict slot vehicle index validation failed");
 		TraceRestrictSlot::ValidateSlotOccupants(log);
 		TraceRestrictSlot::ValidateSlotGroupDescendants(log);
 
-		if (!CargoPacket::ValidateDeferredCargoPayments()) cclog("Cargo packets deferred payments validation failed");
-
 		if (_order_destination_refcount_map_valid) {
 			btree::btree_map<uint32_t, uint32_t> saved_order_destination_refcount_map = std::move(_order_destination_refcount_map);
 			for (auto iter = saved_order_destination_refcount_map.begin(); iter != saved_order_destination_refcount_map.end();) {
@@ -592,10 +772,17 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 	}
 
 	if (flags & CHECK_CACHE_WATER_REGIONS) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_WATER_REGIONS);
 		extern void WaterRegionCheckCaches(std::function<void(std::string_view)> log);
 		WaterRegionCheckCaches(cclog_output);
 	}
 
+	if (flags & CHECK_CACHE_ROAD_REGIONS) {
+		CheckCachesFamilyTimer timer(CHECK_CACHE_ROAD_REGIONS);
+		extern void RoadRegionCheckCaches(std::function<void(std::string_view)> log);
+		RoadRegionCheckCaches(cclog_output);
+	}
+
 	if ((flags & CHECK_CACHE_EMIT_LOG) && !saved_messages.empty()) {
 		InconsistencyExtraInfo info;
 		info.check_caches_result = std::move(saved_messages);
@@ -21,6 +21,7 @@
 #include "strings_func.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 
+#include <tuple>
 #include <vector>
 
 #include "safeguards.h"
@@ -1173,6 +1174,48 @@ uint StationCargoList::RerouteFromSource(uint max_move, StationCargoList *dest,
 	return this->ShiftCargoFromSource(StationCargoReroute(this, dest, max_move, avoid, avoid2, ge), source, avoid, false);
 }
 
+/**
+ * Merge compatible packets with the same next hop, to reduce the number of packets in the list.
+ * Append merges new packets where possible, but packets can still end up unmerged, e.g. when
+ * an earlier packet was full at the time but has since been partially loaded.
+ * As with Append, packets are only merged into earlier packets for the same next hop.
+ * @return Number of packets which were merged away.
+ */
+uint StationCargoList::Compact()
+{
+	using MergeKey = std::tuple<TileIndex, uint16_t, StationID, SourceType, SourceID>;
+	btree::btree_map<MergeKey, CargoPacket *> candidates;
+	uint merged = 0;
+
+	for (auto &it : static_cast<StationCargoPacketMap::Map &>(this->packets)) {
+		StationCargoPacketMap::List &list = it.second;
+		if (list.size() < 2) continue;
+
+		candidates.clear();
+		size_t kept = 0;
+		for (size_t i = 0; i < list.size(); i++) {
+			CargoPacket *cp = list[i];
+			MergeKey key{ cp->source_xy, cp->periods_in_transit, cp->first_station, cp->source_type, cp->source_id };
+			auto candidate = candidates.find(key);
+			if (candidate != candidates.end()) {
+				if (StationCargoList::TryMerge(candidate->second, cp)) {
+					merged++;
+					if (candidate->second->count == CargoPacket::MAX_COUNT) candidates.erase(candidate);
+					continue;
+				}
+				/* Keep whichever of the two packets has more room */
+				if (cp->count < candidate->second->count) candidate->second = cp;
+			} else if (cp->count < CargoPacket::MAX_COUNT) {
+				candidates.insert({ key, cp });
+			}
+			list[kept++] = cp;
+		}
+		while (list.size() > kept) list.pop_back();
+	}
+
+	return merged;
+}
+
 /*
  * We have to instantiate everything we want to be usable.
  */
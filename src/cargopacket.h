@@ -670,6 +670,8 @@ public:
 	uint Reroute(uint max_move, StationCargoList *dest, StationID avoid, StationID avoid2, const GoodsEntry *ge);
 	uint RerouteFromSource(uint max_move, StationCargoList *dest, StationID source, StationID avoid, StationID avoid2, const GoodsEntry *ge);
 
+	uint Compact();
+
 	void AfterLoadIncreaseReservationCount(uint count)
 	{
 		this->reserved_count += count;
@@ -15,6 +15,7 @@
 #include "strings_type.h"
 #include "tile_type.h"
 #include "core/serialisation.hpp"
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -851,9 +852,12 @@ std::unique_ptr<CommandPayloadBase> CommandPayloadSerialisable<T>::Clone() const
 }
 
 struct CommandPayloadSerialised final {
-	std::vector<uint8_t> serialised_data;
+	std::shared_ptr<const std::vector<uint8_t>> serialised_data; ///< Serialised payload, shared between all copies (e.g. per-client outgoing queues) of the same command
 
-	void Serialise(BufferSerialisationRef buffer) const { buffer.Send_binary(this->serialised_data.data(), this->serialised_data.size()); }
+	void Serialise(BufferSerialisationRef buffer) const
+	{
+		if (this->serialised_data != nullptr) buffer.Send_binary(this->serialised_data->data(), this->serialised_data->size());
+	}
 };
 
 void SetPreCheckedCommandPayloadClientID(Commands cmd, CommandPayloadBase &payload, ClientID client_id);
@@ -105,6 +105,7 @@ Company::~Company()
  */
 void Company::PostDestructor(size_t index)
 {
+	InvalidateFormattedStringCache();
 	InvalidateWindowData(WC_GRAPH_LEGEND, 0, (int)index);
 	InvalidateWindowData(WC_PERFORMANCE_DETAIL, 0, (int)index);
 	InvalidateWindowData(WC_COMPANY_LEAGUE, 0, 0);
@@ -145,6 +146,7 @@ void SetLocalCompany(CompanyID new_company)
 	_current_company = _local_company = new_company;
 
 	if (switching_company) {
+		InvalidateFormattedStringCache();
 		InvalidateWindowClassesData(WC_COMPANY);
 		/* Close any construction windows... */
 		CloseConstructionWindows();
@@ -1335,6 +1337,7 @@ CommandCost CmdRenameCompany(DoCommandFlag flags, const std::string &text)
 		} else {
 			c->name = text;
 		}
+		InvalidateFormattedStringCache();
 		MarkWholeScreenDirty();
 		CompanyAdminUpdate(c);
 
@@ -1389,6 +1392,7 @@ CommandCost CmdRenamePresident(DoCommandFlag flags, const std::string &text)
 			}
 		}
 
+		InvalidateFormattedStringCache();
 		InvalidateWindowClassesData(WC_COMPANY, 1);
 		MarkWholeScreenDirty();
 		CompanyAdminUpdate(c);
@@ -74,6 +74,8 @@
 #include "misc_cmd.h"
 #include "order_backup.h"
 #include "cheat_func.h"
+#include "zone_profiler.h"
+#include "departures_func.h"
 #include <time.h>
 
 #include "3rdparty/cpp-btree/btree_set.h"
@@ -2824,6 +2826,63 @@ DEF_CONSOLE_CMD(ConResetBlockedHeliports)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConDepartures)
+{
+	if (argc < 2 || argc > 4) {
+		IConsolePrint(CC_HELP, "List the departures or arrivals of a station.  Usage: 'departures <station-id> [arrivals] [schedule]'");
+		IConsolePrint(CC_HELP, "  arrivals: list arrivals instead of departures.");
+		IConsolePrint(CC_HELP, "  schedule: use the 24 hour scheduled dispatch schedule instead of live vehicle positions.");
+		return true;
+	}
+
+	const Station *st = Station::GetIfValid(atoi(argv[1]));
+	if (st == nullptr) {
+		IConsolePrint(CC_ERROR, "No such station");
+		return true;
+	}
+
+	DepartureType type = D_DEPARTURE;
+	DeparturesSourceMode source_mode = DSM_LIVE;
+	for (int i = 2; i < argc; i++) {
+		if (StrEqualsIgnoreCase(argv[i], "arrivals")) {
+			type = D_ARRIVAL;
+		} else if (StrEqualsIgnoreCase(argv[i], "schedule")) {
+			source_mode = DSM_SCHEDULE_24H;
+		} else {
+			IConsolePrint(CC_ERROR, "Unknown option: {}", argv[i]);
+			return true;
+		}
+	}
+
+	DepartureCallingSettings settings;
+	settings.SetCargoFilter(true, true);
+	settings.SetSmartTerminusEnabled(_settings_client.gui.departure_smart_terminus);
+	const DepartureList departures = MakeStationDepartureList(st->index, source_mode, type, settings);
+
+	SetDParam(0, st->index);
+	IConsolePrint(CC_DEFAULT, "{} of {}: {}", type == D_DEPARTURE ? "Departures" : "Arrivals", GetString(STR_STATION_NAME), departures.size());
+	for (const std::unique_ptr<Departure> &d : departures) {
+		const StateTicks tick = d->scheduled_tick;
+		std::string when;
+		if (_settings_time.time_in_minutes) {
+			ClockFaceMinutes hhmm = _settings_time.ToTickMinutes(tick).ToClockFaceMinutes();
+			when = fmt::format("{:02}:{:02}", hhmm.ClockHour(), hhmm.ClockMinute());
+		} else {
+			when = fmt::format("{} ticks", (tick - _state_ticks).base());
+		}
+		SetDParam(0, d->vehicle->index);
+		std::string vehicle = GetString(STR_VEHICLE_NAME);
+		std::string terminus = "-";
+		if (d->terminus.target.IsStationID() && BaseStation::IsValidID(d->terminus.target.GetStationID())) {
+			SetDParam(0, d->terminus.target.GetStationID());
+			terminus = GetString(STR_STATION_NAME);
+		}
+		IConsolePrint(CC_DEFAULT, "  {}: {}, {} {}", when, vehicle, type == D_DEPARTURE ? "to" : "from", terminus);
+	}
+
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConMergeLinkgraphJobsAsap)
 {
 	if (argc == 0) {
@@ -2990,6 +3049,22 @@ DEF_CONSOLE_CMD(ConDumpDesyncMsgLog)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConStateHash)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Print a hash tree over the game state, to compare with that of another client or the server. Usage: 'state_hash [chunks]'");
+		IConsolePrint(CC_HELP, "  chunks: also print the hash of each chunk of the map and of the pools.");
+		return true;
+	}
+
+	bool include_chunks = argc > 1 && strcmp(argv[1], "chunks") == 0;
+
+	format_buffer buffer;
+	DumpStateHashTree(buffer, BuildStateHashTree(), include_chunks);
+	PrintLineByLine(buffer);
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConDumpInflation)
 {
 	if (argc == 0) {
@@ -3459,6 +3534,22 @@ DEF_CONSOLE_CMD(ConDumpTile)
 	return false;
 }
 
+DEF_CONSOLE_CMD(ConBenchmarkMapLayout)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Time read-only walks over the map, to compare the layouts of the map. Usage: 'benchmark_map_layout [<passes>]'");
+		return true;
+	}
+
+	uint32_t passes = 10;
+	if (argc > 2 || (argc == 2 && (!GetArgumentInteger(&passes, argv[1]) || passes == 0))) return false;
+
+	format_buffer buffer;
+	BenchmarkMapLayout(buffer, passes);
+	PrintLineByLine(buffer);
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConDumpGrfCargoTables)
 {
 	if (argc == 0) {
@@ -3573,6 +3664,43 @@ DEF_CONSOLE_CMD(ConCheckCaches)
 {
 	if (argc == 0) {
 		IConsolePrint(CC_HELP, "Debug: Check caches. Usage: 'check_caches [<broadcast>]'");
+		IConsolePrint(CC_HELP, "  'check_caches costs' shows the duration of the last check of each family of caches.");
+		IConsolePrint(CC_HELP, "  'check_caches families <family>...' checks only the given families of caches.");
+		IConsolePrint(CC_HELP, "  'check_caches periodic <family>...' sets the families of caches checked periodically at the desync debug level.");
+		IConsolePrint(CC_HELP, "  Families: towns, infrastructure, water_regions, road_regions, vehicles, cargo, stations, orders, all.");
+		return true;
+	}
+
+	if (argc == 2 && strcmp(argv[1], "costs") == 0) {
+		format_buffer buffer;
+		DumpCheckCachesCosts(buffer);
+		PrintLineByLine(buffer);
+		return true;
+	}
+
+	if (argc >= 3 && (strcmp(argv[1], "families") == 0 || strcmp(argv[1], "periodic") == 0)) {
+		CheckCachesFlags families = CHECK_CACHE_NONE;
+		for (int i = 2; i < argc; i++) {
+			CheckCachesFlags family = ParseCheckCachesFamily(argv[i]);
+			if (family == CHECK_CACHE_NONE) {
+				IConsolePrint(CC_ERROR, "Unknown family of caches: '{}'", argv[i]);
+				return true;
+			}
+			families |= family;
+		}
+
+		if (strcmp(argv[1], "periodic") == 0) {
+			SetCheckCachesPeriodicFamilies(families);
+			return true;
+		}
+
+		auto logger = [&](std::string_view str) {
+			IConsolePrint(CC_WARNING, std::string{str});
+		};
+		CheckCaches(true, logger, families | CHECK_CACHE_EMIT_LOG);
+		format_buffer buffer;
+		DumpCheckCachesCosts(buffer);
+		PrintLineByLine(buffer);
 		return true;
 	}
 
@@ -4009,6 +4137,59 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 	return false;
 }
 
+DEF_CONSOLE_CMD(ConZoneProfile)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Record the time taken by individual vehicles, stations, tile loop, link graph jobs, scripts and pathfinder calls each tick. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'zone_profile [status]':");
+		IConsolePrint(CC_HELP, "  Show whether zones are being recorded.");
+		IConsolePrint(CC_HELP, "Usage: 'zone_profile start':");
+		IConsolePrint(CC_HELP, "  Begin recording zones, previously recorded zones are discarded.");
+		IConsolePrint(CC_HELP, "Usage: 'zone_profile stop':");
+		IConsolePrint(CC_HELP, "  Stop recording zones.");
+		IConsolePrint(CC_HELP, "Usage: 'zone_profile dump [<num-ticks>]':");
+		IConsolePrint(CC_HELP, "  Write the zones of the last <num-ticks> ticks (default: 10, 0: all recorded) to a Chrome trace JSON file.");
+		return true;
+	}
+
+	/* "status" sub-command */
+	if (argc == 1 || StrStartsWithIgnoreCase(argv[1], "stat")) {
+		IConsolePrint(CC_INFO, "Zone profiling is {}.", _zone_profiler_enabled.load(std::memory_order_relaxed) ? "active" : "inactive");
+		return true;
+	}
+
+	/* "start" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "star")) {
+		ZoneProfilerStart();
+		IConsolePrint(CC_DEBUG, "Started zone profiling.");
+		return true;
+	}
+
+	/* "stop" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sto")) {
+		ZoneProfilerStop();
+		IConsolePrint(CC_DEBUG, "Stopped zone profiling.");
+		return true;
+	}
+
+	/* "dump" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "dum")) {
+		uint ticks = 10;
+		if (argc >= 3 && !GetArgumentInteger(&ticks, argv[2])) return false;
+
+		std::string filename = fmt::format("{}zoneprofile-{:%Y%m%d-%H%M%S}.json", FiosGetScreenshotDir(), fmt::localtime(time(nullptr)));
+		size_t events = 0;
+		if (ZoneProfilerWriteChromeTrace(filename, ticks, events)) {
+			IConsolePrint(CC_DEBUG, "Wrote {} zones to '{}'.", events, filename);
+		} else {
+			IConsolePrint(CC_ERROR, "Failed to open '{}' for writing.", filename);
+		}
+		return true;
+	}
+
+	return false;
+}
+
 DEF_CONSOLE_CMD(ConRoadTypeFlagCtl)
 {
 	if (argc != 3) {
@@ -4399,14 +4580,17 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("zone_profile",            ConZoneProfile);
 
 	IConsole::CmdRegister("find_non_realistic_braking_signal", ConFindNonRealisticBrakingSignal);
 	IConsole::CmdRegister("find_missing_object",     ConFindMissingObject);
+	IConsole::CmdRegister("departures",              ConDepartures);
 
 	IConsole::CmdRegister("getfulldate",             ConGetFullDate,      nullptr, true);
 	IConsole::CmdRegister("dump_command_log",        ConDumpCommandLog,   nullptr, true);
 	IConsole::CmdRegister("dump_special_events_log", ConDumpSpecialEventsLog, nullptr, true);
 	IConsole::CmdRegister("dump_desync_msgs",        ConDumpDesyncMsgLog, nullptr, true);
+	IConsole::CmdRegister("state_hash",              ConStateHash, nullptr, true);
 	IConsole::CmdRegister("dump_inflation",          ConDumpInflation,    nullptr, true);
 	IConsole::CmdRegister("dump_cpdp_stats",         ConDumpCpdpStats,    nullptr, true);
 	IConsole::CmdRegister("dump_veh_stats",          ConVehicleStats,     nullptr, true);
@@ -4423,6 +4607,7 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("dump_cargo_types",        ConDumpCargoTypes,   nullptr, true);
 	IConsole::CmdRegister("dump_vehicle",            ConDumpVehicle,      nullptr, true);
 	IConsole::CmdRegister("dump_tile",               ConDumpTile,         nullptr, true);
+	IConsole::CmdRegister("benchmark_map_layout",    ConBenchmarkMapLayout, nullptr, true);
 	IConsole::CmdRegister("dump_grf_cargo_tables",   ConDumpGrfCargoTables, nullptr, true);
 	IConsole::CmdRegister("dump_signal_styles",      ConDumpSignalStyles, nullptr, true);
 	IConsole::CmdRegister("dump_sprite_cache_stats", ConSpriteCacheStats, nullptr, true);
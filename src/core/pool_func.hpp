@@ -100,6 +100,23 @@ DEFINE_POOL_METHOD(inline size_t)::FindFirstFree()
 	return NO_FREE_ITEM;
 }
 
+/**
+ * Allocate a slab of items and add them to the allocation cache.
+ * This keeps items which are allocated together close together in memory, and avoids a separate allocation per item.
+ */
+DEFINE_POOL_METHOD(inline void)::AllocateCacheSlab()
+{
+	uint8_t *slab = MallocT<uint8_t>(sizeof(Titem) * Tgrowth_step);
+	this->alloc_slabs.push_back(slab);
+
+	/* Add the items in reverse order, so that they are handed out in address order */
+	for (size_t i = Tgrowth_step; i > 0; i--) {
+		AllocCache *ac = reinterpret_cast<AllocCache *>(slab + ((i - 1) * sizeof(Titem)));
+		ac->next = this->alloc_cache;
+		this->alloc_cache = ac;
+	}
+}
+
 /**
  * Makes given index valid
  * @param size size of item
@@ -114,8 +131,10 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index, Pool:
 	this->first_unused = std::max(this->first_unused, index + 1);
 	this->items++;
 
+	if (Tcache && this->alloc_cache == nullptr) this->AllocateCacheSlab();
+
 	Titem *item;
-	if (Tcache && this->alloc_cache != nullptr) {
+	if (Tcache) {
 		dbg_assert(sizeof(Titem) == size);
 		item = reinterpret_cast<Titem *>(this->alloc_cache);
 		this->alloc_cache = this->alloc_cache->next;
@@ -223,11 +242,12 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	this->cleaning = false;
 
 	if (Tcache) {
-		while (this->alloc_cache != nullptr) {
-			AllocCache *ac = this->alloc_cache;
-			this->alloc_cache = ac->next;
-			free(ac);
+		/* All cached items are within the slabs */
+		this->alloc_cache = nullptr;
+		for (void *slab : this->alloc_slabs) {
+			free(slab);
 		}
+		this->alloc_slabs.clear();
 	}
 
 	/* Ensure that item type has necessary constructors/destructors defined. */
@@ -86,7 +86,8 @@ struct DefaultPoolOps {
  * @tparam Tgrowth_step Size of growths; if the pool is full increase the size by this amount
  * @tparam Tmax_size    Maximum size of the pool
  * @tparam Tpool_type   Type of this pool
- * @tparam Tcache       Whether to perform 'alloc' caching, i.e. don't actually free/malloc just reuse the memory
+ * @tparam Tcache       Whether to perform 'alloc' caching, i.e. don't actually free/malloc just reuse the memory,
+ *                      in this case items are allocated contiguously in slabs of Tgrowth_step items
  * @tparam Tzero        Whether to zero the memory
  * @warning when Tcache is enabled *all* instances of this pool's item must be of the same size.
  */
@@ -453,6 +454,9 @@ private:
 	/** Cache of freed pointers */
 	AllocCache *alloc_cache;
 
+	std::vector<void *> alloc_slabs; ///< Blocks of memory from which items are allocated when 'alloc' caching is enabled.
+
+	void AllocateCacheSlab();
 	void *AllocateItem(size_t size, size_t index, ParamType param);
 	void ResizeFor(size_t index);
 	size_t FindFirstFree();
@@ -11,17 +11,46 @@
 #define DEBUG_DESYNC_H
 
 #include <functional>
+#include <vector>
 
+/** Families of caches which are checked by #CheckCaches, and options of the check. */
 enum CheckCachesFlags : uint32_t {
 	CHECK_CACHE_NONE               =       0,
-	CHECK_CACHE_GENERAL            = 1 <<  0,
-	CHECK_CACHE_INFRA_TOTALS       = 1 <<  1,
-	CHECK_CACHE_WATER_REGIONS      = 1 <<  2,
+	CHECK_CACHE_TOWNS              = 1 <<  0, ///< Town, station and industry nearby caches.
+	CHECK_CACHE_INFRA_TOTALS       = 1 <<  1, ///< Company infrastructure totals.
+	CHECK_CACHE_WATER_REGIONS      = 1 <<  2, ///< Water regions.
+	CHECK_CACHE_ROAD_REGIONS       = 1 <<  3, ///< Road regions.
+	CHECK_CACHE_VEHICLES           = 1 <<  4, ///< Vehicle, NewGRF vehicle and template replacement caches.
+	CHECK_CACHE_CARGO              = 1 <<  5, ///< Cargo list caches of vehicles and stations.
+	CHECK_CACHE_STATIONS           = 1 <<  6, ///< Road stop entries and docking tiles.
+	CHECK_CACHE_ORDERS             = 1 <<  7, ///< Order lists, order destinations and routing restriction slots.
+	CHECK_CACHE_FAMILY_COUNT       = 8,       ///< Number of families of caches.
+	CHECK_CACHE_GENERAL            = CHECK_CACHE_TOWNS | CHECK_CACHE_VEHICLES | CHECK_CACHE_CARGO | CHECK_CACHE_STATIONS | CHECK_CACHE_ORDERS,
 	CHECK_CACHE_ALL                = UINT16_MAX,
 	CHECK_CACHE_EMIT_LOG           = 1 << 16,
 };
 DECLARE_ENUM_AS_BIT_SET(CheckCachesFlags)
 
 extern void CheckCaches(bool force_check, std::function<void(std::string_view)> log = nullptr, CheckCachesFlags flags = CHECK_CACHE_ALL);
+CheckCachesFlags ParseCheckCachesFamily(std::string_view name);
+void DumpCheckCachesCosts(struct format_target &buffer);
+void SetCheckCachesPeriodicFamilies(CheckCachesFlags families);
+
+/** Hashes of one part of the game state, split in chunks. */
+struct StateHashSection {
+	std::string_view name;       ///< Name of this part of the game state.
+	uint items_per_chunk;        ///< Number of map rows or pool items covered by each chunk.
+	std::vector<uint64_t> chunks; ///< Hash of each chunk.
+	uint64_t hash;               ///< Hash of the hashes of all chunks.
+};
+
+/** Hash tree over the game state. */
+struct StateHashTree {
+	std::vector<StateHashSection> sections; ///< The sections of the game state.
+	uint64_t root;                          ///< Hash of the hashes of all sections.
+};
+
+StateHashTree BuildStateHashTree();
+void DumpStateHashTree(struct format_target &buffer, const StateHashTree &tree, bool include_chunks);
 
 #endif /* DEBUG_DESYNC_H */
@@ -1719,145 +1719,234 @@ void DepartureListScheduleModeSlotEvaluator::EvaluateSlots()
 	}
 }
 
-static DepartureList MakeDepartureListScheduleMode(DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles, DepartureType type,
-		DepartureCallingSettings calling_settings, const StateTicks start_tick, const StateTicks end_tick, const uint max_departure_slots_per_schedule)
+/**
+ * Evaluate the departures of a single order list in schedule mode, before these are shifted into the schedule window and sorted.
+ * @param result list to append the departures to, this should be empty
+ * @param v vehicle to use for the order list
+ */
+static void EvaluateScheduleModeOrderList(DepartureList &result, const Vehicle *v, const DepartureOrderDestinationDetector &source, DepartureType type,
+		DepartureCallingSettings calling_settings, const StateTicks start_tick, const Ticks tick_duration, const uint max_departure_slots_per_schedule,
+		std::vector<ArrivalHistoryEntry> &arrival_history)
 {
-	const Ticks tick_duration = (end_tick - start_tick).AsTicks();
+	std::vector<DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno> schedule_anno;
+	schedule_anno.resize(v->orders->GetScheduledDispatchScheduleCount());
+	for (uint i = 0; i < v->orders->GetScheduledDispatchScheduleCount(); i++) {
+		/* This is mutable so that parts can be backed up, modified and restored later */
+		DispatchSchedule &ds = const_cast<Vehicle *>(v)->orders->GetDispatchScheduleByIndex(i);
+		DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno &anno = schedule_anno[i];
 
-	std::vector<std::unique_ptr<Departure>> result;
-	std::vector<ArrivalHistoryEntry> arrival_history;
+		anno.original_position_backup = ds.BackupPosition();
 
-	for (const Vehicle *veh : vehicles) {
-		if (!HasBit(veh->vehicle_flags, VF_SCHEDULED_DISPATCH)) continue;
+		const uint32_t duration = ds.GetScheduledDispatchDuration();
+		if (duration < _settings_time.ticks_per_minute || duration > (uint)tick_duration) continue; // Duration is obviously out of range
+		if (tick_duration % duration != 0) continue; // Duration does not evenly fit into range
+		const uint slot_count = (uint)ds.GetScheduledDispatch().size();
+		if (slot_count == 0) continue; // No departure slots
 
-		const Vehicle *v = nullptr;
-		for (const Vehicle *u = veh->FirstShared(); u != nullptr; u = u->NextShared()) {
-			if (IsVehicleUsableForDepartures(u, calling_settings)) {
-				v = u;
-				break;
-			}
+		anno.repetition = tick_duration / ds.GetScheduledDispatchDuration();
+
+		if (anno.repetition * slot_count > max_departure_slots_per_schedule) continue;
+
+		StateTicks dispatch_tick = ds.GetScheduledDispatchStartTick();
+		if (dispatch_tick < start_tick) {
+			dispatch_tick += CeilDivT<StateTicksDelta>(start_tick - dispatch_tick, StateTicksDelta{duration}).AsTicks() * duration;
 		}
-		if (v == nullptr) continue;
+		if (dispatch_tick > start_tick) {
+			StateTicksDelta delta = (dispatch_tick - start_tick);
+			dispatch_tick -= (delta / duration).AsTicksT<uint>() * duration;
+		}
+
+		ds.SetScheduledDispatchStartTick(dispatch_tick);
+		ds.SetScheduledDispatchLastDispatch(INVALID_SCHEDULED_DISPATCH_OFFSET);
+		anno.usable = true;
+	}
 
-		std::vector<DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno> schedule_anno;
-		schedule_anno.resize(v->orders->GetScheduledDispatchScheduleCount());
+	auto guard = scope_guard([&]() {
 		for (uint i = 0; i < v->orders->GetScheduledDispatchScheduleCount(); i++) {
-			/* This is mutable so that parts can be backed up, modified and restored later */
+			/* Restore backup */
 			DispatchSchedule &ds = const_cast<Vehicle *>(v)->orders->GetDispatchScheduleByIndex(i);
-			DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno &anno = schedule_anno[i];
+			const DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno &anno = schedule_anno[i];
+			ds.RestorePosition(anno.original_position_backup);
+		}
+	});
 
-			anno.original_position_backup = ds.BackupPosition();
+	std::vector<std::pair<const Order *, StateTicks>> dispatch_arrival_ticks;
 
-			const uint32_t duration = ds.GetScheduledDispatchDuration();
-			if (duration < _settings_time.ticks_per_minute || duration > (uint)tick_duration) continue; // Duration is obviously out of range
-			if (tick_duration % duration != 0) continue; // Duration does not evenly fit into range
-			const uint slot_count = (uint)ds.GetScheduledDispatch().size();
-			if (slot_count == 0) continue; // No departure slots
+	for (const Order *start_order : v->Orders()) {
+		if (start_order->IsScheduledDispatchOrder(true)) {
+			const uint schedule_index = start_order->GetDispatchScheduleIndex();
+			DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno &anno = schedule_anno[schedule_index];
+			if (!anno.usable) continue;
 
-			anno.repetition = tick_duration / ds.GetScheduledDispatchDuration();
+			DispatchSchedule &ds = const_cast<Vehicle *>(v)->orders->GetDispatchScheduleByIndex(schedule_index);
+			DepartureListScheduleModeSlotEvaluator evaluator{
+				result, v, start_order, ds, anno, schedule_index, source, type, calling_settings, arrival_history, calling_settings.DispatchArrivalTicksEnabled() ? &dispatch_arrival_ticks : nullptr
+			};
+			evaluator.EvaluateSlots();
+		}
+	}
 
-			if (anno.repetition * slot_count > max_departure_slots_per_schedule) continue;
+	if (calling_settings.DispatchArrivalTicksEnabled() && !dispatch_arrival_ticks.empty()) {
+		/* Use dispatch arrival tick map to fill in missing arrival times for vehicles dispatched from here, if required */
+		std::vector<Departure *> pending_departures;
+		for (const Order *start_order : v->Orders()) {
+			if (start_order->IsScheduledDispatchOrder(true)) {
+				pending_departures.clear();
+				for (size_t i = 0; i < result.size(); i++) {
+					Departure *d = result[i].get();
+					if (d->scheduled_waiting_time == Departure::MISSING_WAIT_TICKS && d->order == start_order) {
+						pending_departures.push_back(d);
+					}
+				}
 
-			StateTicks dispatch_tick = ds.GetScheduledDispatchStartTick();
-			if (dispatch_tick < start_tick) {
-				dispatch_tick += CeilDivT<StateTicksDelta>(start_tick - dispatch_tick, StateTicksDelta{duration}).AsTicks() * duration;
-			}
-			if (dispatch_tick > start_tick) {
-				StateTicksDelta delta = (dispatch_tick - start_tick);
-				dispatch_tick -= (delta / duration).AsTicksT<uint>() * duration;
-			}
+				if (pending_departures.empty()) continue;
 
-			ds.SetScheduledDispatchStartTick(dispatch_tick);
-			ds.SetScheduledDispatchLastDispatch(INVALID_SCHEDULED_DISPATCH_OFFSET);
-			anno.usable = true;
-		}
+				for (const auto &it : dispatch_arrival_ticks) {
+					if (it.first != start_order) continue;
+					StateTicks arrival_tick = it.second;
 
-		auto guard = scope_guard([&]() {
-			for (uint i = 0; i < v->orders->GetScheduledDispatchScheduleCount(); i++) {
-				/* Restore backup */
-				DispatchSchedule &ds = const_cast<Vehicle *>(v)->orders->GetDispatchScheduleByIndex(i);
-				const DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno &anno = schedule_anno[i];
-				ds.RestorePosition(anno.original_position_backup);
-			}
-		});
+					size_t best_idx = SIZE_MAX;
+					StateTicks best_tick = StateTicks(INT64_MAX);
 
-		const size_t initial_result_size = result.size();
-		std::vector<std::pair<const Order *, StateTicks>> dispatch_arrival_ticks;
+					/* Evaluate pending departures */
+					for (size_t i = 0; i < pending_departures.size(); i++) {
+						const Departure *d = pending_departures[i];
 
-		for (const Order *start_order : v->Orders()) {
-			if (start_order->IsScheduledDispatchOrder(true)) {
-				const uint schedule_index = start_order->GetDispatchScheduleIndex();
-				DepartureListScheduleModeSlotEvaluator::DispatchScheduleAnno &anno = schedule_anno[schedule_index];
-				if (!anno.usable) continue;
-
-				DispatchSchedule &ds = const_cast<Vehicle *>(v)->orders->GetDispatchScheduleByIndex(schedule_index);
-				DepartureListScheduleModeSlotEvaluator evaluator{
-					result, v, start_order, ds, anno, schedule_index, source, type, calling_settings, arrival_history, calling_settings.DispatchArrivalTicksEnabled() ? &dispatch_arrival_ticks : nullptr
-				};
-				evaluator.EvaluateSlots();
-			}
-		}
+						StateTicks tick = d->scheduled_tick;
+						if (arrival_tick <= tick - d->order->GetWaitTime()) {
+							/* Found a usable departure */
+						} else if (arrival_tick <= tick + tick_duration - d->order->GetWaitTime()) {
+							/* Found a usable departure, with the schedule duration added (wrapping at end of schedule) */
+							tick += tick_duration;
+						} else {
+							/* Not usable */
+							continue;
+						}
 
-		if (calling_settings.DispatchArrivalTicksEnabled() && !dispatch_arrival_ticks.empty()) {
-			/* Use dispatch arrival tick map to fill in missing arrival times for vehicles dispatched from here, if required */
-			std::vector<Departure *> pending_departures;
-			for (const Order *start_order : v->Orders()) {
-				if (start_order->IsScheduledDispatchOrder(true)) {
-					pending_departures.clear();
-					for (size_t i = initial_result_size; i < result.size(); i++) {
-						Departure *d = result[i].get();
-						if (d->scheduled_waiting_time == Departure::MISSING_WAIT_TICKS && d->order == start_order) {
-							pending_departures.push_back(d);
+						/* Found first/better departure */
+						if (tick < best_tick) {
+							best_idx = i;
+							best_tick = tick;
 						}
 					}
 
-					if (pending_departures.empty()) continue;
+					if (best_idx != SIZE_MAX) {
+						/* Found a suitable departure for this arrival, update the waiting time (i.e. arrival time) and remove from pending list */
+						Departure *d = pending_departures[best_idx];
+						pending_departures[best_idx] = pending_departures.back();
+						pending_departures.pop_back();
 
-					for (const auto &it : dispatch_arrival_ticks) {
-						if (it.first != start_order) continue;
-						StateTicks arrival_tick = it.second;
+						d->scheduled_waiting_time = (best_tick - arrival_tick).AsTicks();
+					}
 
-						size_t best_idx = SIZE_MAX;
-						StateTicks best_tick = StateTicks(INT64_MAX);
+					if (pending_departures.empty()) break;
+				}
+			}
+		}
+	}
+}
 
-						/* Evaluate pending departures */
-						for (size_t i = 0; i < pending_departures.size(); i++) {
-							const Departure *d = pending_departures[i];
+/** Departures of a single order list in schedule mode, see EvaluateScheduleModeOrderList. */
+struct ScheduleModeOrderListDepartures {
+	VehicleID vehicle;                 ///< Vehicle which was used for the order list.
+	uint32_t schedule_version;         ///< Schedule version of the order list when it was evaluated.
+	std::vector<Departure> departures; ///< Departures, before being shifted into the schedule window.
+};
 
-							StateTicks tick = d->scheduled_tick;
-							if (arrival_tick <= tick - d->order->GetWaitTime()) {
-								/* Found a usable departure */
-							} else if (arrival_tick <= tick + tick_duration - d->order->GetWaitTime()) {
-								/* Found a usable departure, with the schedule duration added (wrapping at end of schedule) */
-								tick += tick_duration;
-							} else {
-								/* Not usable */
-								continue;
-							}
+/** Cached schedule mode departures for a particular query. */
+struct ScheduleModeDepartureCache {
+	DepartureOrderDestinationDetector source;
+	DepartureType type;
+	DepartureCallingSettings calling_settings;
+	StateTicks start_tick;
+	Ticks tick_duration;
+	uint max_departure_slots_per_schedule;
+	DeparturesConditionalJumpResult departure_conditionals;
+	btree::btree_map<OrderListID, ScheduleModeOrderListDepartures> order_lists; ///< Departures by order list, only order lists used by the last query are kept.
+
+	bool Matches(const DepartureOrderDestinationDetector &source, DepartureType type, DepartureCallingSettings calling_settings, StateTicks start_tick,
+			Ticks tick_duration, uint max_departure_slots_per_schedule) const
+	{
+		return this->source == source && this->type == type && this->calling_settings == calling_settings && this->start_tick == start_tick &&
+				this->tick_duration == tick_duration && this->max_departure_slots_per_schedule == max_departure_slots_per_schedule &&
+				this->departure_conditionals == _settings_client.gui.departure_conditionals;
+	}
+};
 
-							/* Found first/better departure */
-							if (tick < best_tick) {
-								best_idx = i;
-								best_tick = tick;
-							}
-						}
+/**
+ * Schedule mode departure caches, most recently used first.
+ * Departure boards recompute their lists frequently, but the schedule of most order lists rarely changes.
+ * Only the order lists whose schedule version has changed since the previous query need to be evaluated again.
+ */
+static std::vector<ScheduleModeDepartureCache> _schedule_mode_departure_caches;
+static constexpr size_t MAX_SCHEDULE_MODE_DEPARTURE_CACHES = 16;
 
-						if (best_idx != SIZE_MAX) {
-							/* Found a suitable departure for this arrival, update the waiting time (i.e. arrival time) and remove from pending list */
-							Departure *d = pending_departures[best_idx];
-							pending_departures[best_idx] = pending_departures.back();
-							pending_departures.pop_back();
+static ScheduleModeDepartureCache &GetScheduleModeDepartureCache(const DepartureOrderDestinationDetector &source, DepartureType type,
+		DepartureCallingSettings calling_settings, StateTicks start_tick, Ticks tick_duration, uint max_departure_slots_per_schedule)
+{
+	auto iter = std::find_if(_schedule_mode_departure_caches.begin(), _schedule_mode_departure_caches.end(), [&](const ScheduleModeDepartureCache &cache) {
+		return cache.Matches(source, type, calling_settings, start_tick, tick_duration, max_departure_slots_per_schedule);
+	});
+	if (iter == _schedule_mode_departure_caches.end()) {
+		if (_schedule_mode_departure_caches.size() >= MAX_SCHEDULE_MODE_DEPARTURE_CACHES) _schedule_mode_departure_caches.pop_back();
+		_schedule_mode_departure_caches.insert(_schedule_mode_departure_caches.begin(), ScheduleModeDepartureCache{
+			source, type, calling_settings, start_tick, tick_duration, max_departure_slots_per_schedule, _settings_client.gui.departure_conditionals, {}
+		});
+	} else if (iter != _schedule_mode_departure_caches.begin()) {
+		std::rotate(_schedule_mode_departure_caches.begin(), iter, iter + 1);
+	}
+	return _schedule_mode_departure_caches.front();
+}
 
-							d->scheduled_waiting_time = (best_tick - arrival_tick).AsTicks();
-						}
+static DepartureList MakeDepartureListScheduleMode(DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles, DepartureType type,
+		DepartureCallingSettings calling_settings, const StateTicks start_tick, const StateTicks end_tick, const uint max_departure_slots_per_schedule)
+{
+	const Ticks tick_duration = (end_tick - start_tick).AsTicks();
 
-						if (pending_departures.empty()) break;
-					}
+	std::vector<std::unique_ptr<Departure>> result;
+	std::vector<ArrivalHistoryEntry> arrival_history;
+
+	ScheduleModeDepartureCache &cache = GetScheduleModeDepartureCache(source, type, calling_settings, start_tick, tick_duration, max_departure_slots_per_schedule);
+	btree::btree_map<OrderListID, ScheduleModeOrderListDepartures> order_lists;
+	DepartureList order_list_result;
+
+	for (const Vehicle *veh : vehicles) {
+		if (!HasBit(veh->vehicle_flags, VF_SCHEDULED_DISPATCH)) continue;
+
+		const Vehicle *v = nullptr;
+		for (const Vehicle *u = veh->FirstShared(); u != nullptr; u = u->NextShared()) {
+			if (IsVehicleUsableForDepartures(u, calling_settings)) {
+				v = u;
+				break;
+			}
+		}
+		if (v == nullptr) continue;
+
+		auto iter = order_lists.find(v->orders->index);
+		if (iter == order_lists.end()) {
+			auto cached = cache.order_lists.find(v->orders->index);
+			if (cached != cache.order_lists.end() && cached->second.vehicle == v->index && cached->second.schedule_version == v->orders->GetScheduleVersion()) {
+				iter = order_lists.insert({ v->orders->index, std::move(cached->second) }).first;
+			} else {
+				order_list_result.clear();
+				EvaluateScheduleModeOrderList(order_list_result, v, source, type, calling_settings, start_tick, tick_duration, max_departure_slots_per_schedule, arrival_history);
+
+				ScheduleModeOrderListDepartures entry{ v->index, v->orders->GetScheduleVersion(), {} };
+				entry.departures.reserve(order_list_result.size());
+				for (std::unique_ptr<Departure> &d : order_list_result) {
+					entry.departures.push_back(std::move(*d));
 				}
+				iter = order_lists.insert({ v->orders->index, std::move(entry) }).first;
 			}
 		}
+
+		for (const Departure &d : iter->second.departures) {
+			result.push_back(std::make_unique<Departure>(d));
+		}
 	}
 
+	cache.order_lists = std::move(order_lists);
+
 	for (std::unique_ptr<Departure> &d : result) {
 		StateTicks new_tick = d->scheduled_tick;
 		if (new_tick < start_tick) {
@@ -1911,3 +2000,40 @@ DepartureList MakeDepartureList(DeparturesSourceMode source_mode, DepartureOrder
 			NOT_REACHED();
 	}
 }
+
+/**
+ * Compute an up-to-date list of departures for a station, without requiring a departure board window.
+ * This is suitable for use by the console, admin port and the like. All vehicle types calling at the station are included.
+ * @param station the station to compute the departures of
+ * @param source_mode the departure source mode to use
+ * @param type the type of departures to get (departures or arrivals)
+ * @param calling_settings departure calling settings
+ * @return a list of departures, which is empty if an error occurred
+ */
+DepartureList MakeStationDepartureList(StationID station, DeparturesSourceMode source_mode, DepartureType type, DepartureCallingSettings calling_settings)
+{
+	DepartureOrderDestinationDetector source;
+	SetBit(source.order_type_mask, OT_GOTO_STATION);
+	source.destination = station;
+
+	std::vector<const Vehicle *> vehicles;
+	for (const Vehicle *veh : Vehicle::IterateFrontOnly()) {
+		if (!veh->IsPrimaryVehicle() || veh != veh->FirstShared()) continue;
+		if (source_mode != DSM_LIVE && !HasBit(veh->vehicle_flags, VF_SCHEDULED_DISPATCH)) continue;
+
+		for (const Order *order : veh->Orders()) {
+			if (source.OrderMatches(order)) {
+				if (source_mode == DSM_LIVE) {
+					for (const Vehicle *v = veh; v != nullptr; v = v->NextShared()) {
+						vehicles.push_back(v);
+					}
+				} else {
+					vehicles.push_back(veh);
+				}
+				break;
+			}
+		}
+	}
+
+	return MakeDepartureList(source_mode, source, vehicles, type, calling_settings);
+}
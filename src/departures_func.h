@@ -18,6 +18,7 @@
 #include <vector>
 
 DepartureList MakeDepartureList(DeparturesSourceMode source_mode, DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles, DepartureType type, DepartureCallingSettings calling_settings);
+DepartureList MakeStationDepartureList(StationID station, DeparturesSourceMode source_mode, DepartureType type, DepartureCallingSettings calling_settings);
 
 Ticks GetDeparturesMaxTicksAhead();
 
@@ -178,6 +178,8 @@ struct DepartureOrderDestinationDetector {
 	{
 		return (HasBit(this->order_type_mask, OT_GOTO_STATION) || HasBit(this->order_type_mask, OT_GOTO_WAYPOINT)) && station == this->destination;
 	}
+
+	bool operator==(const DepartureOrderDestinationDetector &other) const = default;
 };
 
 struct DepartureCallingSettings {
@@ -237,6 +239,8 @@ public:
 	bool IsDeparture(const Order *order, const DepartureOrderDestinationDetector &source) const;
 	bool IsArrival(const Order *order, const DepartureOrderDestinationDetector &source) const;
 	DepartureShowAs GetShowAsType(const Order *order, DepartureType type) const;
+
+	bool operator==(const DepartureCallingSettings &other) const = default;
 };
 
 typedef std::vector<std::unique_ptr<Departure>> DepartureList;
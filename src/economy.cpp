@@ -656,7 +656,7 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 
 	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
 
-	NotifyRoadLayoutChanged();
+	NotifyRoadLayoutChangedEverywhere();
 
 	InvalidateTemplateReplacementImages();
 
@@ -16,6 +16,7 @@
 #include "animated_tile_func.h"
 #include "effectvehicle_func.h"
 #include "effectvehicle_base.h"
+#include "viewport_func.h"
 #include "core/checksum_func.hpp"
 #include "core/container_func.hpp"
 
@@ -683,3 +684,459 @@ void EffectVehicle::RemoveEffectVehicleFromTickCache()
 	if (!_tick_caches_valid) return;
 	_remove_from_tick_effect_veh_cache.push_back(this->index);
 }
+
+/** Animation of a type of effect which is kept as a particle instead of as an effect vehicle. */
+struct EffectParticleSpec {
+	SpriteID first_sprite; ///< First sprite of the animation, 0 if the type is not a particle.
+	SpriteID last_sprite;  ///< Last sprite of the animation.
+	uint8_t progress;      ///< Initial animation progress.
+};
+
+/**
+ * Per-EffectVehicleType particle animations.
+ * Only effects which are purely visual are particles: these do not use the game random, do not look at or change
+ * the map, and are not needed by anything else. The others remain effect vehicles.
+ */
+static const std::array<EffectParticleSpec, EV_END> _effect_particle_specs = {{
+	{ 0,                     0,                     0  }, // EV_CHIMNEY_SMOKE
+	{ SPR_STEAM_SMOKE_0,     SPR_STEAM_SMOKE_4,     12 }, // EV_STEAM_SMOKE
+	{ SPR_DIESEL_SMOKE_0,    SPR_DIESEL_SMOKE_5,    0  }, // EV_DIESEL_SMOKE
+	{ SPR_ELECTRIC_SPARK_0,  SPR_ELECTRIC_SPARK_5,  1  }, // EV_ELECTRIC_SPARK
+	{ 0,                     0,                     0  }, // EV_CRASH_SMOKE
+	{ 0,                     0,                     0  }, // EV_EXPLOSION_LARGE
+	{ SPR_BREAKDOWN_SMOKE_0, SPR_BREAKDOWN_SMOKE_3, 0  }, // EV_BREAKDOWN_SMOKE
+	{ 0,                     0,                     0  }, // EV_EXPLOSION_SMALL
+	{ 0,                     0,                     0  }, // EV_BULLDOZER
+	{ 0,                     0,                     0  }, // EV_BUBBLE
+	{ SPR_SMOKE_0,           SPR_SMOKE_4,           12 }, // EV_BREAKDOWN_SMOKE_AIRCRAFT
+	{ SPR_SMOKE_0,           SPR_SMOKE_4,           12 }, // EV_COPPER_MINE_SMOKE
+}};
+
+/* Number of bits in the viewport hash of the particles to use from each screen coordinate. */
+static const uint PARTICLE_HASHX_BITS = 6;
+static const uint PARTICLE_HASHY_BITS = 6;
+
+/* Size of each bucket of the viewport hash of the particles, the same as for vehicles. */
+static const uint PARTICLE_HASHX_BUCKET_BITS = 7 + ZOOM_BASE_SHIFT;
+static const uint PARTICLE_HASHY_BUCKET_BITS = 6 + ZOOM_BASE_SHIFT;
+
+/**
+ * Compact store of the effect particles.
+ * The state is kept as a structure of arrays, so that all particles can be ticked in one pass.
+ * For drawing, the particles are also kept in a viewport hash on the top left of their position on the screen,
+ * so that only the particles near a part of the screen being drawn are looked at.
+ * Particles are not part of the game state: they are not saved, not included in the state checksum,
+ * and not created at all without a screen.
+ */
+struct EffectParticles {
+	std::vector<EffectVehicleType> type; ///< Type of the effect.
+	std::vector<int32_t> x_pos;          ///< x coordinate.
+	std::vector<int32_t> y_pos;          ///< y coordinate.
+	std::vector<int32_t> z_pos;          ///< z coordinate.
+	std::vector<SpriteID> sprite;        ///< Current sprite of the animation.
+	std::vector<uint8_t> progress;       ///< Progress of the animation.
+	std::vector<uint16_t> lifetime;      ///< Remaining ticks, for effects with a lifetime set by their creator.
+	std::vector<Rect> coord;             ///< Position of the sprite on the screen.
+	std::vector<uint16_t> hash;          ///< Bucket of the viewport hash the particle is in.
+	std::vector<uint32_t> hash_pos;      ///< Position of the particle in its bucket.
+
+	std::array<std::vector<uint32_t>, 1 << (PARTICLE_HASHX_BITS + PARTICLE_HASHY_BITS)> buckets; ///< Viewport hash of the particle indices.
+	int max_width = 0;                   ///< Largest width on the screen of any particle, to find the particles reaching into a bucket from the left.
+	int max_height = 0;                  ///< Largest height on the screen of any particle, to find the particles reaching into a bucket from above.
+
+	static uint GetHashX(int x) { return GB(x, PARTICLE_HASHX_BUCKET_BITS, PARTICLE_HASHX_BITS); }
+	static uint GetHashY(int y) { return GB(y, PARTICLE_HASHY_BUCKET_BITS, PARTICLE_HASHY_BITS) << PARTICLE_HASHX_BITS; }
+	static uint GetHash(const Rect &coord) { return GetHashY(coord.top) + GetHashX(coord.left); }
+
+	size_t Size() const { return this->type.size(); }
+
+	/**
+	 * Add a particle to a bucket of the viewport hash.
+	 * @param i Index of the particle.
+	 * @param hash The bucket.
+	 */
+	void Link(size_t i, uint hash)
+	{
+		std::vector<uint32_t> &bucket = this->buckets[hash];
+		this->hash[i] = hash;
+		this->hash_pos[i] = static_cast<uint32_t>(bucket.size());
+		bucket.push_back(static_cast<uint32_t>(i));
+	}
+
+	/**
+	 * Remove a particle from its bucket of the viewport hash.
+	 * @param i Index of the particle.
+	 */
+	void Unlink(size_t i)
+	{
+		std::vector<uint32_t> &bucket = this->buckets[this->hash[i]];
+		const uint32_t pos = this->hash_pos[i];
+		bucket[pos] = bucket.back();
+		this->hash_pos[bucket[pos]] = pos;
+		bucket.pop_back();
+	}
+
+	/**
+	 * Set the position on the screen of a particle, and move it to the matching bucket of the viewport hash.
+	 * @param i Index of the particle.
+	 * @param coord The new position.
+	 */
+	void SetCoord(size_t i, const Rect &coord)
+	{
+		this->coord[i] = coord;
+		this->max_width = std::max(this->max_width, coord.right - coord.left);
+		this->max_height = std::max(this->max_height, coord.bottom - coord.top);
+
+		const uint hash = GetHash(coord);
+		if (hash == this->hash[i]) return;
+		this->Unlink(i);
+		this->Link(i, hash);
+	}
+
+	size_t Add(EffectVehicleType type, int32_t x, int32_t y, int32_t z, const EffectParticleSpec &spec, uint16_t lifetime)
+	{
+		this->type.push_back(type);
+		this->x_pos.push_back(x);
+		this->y_pos.push_back(y);
+		this->z_pos.push_back(z);
+		this->sprite.push_back(spec.first_sprite);
+		this->progress.push_back(spec.progress);
+		this->lifetime.push_back(lifetime);
+		this->coord.emplace_back();
+		this->hash.emplace_back();
+		this->hash_pos.emplace_back();
+
+		const size_t i = this->Size() - 1;
+		this->Link(i, GetHash(this->coord[i]));
+		return i;
+	}
+
+	/**
+	 * Remove a particle, by moving the last particle into its place.
+	 * @param i Index of the particle.
+	 */
+	void Remove(size_t i)
+	{
+		this->Unlink(i);
+
+		const size_t last = this->Size() - 1;
+		if (i != last) {
+			this->buckets[this->hash[last]][this->hash_pos[last]] = static_cast<uint32_t>(i);
+			this->hash[i] = this->hash[last];
+			this->hash_pos[i] = this->hash_pos[last];
+			this->type[i] = this->type[last];
+			this->x_pos[i] = this->x_pos[last];
+			this->y_pos[i] = this->y_pos[last];
+			this->z_pos[i] = this->z_pos[last];
+			this->sprite[i] = this->sprite[last];
+			this->progress[i] = this->progress[last];
+			this->lifetime[i] = this->lifetime[last];
+			this->coord[i] = this->coord[last];
+		}
+		this->type.pop_back();
+		this->x_pos.pop_back();
+		this->y_pos.pop_back();
+		this->z_pos.pop_back();
+		this->sprite.pop_back();
+		this->progress.pop_back();
+		this->lifetime.pop_back();
+		this->coord.pop_back();
+		this->hash.pop_back();
+		this->hash_pos.pop_back();
+	}
+
+	void Clear()
+	{
+		this->type.clear();
+		this->x_pos.clear();
+		this->y_pos.clear();
+		this->z_pos.clear();
+		this->sprite.clear();
+		this->progress.clear();
+		this->lifetime.clear();
+		this->coord.clear();
+		this->hash.clear();
+		this->hash_pos.clear();
+		for (std::vector<uint32_t> &bucket : this->buckets) {
+			bucket.clear();
+		}
+	}
+};
+
+static EffectParticles _effect_particles;
+
+static void MarkEffectParticleDirty(const Rect &coord)
+{
+	::MarkAllViewportsDirty(coord.left, coord.top, coord.right, coord.bottom, VMDF_NOT_LANDSCAPE | VMDF_NOT_MAP_MODE);
+}
+
+/**
+ * Update the position on the screen of a particle, and mark the old and new positions dirty.
+ * @param i Index of the particle.
+ * @param is_new Whether the particle has just been created, and so has no old position.
+ */
+static void UpdateEffectParticleViewport(size_t i, bool is_new)
+{
+	EffectParticles &p = _effect_particles;
+
+	VehicleSpriteSeq seq;
+	seq.Set(p.sprite[i]);
+	Rect new_coord = ConvertRect<Rect16, Rect>(seq.GetBounds());
+
+	Point pt = RemapCoords(p.x_pos[i], p.y_pos[i], p.z_pos[i]);
+	new_coord.left   += pt.x;
+	new_coord.top    += pt.y;
+	new_coord.right  += pt.x + 2 * ZOOM_BASE;
+	new_coord.bottom += pt.y + 2 * ZOOM_BASE;
+
+	const Rect &coord = p.coord[i];
+	if (is_new) {
+		MarkEffectParticleDirty(new_coord);
+	} else {
+		MarkEffectParticleDirty({
+				std::min(coord.left,   new_coord.left),
+				std::min(coord.top,    new_coord.top),
+				std::max(coord.right,  new_coord.right),
+				std::max(coord.bottom, new_coord.bottom)
+		});
+	}
+	p.SetCoord(i, new_coord);
+}
+
+/**
+ * Is an effect of this type kept as a particle instead of as an effect vehicle?
+ * @param type The type of effect.
+ * @return true if the effect is purely visual and is created as a particle.
+ */
+bool IsEffectParticleType(EffectVehicleType type)
+{
+	return _effect_particle_specs[type].first_sprite != 0;
+}
+
+/**
+ * Create an effect particle at a particular location.
+ * @param x The x location on the map.
+ * @param y The y location on the map.
+ * @param z The z location on the map.
+ * @param type The type of effect, this must be a particle type.
+ * @param lifetime The number of ticks before the effect disappears, only used by EV_BREAKDOWN_SMOKE.
+ */
+void CreateEffectParticle(int x, int y, int z, EffectVehicleType type, uint16_t lifetime)
+{
+	dbg_assert(IsEffectParticleType(type));
+
+	/* Particles are only seen, so there is nothing to do without a screen. */
+	if (IsHeadless()) return;
+
+	size_t i = _effect_particles.Add(type, x, y, z, _effect_particle_specs[type], lifetime);
+	UpdateEffectParticleViewport(i, true);
+}
+
+/**
+ * Create an effect particle above a particular location.
+ * @param x The x location on the map.
+ * @param y The y location on the map.
+ * @param z The offset from the ground.
+ * @param type The type of effect, this must be a particle type.
+ */
+void CreateEffectParticleAbove(int x, int y, int z, EffectVehicleType type)
+{
+	if (IsHeadless()) return;
+
+	int safe_x = Clamp(x, 0, Map::MaxX() * TILE_SIZE);
+	int safe_y = Clamp(y, 0, Map::MaxY() * TILE_SIZE);
+	CreateEffectParticle(x, y, GetSlopePixelZ(safe_x, safe_y) + z, type);
+}
+
+/**
+ * Create an effect particle above a particular vehicle.
+ * @param v The vehicle to base the position on.
+ * @param x The x offset to the vehicle.
+ * @param y The y offset to the vehicle.
+ * @param z The z offset to the vehicle.
+ * @param type The type of effect, this must be a particle type.
+ * @param lifetime The number of ticks before the effect disappears, only used by EV_BREAKDOWN_SMOKE.
+ */
+void CreateEffectParticleRel(const Vehicle *v, int x, int y, int z, EffectVehicleType type, uint16_t lifetime)
+{
+	CreateEffectParticle(v->x_pos + x, v->y_pos + y, v->z_pos + z, type, lifetime);
+}
+
+/** Result of ticking a single effect particle. */
+enum EffectParticleTickResult : uint8_t {
+	EPTR_UNCHANGED, ///< Nothing visible changed.
+	EPTR_MOVED,     ///< The position or the sprite changed.
+	EPTR_EXPIRED,   ///< The animation is finished, the particle should be removed.
+};
+
+/**
+ * Tick a single effect particle.
+ * This is the same animation as the tick procedure of the corresponding effect vehicle.
+ * @param i Index of the particle.
+ * @return What changed.
+ */
+static EffectParticleTickResult TickEffectParticle(size_t i)
+{
+	EffectParticles &p = _effect_particles;
+	const EffectParticleSpec &spec = _effect_particle_specs[p.type[i]];
+	uint8_t &progress = p.progress[i];
+	SpriteID &sprite = p.sprite[i];
+	bool moved = false;
+
+	switch (p.type[i]) {
+		case EV_STEAM_SMOKE:
+		case EV_BREAKDOWN_SMOKE_AIRCRAFT:
+		case EV_COPPER_MINE_SMOKE:
+			/* Steam smoke rises at half the speed of the other smoke. */
+			progress++;
+			if ((progress & (p.type[i] == EV_STEAM_SMOKE ? 7 : 3)) == 0) {
+				p.z_pos[i]++;
+				moved = true;
+			}
+			if ((progress & 0xF) == 4) {
+				if (sprite == spec.last_sprite) return EPTR_EXPIRED;
+				sprite++;
+				moved = true;
+			}
+			break;
+
+		case EV_DIESEL_SMOKE:
+			progress++;
+			if ((progress & 3) == 0) {
+				p.z_pos[i]++;
+				moved = true;
+			} else if ((progress & 7) == 1) {
+				if (sprite == spec.last_sprite) return EPTR_EXPIRED;
+				sprite++;
+				moved = true;
+			}
+			break;
+
+		case EV_ELECTRIC_SPARK:
+			if (progress < 2) {
+				progress++;
+			} else {
+				progress = 0;
+				if (sprite == spec.last_sprite) return EPTR_EXPIRED;
+				sprite++;
+				moved = true;
+			}
+			break;
+
+		case EV_BREAKDOWN_SMOKE:
+			progress++;
+			if ((progress & 7) == 0) {
+				sprite = (sprite == spec.last_sprite) ? spec.first_sprite : sprite + 1;
+				moved = true;
+			}
+			if (--p.lifetime[i] == 0) return EPTR_EXPIRED;
+			break;
+
+		default:
+			NOT_REACHED();
+	}
+
+	return moved ? EPTR_MOVED : EPTR_UNCHANGED;
+}
+
+/**
+ * Tick all effect particles.
+ */
+void TickEffectParticles()
+{
+	EffectParticles &p = _effect_particles;
+	for (size_t i = 0; i < p.Size();) {
+		switch (TickEffectParticle(i)) {
+			case EPTR_UNCHANGED:
+				i++;
+				break;
+
+			case EPTR_MOVED:
+				UpdateEffectParticleViewport(i, false);
+				i++;
+				break;
+
+			case EPTR_EXPIRED:
+				/* The last particle is moved to this index, and ticked next. */
+				MarkEffectParticleDirty(p.coord[i]);
+				p.Remove(i);
+				break;
+		}
+	}
+}
+
+/**
+ * Remove all effect particles, without marking the screen dirty.
+ */
+void ClearEffectParticles()
+{
+	_effect_particles.Clear();
+}
+
+/**
+ * Get the number of effect particles.
+ * @return The number of particles.
+ */
+size_t GetEffectParticleCount()
+{
+	return _effect_particles.Size();
+}
+
+/**
+ * Add the sprites of the effect particles that should be drawn at a part of the screen.
+ * @param dpi Rectangle being drawn.
+ */
+void ViewportAddEffectParticles(DrawPixelInfo *dpi)
+{
+	const EffectParticles &p = _effect_particles;
+	if (p.Size() == 0) return;
+
+	/* The bounding rectangle */
+	const int l = dpi->left;
+	const int r = dpi->left + dpi->width;
+	const int t = dpi->top;
+	const int b = dpi->top + dpi->height;
+
+	/* As for effect vehicles, transparent smoke looks weird, so hide it instead. */
+	std::array<bool, EV_END> hidden;
+	for (uint type = 0; type < EV_END; type++) {
+		TransparencyOption to = _effect_procs[type].transparency;
+		hidden[type] = (to != TO_INVALID && (IsTransparencySet(to) || IsInvisibilitySet(to)));
+	}
+
+	/* The hash area to scan: particles are hashed on their top left, so look further to the left and above. */
+	uint xl = EffectParticles::GetHashX(l - p.max_width);
+	uint xu = EffectParticles::GetHashX(r);
+	/* Compare after shifting instead of before, so that lower bits don't affect the comparison result. */
+	if (((r >> PARTICLE_HASHX_BUCKET_BITS) - ((l - p.max_width) >> PARTICLE_HASHX_BUCKET_BITS)) >= (1 << PARTICLE_HASHX_BITS)) {
+		/* Scan the whole row. */
+		xl = 0;
+		xu = (1 << PARTICLE_HASHX_BITS) - 1;
+	}
+	uint yl = EffectParticles::GetHashY(t - p.max_height);
+	uint yu = EffectParticles::GetHashY(b);
+	if (((b >> PARTICLE_HASHY_BUCKET_BITS) - ((t - p.max_height) >> PARTICLE_HASHY_BUCKET_BITS)) >= (1 << PARTICLE_HASHY_BITS)) {
+		/* Scan the whole column. */
+		yl = 0;
+		yu = ((1 << PARTICLE_HASHY_BITS) - 1) << PARTICLE_HASHX_BITS;
+	}
+
+	const uint x_mask = (1 << PARTICLE_HASHX_BITS) - 1;
+	const uint y_mask = x_mask << PARTICLE_HASHX_BITS;
+	for (uint y = yl;; y = (y + (1 << PARTICLE_HASHX_BITS)) & y_mask) {
+		for (uint x = xl;; x = (x + 1) & x_mask) {
+			for (uint32_t i : p.buckets[x + y]) {
+				const Rect &coord = p.coord[i];
+				if (l > coord.right || t > coord.bottom || r < coord.left || b < coord.top) continue;
+				if (hidden[p.type[i]]) continue;
+
+				/* Effect vehicles always face north, so are sorted as vehicles moving along the tile axes. */
+				AddSortableSpriteToDraw(p.sprite[i], PAL_NONE, p.x_pos[i], p.y_pos[i], 1, 1, 1, p.z_pos[i], false, 0, 0, 0, nullptr, VSSSF_SORT_SPECIAL | VSSSF_SORT_DIAG_VEH);
+			}
+
+			if (x == xu) break;
+		}
+
+		if (y == yu) break;
+	}
+}
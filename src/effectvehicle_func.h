@@ -12,6 +12,8 @@
 
 #include "vehicle_type.h"
 
+struct DrawPixelInfo;
+
 /** Effect vehicle types */
 enum EffectVehicleType : uint8_t {
 	EV_CHIMNEY_SMOKE            =  0, ///< Smoke of power plant (industry).
@@ -33,4 +35,13 @@ EffectVehicle *CreateEffectVehicle(int x, int y, int z, EffectVehicleType type);
 EffectVehicle *CreateEffectVehicleAbove(int x, int y, int z, EffectVehicleType type);
 EffectVehicle *CreateEffectVehicleRel(const Vehicle *v, int x, int y, int z, EffectVehicleType type);
 
+bool IsEffectParticleType(EffectVehicleType type);
+void CreateEffectParticle(int x, int y, int z, EffectVehicleType type, uint16_t lifetime = 0);
+void CreateEffectParticleAbove(int x, int y, int z, EffectVehicleType type);
+void CreateEffectParticleRel(const Vehicle *v, int x, int y, int z, EffectVehicleType type, uint16_t lifetime = 0);
+void TickEffectParticles();
+void ClearEffectParticles();
+size_t GetEffectParticleCount();
+void ViewportAddEffectParticles(DrawPixelInfo *dpi);
+
 #endif /* EFFECTVEHICLE_FUNC_H */
@@ -38,22 +38,69 @@ TrueTypeFontCache::~TrueTypeFontCache()
  */
 void TrueTypeFontCache::ClearFontCache()
 {
-	this->glyph_to_sprite_map.clear();
+	this->dense_glyphs.clear();
+	this->sparse_glyphs.clear();
+	this->atlas.Clear();
 	Layouter::ResetFontCache(this->fs);
 }
 
+/**
+ * Free all sprites in the atlas.
+ */
+void TrueTypeFontCache::GlyphAtlas::Clear()
+{
+	this->blocks.clear();
+	this->block_used = BLOCK_SIZE;
+}
+
+void *TrueTypeFontCache::GlyphAtlas::AllocatePtr(size_t size)
+{
+	/* Keep every sprite aligned as if it was allocated individually. */
+	size = Align(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+	if (size > BLOCK_SIZE / 4) {
+		/* Large glyphs get a block of their own, before the block which is being filled. */
+		auto it = this->blocks.insert(this->blocks.empty() ? this->blocks.end() : std::prev(this->blocks.end()), std::make_unique<uint8_t[]>(size));
+		return it->get();
+	}
+
+	if (this->block_used + size > BLOCK_SIZE) {
+		this->blocks.push_back(std::make_unique<uint8_t[]>(BLOCK_SIZE));
+		this->block_used = 0;
+	}
+
+	void *ptr = this->blocks.back().get() + this->block_used;
+	this->block_used += size;
+	return ptr;
+}
 
 TrueTypeFontCache::GlyphEntry *TrueTypeFontCache::GetGlyphPtr(GlyphID key)
 {
-	auto found = this->glyph_to_sprite_map.find(key);
-	if (found == std::end(this->glyph_to_sprite_map)) return nullptr;
+	if (key < DENSE_GLYPH_LIMIT) {
+		const size_t page = key / DENSE_GLYPH_PAGE_SIZE;
+		if (page >= this->dense_glyphs.size() || this->dense_glyphs[page] == nullptr) return nullptr;
+		return &(*this->dense_glyphs[page])[key % DENSE_GLYPH_PAGE_SIZE];
+	}
+
+	auto found = this->sparse_glyphs.find(key);
+	if (found == std::end(this->sparse_glyphs)) return nullptr;
 	return &found->second;
 }
 
 TrueTypeFontCache::GlyphEntry &TrueTypeFontCache::SetGlyphPtr(GlyphID key, GlyphEntry &&glyph)
 {
-	this->glyph_to_sprite_map[key] = std::move(glyph);
-	return this->glyph_to_sprite_map[key];
+	if (key < DENSE_GLYPH_LIMIT) {
+		const size_t page = key / DENSE_GLYPH_PAGE_SIZE;
+		if (page >= this->dense_glyphs.size()) this->dense_glyphs.resize(page + 1);
+		if (this->dense_glyphs[page] == nullptr) this->dense_glyphs[page] = std::make_unique<DenseGlyphPage>();
+		GlyphEntry &entry = (*this->dense_glyphs[page])[key % DENSE_GLYPH_PAGE_SIZE];
+		entry = std::move(glyph);
+		return entry;
+	}
+
+	GlyphEntry &entry = this->sparse_glyphs[key];
+	entry = std::move(glyph);
+	return entry;
 }
 
 bool TrueTypeFontCache::GetDrawGlyphShadow()
@@ -66,7 +113,7 @@ uint TrueTypeFontCache::GetGlyphWidth(GlyphID key)
 	if ((key & SPRITE_GLYPH) != 0) return this->parent->GetGlyphWidth(key);
 
 	GlyphEntry *glyph = this->GetGlyphPtr(key);
-	if (glyph == nullptr || glyph->data == nullptr) {
+	if (glyph == nullptr || glyph->sprite == nullptr) {
 		this->GetGlyph(key);
 		glyph = this->GetGlyphPtr(key);
 	}
@@ -80,7 +127,7 @@ const Sprite *TrueTypeFontCache::GetGlyph(GlyphID key)
 
 	/* Check for the glyph in our cache */
 	GlyphEntry *glyph = this->GetGlyphPtr(key);
-	if (glyph != nullptr && glyph->data != nullptr) return glyph->GetSprite();
+	if (glyph != nullptr && glyph->sprite != nullptr) return glyph->GetSprite();
 
 	return this->InternalGetGlyph(key, GetFontAAState());
 }
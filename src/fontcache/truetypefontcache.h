@@ -11,8 +11,13 @@
 #define TRUETYPEFONTCACHE_H
 
 #include "../fontcache.h"
+#include "../spriteloader/spriteloader.hpp"
 #include "../3rdparty/robin_hood/robin_hood.h"
 
+#include <array>
+#include <memory>
+#include <vector>
+
 
 static const int MAX_FONT_SIZE = 72; ///< Maximum font size.
 
@@ -30,13 +35,36 @@ protected:
 
 	/** Container for information about a glyph. */
 	struct GlyphEntry {
-		std::unique_ptr<uint8_t[]> data; ///< The loaded sprite.
+		Sprite *sprite = nullptr; ///< The loaded sprite, stored in the glyph atlas.
 		uint8_t width = 0; ///< The width of the glyph.
 
-		Sprite *GetSprite() { return reinterpret_cast<Sprite *>(data.get()); }
+		Sprite *GetSprite() { return this->sprite; }
 	};
 
-	robin_hood::unordered_map<GlyphID, GlyphEntry> glyph_to_sprite_map{};
+	/**
+	 * Storage for the sprites of the glyphs of a font.
+	 * The sprites are packed into large blocks instead of being allocated individually, and are only freed together.
+	 */
+	class GlyphAtlas : public SpriteAllocator {
+		static constexpr size_t BLOCK_SIZE = 64 * 1024; ///< Size of a block of sprites.
+
+		std::vector<std::unique_ptr<uint8_t[]>> blocks; ///< All allocated blocks, the last one is being filled.
+		size_t block_used = BLOCK_SIZE; ///< Number of bytes used in the last block.
+
+	public:
+		void Clear();
+
+	protected:
+		void *AllocatePtr(size_t size) override;
+	};
+
+	static constexpr GlyphID DENSE_GLYPH_PAGE_SIZE = 256;  ///< Number of glyphs in a page of the dense glyph index.
+	static constexpr GlyphID DENSE_GLYPH_LIMIT = 0x10000; ///< Glyphs below this ID are in the dense glyph index.
+	using DenseGlyphPage = std::array<GlyphEntry, DENSE_GLYPH_PAGE_SIZE>;
+
+	std::vector<std::unique_ptr<DenseGlyphPage>> dense_glyphs{}; ///< Pages of glyphs with a low ID, which covers the glyphs of the common Unicode ranges in most fonts.
+	robin_hood::unordered_map<GlyphID, GlyphEntry> sparse_glyphs{}; ///< Glyphs with a high ID.
+	GlyphAtlas atlas; ///< Storage of the sprites of all glyphs.
 
 	GlyphEntry *GetGlyphPtr(GlyphID key);
 	GlyphEntry &SetGlyphPtr(GlyphID key, GlyphEntry &&glyph);
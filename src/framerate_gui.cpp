@@ -10,6 +10,7 @@
 #include "framerate_type.h"
 #include <chrono>
 #include "gfx_func.h"
+#include "gfx_layout.h"
 #include "newgrf_sound.h"
 #include "window_gui.h"
 #include "window_func.h"
@@ -910,6 +911,7 @@ static constexpr NWidgetPart _framerate_window_widgets[] = {
 			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_RATE_GAMELOOP), SetStringTip(STR_FRAMERATE_RATE_GAMELOOP, STR_FRAMERATE_RATE_GAMELOOP_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
 			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_RATE_DRAWING),  SetStringTip(STR_FRAMERATE_RATE_BLITTER,  STR_FRAMERATE_RATE_BLITTER_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
 			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_RATE_FACTOR),   SetStringTip(STR_FRAMERATE_SPEED_FACTOR,  STR_FRAMERATE_SPEED_FACTOR_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
+			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_TEXT_LAYOUT_CACHE), SetStringTip(STR_FRAMERATE_TEXT_LAYOUT_CACHE, STR_FRAMERATE_TEXT_LAYOUT_CACHE_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
 		EndContainer(),
 	EndContainer(),
 	NWidget(NWID_HORIZONTAL),
@@ -969,6 +971,7 @@ struct FramerateWindow : Window {
 	CachedDecimal speed_gameloop;           ///< cached game loop speed factor
 	CachedDecimal times_shortterm[PFE_MAX]; ///< cached short term average times
 	CachedDecimal times_longterm[PFE_MAX];  ///< cached long term average times
+	Layouter::LineCacheStats line_cache{};  ///< cached text layout cache statistics
 
 	static constexpr int MIN_ELEMENTS = 5;      ///< smallest number of elements to display
 
@@ -1011,6 +1014,7 @@ struct FramerateWindow : Window {
 		if (this->small) return; // in small mode, this is everything needed
 
 		this->rate_drawing.SetRate(_pf_data[PFE_DRAWING].GetRate(), _settings_client.gui.refresh_rate);
+		this->line_cache = Layouter::GetLineCacheStats();
 
 		int new_active = 0;
 		for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
@@ -1051,6 +1055,15 @@ struct FramerateWindow : Window {
 			case WID_FRW_RATE_FACTOR:
 				this->speed_gameloop.InsertDParams(0);
 				break;
+			case WID_FRW_TEXT_LAYOUT_CACHE: {
+				const uint64_t lookups = this->line_cache.hits + this->line_cache.misses;
+				SetDParam(0, lookups > 0 ? (this->line_cache.hits * 10000) / lookups : 0);
+				SetDParam(1, 2);
+				SetDParam(2, this->line_cache.items);
+				SetDParam(3, this->line_cache.bytes);
+				SetDParam(4, this->line_cache.evictions);
+				break;
+			}
 			case WID_FRW_INFO_DATA_POINTS:
 				SetDParam(0, NUM_FRAMERATE_POINTS);
 				break;
@@ -1077,6 +1090,14 @@ struct FramerateWindow : Window {
 				SetDParam(1, 2);
 				size = GetStringBoundingBox(STR_FRAMERATE_SPEED_FACTOR);
 				break;
+			case WID_FRW_TEXT_LAYOUT_CACHE:
+				SetDParamMaxDigits(0, 5);
+				SetDParam(1, 2);
+				SetDParamMaxDigits(2, 6);
+				SetDParamMaxDigits(3, 7);
+				SetDParamMaxDigits(4, 8);
+				size = GetStringBoundingBox(STR_FRAMERATE_TEXT_LAYOUT_CACHE);
+				break;
 
 			case WID_FRW_TIMES_NAMES: {
 				size.width = 0;
@@ -1643,3 +1664,51 @@ void ProcessPendingPerformanceMeasurements()
 		_sound_perf_pending.store(false, std::memory_order_relaxed);
 	}
 }
+
+/**
+ * Get a summary of the recorded measurements of a performance element.
+ * @param elem The element to summarise.
+ * @param[out] summary The summary to fill.
+ * @return True if there were any valid measurements to summarise.
+ */
+bool GetPerformanceSummary(PerformanceElement elem, PerformanceSummary &summary)
+{
+	assert(elem < PFE_MAX);
+
+	summary = {};
+
+	PerformanceData &pf = _pf_data[elem];
+	if (pf.num_valid == 0) return false;
+
+	const int count = std::min(pf.num_valid, NUM_FRAMERATE_POINTS);
+	const int recent_count = std::min(count, NUM_FRAMERATE_POINTS / 8);
+	int first_point = pf.prev_index - count + 1;
+	if (first_point < 0) first_point += NUM_FRAMERATE_POINTS;
+
+	TimingMeasurement sum_all = 0;
+	TimingMeasurement sum_recent = 0;
+	uint num_recent = 0;
+	for (int i = 0; i < count; i++) {
+		TimingMeasurement d = pf.durations[(first_point + i) % NUM_FRAMERATE_POINTS];
+		if (d == PerformanceData::INVALID_DURATION) continue;
+
+		summary.num_valid++;
+		sum_all += d;
+		if (i >= count - recent_count) {
+			sum_recent += d;
+			num_recent++;
+		}
+		summary.max = std::max(summary.max, d);
+
+		auto bucket = std::upper_bound(PerformanceSummary::HISTOGRAM_LIMITS.begin(), PerformanceSummary::HISTOGRAM_LIMITS.end(), d);
+		summary.histogram[bucket - PerformanceSummary::HISTOGRAM_LIMITS.begin()]++;
+	}
+	if (summary.num_valid == 0) return false;
+
+	static_assert(TIMESTAMP_PRECISION == 1000000);
+	summary.avg_all = sum_all / summary.num_valid;
+	summary.avg_recent = num_recent > 0 ? sum_recent / num_recent : 0;
+	summary.rate = pf.GetRate();
+	summary.expected_rate = pf.expected_rate;
+	return true;
+}
@@ -37,6 +37,7 @@
 
 #include "stdafx.h"
 #include "core/enum_type.hpp"
+#include <array>
 
 /**
  * Elements of game performance that can be measured.
@@ -606,7 +607,26 @@ public:
 	static void Reset(PerformanceElement elem);
 };
 
+/**
+ * Summary of the recorded measurements of a performance element, for reporting outside of the GUI (e.g. to the admin network).
+ * All durations are in microseconds.
+ */
+struct PerformanceSummary {
+	/** Upper limits (exclusive) of the duration histogram buckets, the last bucket holds all longer durations. */
+	static constexpr std::array<TimingMeasurement, 11> HISTOGRAM_LIMITS = { 250, 500, 1000, 2000, 5000, 10000, 20000, 30000, 50000, 100000, 250000 };
+	static constexpr size_t HISTOGRAM_BUCKETS = HISTOGRAM_LIMITS.size() + 1; ///< Number of buckets in the duration histogram.
+
+	uint num_valid = 0;                                  ///< Number of valid data points the summary is based on.
+	double rate = 0;                                     ///< Current rate of cycles per second.
+	double expected_rate = 0;                            ///< Expected rate of cycles per second.
+	TimingMeasurement avg_recent = 0;                    ///< Average duration over the most recent data points.
+	TimingMeasurement avg_all = 0;                       ///< Average duration over all data points.
+	TimingMeasurement max = 0;                           ///< Maximum duration over all data points.
+	std::array<uint16_t, HISTOGRAM_BUCKETS> histogram{}; ///< Number of data points for each histogram bucket.
+};
+
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
+bool GetPerformanceSummary(PerformanceElement elem, PerformanceSummary &summary);
 
 #endif /* FRAMERATE_TYPE_H */
@@ -14,6 +14,7 @@
 #include "../network/network.h"
 #include "../window_func.h"
 #include "../framerate_type.h"
+#include "../zone_profiler.h"
 #include "game.hpp"
 #include "game_scanner.hpp"
 #include "game_config.hpp"
@@ -40,6 +41,7 @@
 	}
 
 	PerformanceMeasurer framerate(PFE_GAMESCRIPT);
+	ZoneProfilerScope zone(ZPZ_SCRIPT_GS);
 
 	Game::frame_counter++;
 
@@ -512,6 +512,47 @@ void GfxBlitterCtx::SetColourRemap(TextColour colour)
 	this->colour_remap_ptr = this->string_colourremap;
 }
 
+/**
+ * Prepare the blitting parameters of a glyph of a line of text.
+ * This is #GfxBlitter for sprites at the normal zoom level without a sub sprite, so the clipping is simpler.
+ * @param ctx The blitter context, with the colour remap of the run already set.
+ * @param sprite The sprite of the glyph.
+ * @param x The X position of the glyph.
+ * @param y The Y position of the glyph.
+ * @param[out] bp The blitting parameters.
+ * @return False when nothing of the glyph is visible.
+ */
+static bool PrepareGlyphBlit(const GfxBlitterCtx &ctx, const Sprite *sprite, int x, int y, Blitter::BlitterParams &bp)
+{
+	const DrawPixelInfo *dpi = ctx.dpi;
+
+	if (sprite->width <= 0 || sprite->height <= 0) return false;
+	while (HasBit(sprite->missing_zoom_levels, ZOOM_LVL_MIN)) {
+		sprite = sprite->next;
+		if (sprite == nullptr) return false;
+	}
+
+	x += sprite->x_offs - dpi->left;
+	y += sprite->y_offs - dpi->top;
+
+	bp.skip_left = std::max(0, -x);
+	bp.skip_top = std::max(0, -y);
+	bp.left = std::max(0, x);
+	bp.top = std::max(0, y);
+	bp.width = std::min<int>(sprite->width - bp.skip_left, dpi->width - bp.left);
+	bp.height = std::min<int>(sprite->height - bp.skip_top, dpi->height - bp.top);
+	if (bp.width <= 0 || bp.height <= 0) return false;
+
+	bp.sprite = sprite->data;
+	bp.sprite_width = sprite->width;
+	bp.sprite_height = sprite->height;
+	bp.dst = dpi->dst_ptr;
+	bp.pitch = dpi->pitch;
+	bp.remap = ctx.colour_remap_ptr;
+	bp.brightness_adjust = ctx.sprite_brightness_adjust;
+	return true;
+}
+
 /**
  * Drawing routine for drawing a laid out line of text.
  * @param line      String to draw.
@@ -610,6 +651,8 @@ static int DrawLayoutLine(const ParagraphLayouter::Line &line, int y, int left,
 	}
 
 	GfxBlitterCtx ctx(_cur_dpi);
+	Blitter *blitter = BlitterFactory::GetCurrentBlitter();
+	ankerl::svector<Blitter::BlitterParams, 32> glyph_blits;
 
 	const uint shadow_offset = ScaleGUITrad(1);
 
@@ -633,6 +676,8 @@ static int DrawLayoutLine(const ParagraphLayouter::Line &line, int y, int left,
 			int dpi_left  = dpi->left;
 			int dpi_right = dpi->left + dpi->width - 1;
 
+			/* The glyphs of a run share the colour remap, so they are clipped here and blitted together. */
+			glyph_blits.clear();
 			for (int i = 0; i < run.GetGlyphCount(); i++) {
 				GlyphID glyph = glyphs[i];
 
@@ -652,8 +697,10 @@ static int DrawLayoutLine(const ParagraphLayouter::Line &line, int y, int left,
 
 				if (do_shadow && (glyph & SPRITE_GLYPH) != 0) continue;
 
-				GfxMainBlitter(ctx, sprite, begin_x + (do_shadow ? shadow_offset : 0), top + (do_shadow ? shadow_offset : 0), BlitterMode::ColourRemap);
+				Blitter::BlitterParams &bp = glyph_blits.emplace_back();
+				if (!PrepareGlyphBlit(ctx, sprite, begin_x + (do_shadow ? shadow_offset : 0), top + (do_shadow ? shadow_offset : 0), bp)) glyph_blits.pop_back();
 			}
+			if (!glyph_blits.empty()) blitter->DrawGlyphRun(glyph_blits, BlitterMode::ColourRemap);
 		}
 
 		if (truncation && (!do_shadow || (dot_has_shadow && colour_has_shadow))) {
@@ -33,7 +33,7 @@
 #include "safeguards.h"
 
 
-/** Cache of ParagraphLayout lines. */
+/** Cache of ParagraphLayout lines, shared by all Layouters which lay out the same line with the same font state. */
 Layouter::LineCache *Layouter::linecache;
 
 /** Cache of Font instances. */
@@ -369,6 +369,23 @@ void Layouter::ResetFontCache(FontSize size)
 #endif
 }
 
+/** Estimated memory the linecache may use before the least recently used lines are evicted. */
+static const size_t LINE_CACHE_BUDGET = 4 << 20;
+/** Maximum number of lines in the linecache, this bounds the memory used by the runs, glyphs and positions of the layouts, which the budget does not count. */
+static const size_t LINE_CACHE_MAX_ITEMS = 4096;
+
+/**
+ * Estimate the memory used by a line in the linecache.
+ * This includes the key, the buffer of the layout and the bookkeeping of the cache, but not the internals of the layout.
+ * @param str Source string of the line.
+ * @return Estimated size in bytes.
+ */
+static size_t EstimateLineCacheEntrySize(std::string_view str)
+{
+	/* The buffer of a layout uses at most one character of the largest character type per byte of the source string. */
+	return 128 + str.size() + (str.size() + 1) * sizeof(char32_t);
+}
+
 /**
  * Get reference to cache item.
  * If the item does not exist yet, it is default constructed.
@@ -383,16 +400,25 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str
 		linecache = new LineCache();
 	}
 
-	if (auto match = linecache->find(LineCacheQuery{state, str});
-		match != linecache->end()) {
-		return match->second;
+	if (auto match = linecache->lookup.find(LineCacheQuery{state, str});
+		match != linecache->lookup.end()) {
+		/* Move to front, as most recently used. */
+		linecache->entries.splice(linecache->entries.begin(), linecache->entries, match->second);
+		linecache->stats.hits++;
+		return match->second->item;
 	}
 
 	/* Create missing entry */
-	LineCacheKey key;
-	key.state_before = state;
-	key.str.assign(str);
-	return (*linecache)[std::move(key)];
+	LineCache::Entry &entry = linecache->entries.emplace_front();
+	entry.key.state_before = state;
+	entry.key.str.assign(str);
+	entry.bytes = EstimateLineCacheEntrySize(str);
+	linecache->lookup.emplace(LineCacheQuery{entry.key.state_before, entry.key.str}, linecache->entries.begin());
+
+	linecache->stats.misses++;
+	linecache->stats.items++;
+	linecache->stats.bytes += entry.bytes;
+	return entry.item;
 }
 
 /**
@@ -400,20 +426,43 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str
  */
 void Layouter::ResetLineCache()
 {
-	if (linecache != nullptr) linecache->clear();
+	if (linecache != nullptr) {
+		/* The lookup refers to the keys of the entries, so clear it first. */
+		linecache->lookup.clear();
+		linecache->entries.clear();
+		linecache->stats.items = 0;
+		linecache->stats.bytes = 0;
+	}
 }
 
 /**
  * Reduce the size of linecache if necessary to prevent infinite growth.
+ * The least recently used lines are evicted until the cache is within its memory budget and its maximum number of lines.
  */
 void Layouter::ReduceLineCache()
 {
-	if (linecache != nullptr) {
-		/* TODO LRU cache would be fancy, but not exactly necessary */
-		if (linecache->size() > 4096) ResetLineCache();
+	if (linecache == nullptr) return;
+
+	while (linecache->stats.bytes > LINE_CACHE_BUDGET || linecache->stats.items > LINE_CACHE_MAX_ITEMS) {
+		LineCache::Entry &entry = linecache->entries.back();
+		linecache->lookup.erase(LineCacheQuery{entry.key.state_before, entry.key.str});
+		linecache->stats.bytes -= entry.bytes;
+		linecache->stats.items--;
+		linecache->stats.evictions++;
+		linecache->entries.pop_back();
 	}
 }
 
+/**
+ * Get the statistics of the line cache.
+ * @return The statistics.
+ */
+Layouter::LineCacheStats Layouter::GetLineCacheStats()
+{
+	if (linecache == nullptr) return {};
+	return linecache->stats;
+}
+
 /**
  * Get the leading corner of a character in a single-line string relative
  * to the start of the string.
@@ -17,11 +17,13 @@
 #include "3rdparty/cpp-btree/btree_map.h"
 #include "3rdparty/svector/svector.h"
 
+#include <list>
 #include <map>
 #include <string>
 #include <stack>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -151,23 +153,29 @@ class Layouter : public std::vector<std::unique_ptr<const ParagraphLayouter::Lin
 		std::string str;         ///< Source string of the line (including colour and font size codes).
 	};
 
+	/** Lookup into the linecache, referring either to the key of a cached line or to a line being looked up. */
 	struct LineCacheQuery {
 		const FontState &state_before; ///< Font state at the beginning of the line.
 		std::string_view str;    ///< Source string of the line (including colour and font size codes).
 	};
 
-	/** Comparator for std::map */
-	struct LineCacheCompare {
-		using is_transparent = void; ///< Enable map queries with various key types
+	/** Hash of LineCacheQuery for std::unordered_map */
+	struct LineCacheHash {
+		size_t operator()(const LineCacheQuery &query) const
+		{
+			uint64_t state = query.state_before.fontsize | (static_cast<uint64_t>(query.state_before.cur_colour) << 8) | (static_cast<uint64_t>(query.state_before.colour_stack.size()) << 32);
+			return std::hash<std::string_view>{}(query.str) ^ static_cast<size_t>(state * 0x9E3779B97F4A7C15ULL);
+		}
+	};
 
-		/** Comparison operator for LineCacheKey and LineCacheQuery */
-		template <typename Key1, typename Key2>
-		bool operator()(const Key1 &lhs, const Key2 &rhs) const
+	/** Equality of LineCacheQuery for std::unordered_map */
+	struct LineCacheEqual {
+		bool operator()(const LineCacheQuery &lhs, const LineCacheQuery &rhs) const
 		{
-			if (lhs.state_before.fontsize != rhs.state_before.fontsize) return lhs.state_before.fontsize < rhs.state_before.fontsize;
-			if (lhs.state_before.cur_colour != rhs.state_before.cur_colour) return lhs.state_before.cur_colour < rhs.state_before.cur_colour;
-			if (lhs.state_before.colour_stack != rhs.state_before.colour_stack) return lhs.state_before.colour_stack < rhs.state_before.colour_stack;
-			return lhs.str < rhs.str;
+			return lhs.state_before.fontsize == rhs.state_before.fontsize &&
+					lhs.state_before.cur_colour == rhs.state_before.cur_colour &&
+					lhs.state_before.colour_stack == rhs.state_before.colour_stack &&
+					lhs.str == rhs.str;
 		}
 	};
 public:
@@ -183,8 +191,32 @@ public:
 		LineCacheItem() : buffer(nullptr) {}
 		~LineCacheItem() { free(buffer); }
 	};
+
+	/** Statistics of the linecache. */
+	struct LineCacheStats {
+		uint64_t hits;      ///< Number of lines which were found in the cache.
+		uint64_t misses;    ///< Number of lines which had to be laid out.
+		uint64_t evictions; ///< Number of lines which were evicted to stay within the memory budget and the maximum number of lines.
+		size_t items;       ///< Number of lines in the cache.
+		size_t bytes;       ///< Estimated memory used by the lines in the cache.
+	};
 private:
-	typedef std::map<LineCacheKey, LineCacheItem, LineCacheCompare> LineCache;
+	/**
+	 * Cache of laid out lines, with a least recently used eviction strategy and limits on the memory used and the number of lines.
+	 * Lines are only evicted by ReduceLineCache, so the lines of a Layouter stay valid while it exists.
+	 */
+	struct LineCache {
+		/** Cached line together with its key. */
+		struct Entry {
+			LineCacheKey key;   ///< Key of the line, referred to by the lookup.
+			LineCacheItem item; ///< The laid out line.
+			size_t bytes;       ///< Estimated memory used by the entry.
+		};
+
+		std::list<Entry> entries; ///< All entries, most recently used first.
+		std::unordered_map<LineCacheQuery, std::list<Entry>::iterator, LineCacheHash, LineCacheEqual> lookup; ///< Map of the keys of the entries to the entries.
+		LineCacheStats stats{};   ///< Statistics of the cache.
+	};
 	static LineCache *linecache;
 
 	static LineCacheItem &GetCachedParagraphLayout(std::string_view str, const FontState &state);
@@ -203,6 +235,7 @@ public:
 	static void ResetFontCache(FontSize size);
 	static void ResetLineCache();
 	static void ReduceLineCache();
+	static LineCacheStats GetLineCacheStats();
 };
 
 ParagraphLayouter::Position GetCharPosInString(std::string_view str, const char *ch, FontSize start_fontsize = FS_NORMAL);
@@ -497,6 +497,8 @@ CommandCost CmdDeleteGroup(DoCommandFlag flags, GroupID group_id)
 		CloseWindowById(WC_REPLACE_VEHICLE, g->vehicle_type);
 		delete g;
 
+		/* The ID of the group may be reused by a group with another name. */
+		InvalidateFormattedStringCache();
 		InvalidateWindowData(GetWindowClassForVehicleType(vt), VehicleListIdentifier(VL_GROUP_LIST, vt, _current_company).ToWindowNumber());
 		InvalidateWindowData(WC_COMPANY_COLOUR, _current_company, vt);
 		InvalidateWindowData(WC_TEMPLATEGUI_MAIN, 0, 0, 0);
@@ -567,6 +569,8 @@ CommandCost CmdAlterGroup(DoCommandFlag flags, AlterGroupMode mode, GroupID grou
 	}
 
 	if (flags & DC_EXEC) {
+		/* Both the name and the parent of a group are part of its (hierarchical) name. */
+		InvalidateFormattedStringCache();
 		InvalidateWindowData(WC_REPLACE_VEHICLE, g->vehicle_type, 1);
 		InvalidateWindowData(GetWindowClassForVehicleType(g->vehicle_type), VehicleListIdentifier(VL_GROUP_LIST, g->vehicle_type, _current_company).ToWindowNumber());
 		InvalidateWindowData(WC_COMPANY_COLOUR, g->owner, g->vehicle_type);
@@ -34,12 +34,15 @@
 #include "pathfinder/aystar.h"
 #include "sl/saveload.h"
 #include "framerate_type.h"
+#include "zone_profiler.h"
 #include "town.h"
 #include "3rdparty/cpp-btree/btree_set.h"
 #include "scope_info.h"
 #include "core/ring_buffer.hpp"
 #include "network/network_sync.h"
+#include "core/format.hpp"
 #include <array>
+#include <chrono>
 #include <list>
 #include <set>
 
@@ -743,6 +746,7 @@ void RunTileLoop(bool apply_day_length)
 	}
 
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	ZoneProfilerScope zone(ZPZ_TILE_LOOP);
 
 	const uint32_t feedback = GetTileLoopFeedback();
 
@@ -763,6 +767,7 @@ void RunTileLoop(bool apply_day_length)
 		TileIndex next = TileIndex((tile.base() >> 1) ^ (-(int32_t)(tile.base() & 1) & feedback));
 		if (count > 0) {
 			PREFETCH_NTA(&_m[next]);
+			if constexpr (!MAP_INTERLEAVED) PREFETCH_NTA(&_me[next]);
 		}
 
 		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
@@ -804,6 +809,69 @@ void RunAuxiliaryTileLoop()
 	RecordSyncEvent(NSRE_AUX_TILE);
 }
 
+/**
+ * Time read-only walks over the map, which access the tiles like the tile loop, the drawing of the landscape in a viewport
+ * and the following of tracks by the pathfinders do. This is to compare the layouts of the map, see #MAP_INTERLEAVED.
+ * @param buffer The buffer to write the results to.
+ * @param passes The number of times to repeat each walk.
+ */
+void BenchmarkMapLayout(format_target &buffer, uint passes)
+{
+	buffer.format("Map layout: {}, map size: {} x {}, passes: {}\n", MAP_INTERLEAVED ? "interleaved" : "separate", Map::SizeX(), Map::SizeY(), passes);
+
+	uint64_t checksum = 0;
+	auto time_walk = [&](std::string_view name, auto walk) {
+		const auto start = std::chrono::steady_clock::now();
+		for (uint i = 0; i < passes; i++) walk();
+		const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		buffer.format("  {}: {} us per pass\n", name, duration.count() / std::max<uint>(passes, 1));
+	};
+
+	const uint32_t feedback = GetTileLoopFeedback();
+
+	/* Every tile in the order of the tile loop, reading both parts of the data of each tile, as determining the owner of a tile does. */
+	time_walk("tile loop", [&]() {
+		TileIndex tile{1};
+		for (uint count = Map::Size() - 1; count > 0; count--) {
+			TileIndex next = TileIndex((tile.base() >> 1) ^ (-(int32_t)(tile.base() & 1) & feedback));
+			PREFETCH_NTA(&_m[next]);
+			if constexpr (!MAP_INTERLEAVED) PREFETCH_NTA(&_me[next]);
+			checksum += GetTileType(tile) + _m[tile].m1 + _me[tile].m9;
+			tile = next;
+		}
+	});
+
+	/* Rows of tiles in the order they are drawn in a viewport, reading the slope and the NewGRF data of each tile. */
+	time_walk("viewport landscape", [&]() {
+		for (uint row = 0; row < Map::MaxX() + Map::MaxY(); row++) {
+			for (uint x = (row > Map::MaxY() - 1) ? row - (Map::MaxY() - 1) : 0; x < Map::MaxX() && x <= row; x++) {
+				const TileIndex tile = TileXY(x, row - x);
+				auto [slope, z] = GetTileSlopeZ(tile);
+				checksum += slope + z + GetTileType(tile) + _me[tile].m7;
+			}
+		}
+	});
+
+	/* Track status of every tile in the order of the tile loop, and of the neighbours of each tile with tracks. */
+	time_walk("follow track", [&]() {
+		TileIndex tile{1};
+		for (uint count = Map::Size() - 1; count > 0; count--) {
+			const TrackStatus ts = GetTileTrackStatus(tile, TRANSPORT_RAIL, 0);
+			checksum += ts;
+			if (ts != 0) {
+				for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+					const TileIndexDiffC diff = TileIndexDiffCByDiagDir(dir);
+					const TileIndex neighbour = TileAddWrap(tile, diff.x, diff.y);
+					if (neighbour != INVALID_TILE) checksum += GetTileTrackStatus(neighbour, TRANSPORT_RAIL, 0, ReverseDiagDir(dir));
+				}
+			}
+			tile = TileIndex((tile.base() >> 1) ^ (-(int32_t)(tile.base() & 1) & feedback));
+		}
+	});
+
+	buffer.format("  checksum: {:X}\n", checksum);
+}
+
 void InitializeLandscape()
 {
 	for (uint y = _settings_game.construction.freeform_edges ? 1 : 0; y < Map::MaxY(); y++) {
@@ -1204,8 +1272,6 @@ static void River_FoundEndNode(AyStar *aystar, OpenListNode *current)
 	}
 }
 
-static const uint RIVER_HASH_SIZE = 8; ///< The number of bits the hash for river finding should have.
-
 /**
  * Actually build the river between the begin and end tiles using AyStar.
  * @param begin The begin of the river.
@@ -1222,7 +1288,7 @@ static void BuildRiver(TileIndex begin, TileIndex end)
 	finder.user_target = &end;
 	finder.max_search_nodes = 100 * AYSTAR_DEF_MAX_SEARCH_NODES;
 
-	finder.Init(1 << RIVER_HASH_SIZE);
+	finder.Init();
 
 	AyStarNode start;
 	start.tile = begin;
@@ -167,6 +167,7 @@ void DoClearSquare(TileIndex tile);
 void SetupTileLoopCounts();
 void RunTileLoop(bool apply_day_length = false);
 void RunAuxiliaryTileLoop();
+void BenchmarkMapLayout(struct format_target &buffer, uint passes);
 
 void InitializeLandscape();
 bool GenerateLandscape(uint8_t mode);
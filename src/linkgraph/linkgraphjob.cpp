@@ -174,15 +174,12 @@ void LinkGraphJob::FinaliseJob()
 					}
 				}
 			} else {
+				/* The new flow now holds the old shares, it is skipped when merging below. */
 				it->SwapShares(*new_it);
-				flows.erase(new_it);
 				++it;
 			}
 		}
-		for (FlowStatMap::iterator it(flows.begin()); it != flows.end(); ++it) {
-			geflows.insert(std::move(*it));
-		}
-		geflows.SortStorage();
+		geflows.MergeFlows(std::move(flows));
 		ge.RemoveDataIfUnused();
 		InvalidateWindowData(WC_STATION_VIEW, st->index, this->Cargo());
 	}
@@ -14,6 +14,7 @@
 #include "mcf.h"
 #include "flowmapper.h"
 #include "../framerate_type.h"
+#include "../zone_profiler.h"
 #include "../command_func.h"
 #include "../misc_cmd.h"
 #include "../network/network.h"
@@ -126,6 +127,24 @@ bool LinkGraphSchedule::IsJoinWithUnfinishedJobDue() const
 	return false;
 }
 
+/**
+ * Get statistics about the state of the schedule.
+ * @return The statistics.
+ */
+LinkGraphSchedule::Statistics LinkGraphSchedule::GetStatistics() const
+{
+	Statistics stats;
+	stats.scheduled = static_cast<uint>(this->schedule.size());
+	stats.running = static_cast<uint>(this->running.size());
+	for (const auto &job : this->running) {
+		if (_scaled_tick_counter > job->StartTick()) stats.max_age = std::max<ScaledTickCounter>(stats.max_age, _scaled_tick_counter - job->StartTick());
+		if (!job->IsJobCompleted() && _scaled_tick_counter > job->JoinTick()) {
+			stats.max_overdue = std::max<ScaledTickCounter>(stats.max_overdue, _scaled_tick_counter - job->JoinTick());
+		}
+	}
+	return stats;
+}
+
 /**
  * Join the next finished job, if available.
  */
@@ -153,6 +172,7 @@ void LinkGraphSchedule::JoinNext()
  */
 /* static */ void LinkGraphSchedule::Run(LinkGraphJob *job)
 {
+	ZoneProfilerScope zone(ZPZ_LINK_GRAPH_JOB, job->index);
 	for (const auto &handler : instance.handlers) {
 		if (job->IsJobAborted()) return;
 		handler->Run(*job);
@@ -63,8 +63,17 @@ public:
 	static void Run(LinkGraphJob *job);
 	static void Clear();
 
+	/** Statistics about the state of the schedule, for monitoring. */
+	struct Statistics {
+		uint scheduled = 0;                ///< Number of link graphs queued for a new job.
+		uint running = 0;                  ///< Number of currently running jobs.
+		ScaledTickCounter max_overdue = 0; ///< Maximum number of ticks an unfinished job is past its join tick.
+		ScaledTickCounter max_age = 0;     ///< Number of ticks since the oldest running job was started.
+	};
+
 	void SpawnNext();
 	bool IsJoinWithUnfinishedJobDue() const;
+	Statistics GetStatistics() const;
 	void JoinNext();
 	void SpawnAll();
 	void ShiftDates(EconTime::DateDelta interval);
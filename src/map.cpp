@@ -16,6 +16,8 @@
 #include "rail_map.h"
 #include "tunnelbridge_map.h"
 #include "pathfinder/water_regions.h"
+#include "pathfinder/road_regions.h"
+#include "road_func.h"
 #include "core/ring_buffer.hpp"
 #include "3rdparty/cpp-btree/btree_map.h"
 #include "3rdparty/robin_hood/robin_hood.h"
@@ -97,7 +99,11 @@ void AllocateMap(uint size_x, uint size_y)
 
 	free(_m.tile_data);
 
+#ifdef INTERLEAVED_MAP
+	const size_t total_size = sizeof(InterleavedTile) * _map_size;
+#else
 	const size_t total_size = (sizeof(Tile) + sizeof(TileExtended)) * _map_size;
+#endif
 
 	uint8_t *buf = nullptr;
 #if defined(__linux__) && defined(MADV_HUGEPAGE)
@@ -134,9 +140,15 @@ void AllocateMap(uint size_x, uint size_y)
 	if (buf == nullptr) buf = CallocT<uint8_t>(total_size);
 
 	_m.tile_data = reinterpret_cast<Tile *>(buf);
+#ifdef INTERLEAVED_MAP
+	_me.tile_data = reinterpret_cast<TileExtended *>(buf + offsetof(InterleavedTile, me));
+#else
 	_me.tile_data = reinterpret_cast<TileExtended *>(buf + (_map_size * sizeof(Tile)));
+#endif
 
 	InitializeWaterRegions();
+	InitializeRoadRegions();
+	InitializeRoadLayoutRegions();
 }
 
 
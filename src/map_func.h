@@ -146,16 +146,79 @@ struct Map {
 	}
 };
 
+#ifdef INTERLEAVED_MAP
+/**
+ * Data of a tile when the map is interleaved.
+ * Both parts of the data of a tile are stored together, so accessing both of them takes one cache miss instead of two.
+ */
+struct InterleavedTile {
+	Tile m;            ///< Tile data.
+	TileExtended me;   ///< Extended tile data.
+	uint16_t padding;  ///< Padding, so no tile straddles a cache line.
+};
+
+static_assert(sizeof(InterleavedTile) == 16);
+
+/** Whether both parts of the data of a tile are stored together, see #InterleavedTile. */
+static constexpr bool MAP_INTERLEAVED = true;
+
+/**
+ * Pointer to one part of the data of a tile in an interleaved map, which steps over whole tiles.
+ * @tparam T The part of the data of the tile.
+ */
+template <typename T>
+class InterleavedTilePtr {
+	T *ptr;
+
+	static T *Step(T *ptr, ptrdiff_t n) { return reinterpret_cast<T *>(reinterpret_cast<uint8_t *>(ptr) + n * static_cast<ptrdiff_t>(sizeof(InterleavedTile))); }
+
+public:
+	explicit InterleavedTilePtr(T *ptr) : ptr(ptr) {}
+
+	T &operator*() const { return *this->ptr; }
+	T *operator->() const { return this->ptr; }
+	debug_inline T &operator[](size_t n) const { return *Step(this->ptr, n); }
+
+	InterleavedTilePtr &operator++() { this->ptr = Step(this->ptr, 1); return *this; }
+	InterleavedTilePtr operator++(int) { InterleavedTilePtr result = *this; ++*this; return result; }
+	InterleavedTilePtr &operator+=(size_t n) { this->ptr = Step(this->ptr, n); return *this; }
+	InterleavedTilePtr operator+(size_t n) const { return InterleavedTilePtr(Step(this->ptr, n)); }
+
+	bool operator==(const InterleavedTilePtr &other) const = default;
+};
+#else
+/** Whether both parts of the data of a tile are stored together, see #InterleavedTile. */
+static constexpr bool MAP_INTERLEAVED = false;
+#endif /* INTERLEAVED_MAP */
+
 template <typename T>
 struct MapTilePtr {
-	T *tile_data;
+#ifdef INTERLEAVED_MAP
+	using iterator = InterleavedTilePtr<T>; ///< Pointer which steps over the data of whole tiles.
+#else
+	using iterator = T *;                   ///< Pointer which steps over the data of whole tiles.
+#endif
+
+	T *tile_data; ///< Data of the first tile, nullptr when no map is allocated.
 
 	/**
 	 * Get a node abstraction with the specified id.
 	 * @param num ID of the node.
 	 * @return the Requested node.
 	 */
-	debug_inline T &operator[](TileIndex tile) { return this->tile_data[tile.base()]; }
+	debug_inline T &operator[](TileIndex tile) { return this->begin()[tile.base()]; }
+
+	/**
+	 * Get a pointer to the data of the first tile, to walk over the tiles in the order of their index.
+	 * @return The pointer.
+	 */
+	debug_inline iterator begin() { return iterator(this->tile_data); }
+
+	/**
+	 * Get a pointer past the data of the last tile.
+	 * @return The pointer.
+	 */
+	debug_inline iterator end() { return this->begin() + Map::Size(); }
 };
 
 /**
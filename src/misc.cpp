@@ -41,6 +41,7 @@
 #include "tbtr_template_vehicle_func.h"
 #include "event_logs.h"
 #include "string_func.h"
+#include "strings_func.h"
 #include "plans_func.h"
 #include "core/format.hpp"
 #include "3rdparty/monocypher/monocypher.h"
@@ -122,6 +123,7 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	ClearCommandQueue();
 	ClearSpecialEventsLog();
 	ClearDesyncMsgLog();
+	InvalidateFormattedStringCache();
 
 	_pause_mode = PM_UNPAUSED;
 	_pause_countdown = 0;
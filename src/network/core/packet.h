@@ -114,6 +114,23 @@ public:
 
 	const uint8_t *GetBufferData() const { return this->buffer.data(); }
 	PacketSize GetRawPos() const { return this->pos; }
+
+	/**
+	 * Get the bytes which still have to be transferred out of this packet.
+	 * This is for gathering the data of multiple packets into a single transfer, use #MarkBytesTransferred afterwards.
+	 * @return The span of bytes from the current position to the end of the packet.
+	 */
+	std::span<const uint8_t> GetPendingTransferData() const { return std::span<const uint8_t>(this->buffer).subspan(this->pos); }
+
+	/**
+	 * Advance the transfer position after data returned by #GetPendingTransferData has been transferred.
+	 * @param bytes The number of bytes which were transferred.
+	 */
+	void MarkBytesTransferred(size_t bytes)
+	{
+		assert(bytes <= this->RemainingBytesToTransfer());
+		this->pos += static_cast<PacketSize>(bytes);
+	}
 	void ReserveBuffer(size_t size) { this->buffer.reserve(size); }
 
 	/**
@@ -14,8 +14,24 @@
 
 #include "tcp.h"
 
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+#	include <sys/uio.h>
+#	define WITH_SENDMSG
+#endif
+
 #include "../../safeguards.h"
 
+#if defined(WITH_SENDMSG)
+/** Maximum number of queued packets which are gathered into a single send call. */
+static constexpr size_t MAX_PACKETS_PER_SEND = 64;
+#else
+/** Scatter/gather sending is not available, send one packet per call. */
+static constexpr size_t MAX_PACKETS_PER_SEND = 1;
+#endif
+
+/** Size of the buffer used when receiving in chunks, this must be larger than the largest packet. */
+static constexpr size_t RECV_BUFFER_SIZE = TCP_MTU * 2;
+
 NetworkTCPSocketHandler::~NetworkTCPSocketHandler()
 {
 	this->CloseSocket();
@@ -44,7 +60,10 @@ NetworkRecvStatus NetworkTCPSocketHandler::CloseConnection([[maybe_unused]] bool
 	this->writable = false;
 
 	this->packet_queue.clear();
+	this->packets_prepared_for_send = 0;
 	this->packet_recv = nullptr;
+	this->recv_buffer_pos = 0;
+	this->recv_buffer_end = 0;
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -76,16 +95,24 @@ void NetworkTCPSocketHandler::SendPrependPacket(std::unique_ptr<Packet> packet,
 
 	packet->PrepareForSendQueue();
 
+	/* Packets which have already been prepared for sending (e.g. encrypted) must stay in front of the queue. */
+	const size_t min_position = this->packets_prepared_for_send;
+
 	if (queue_after_packet_type >= 0) {
 		for (auto iter = this->packet_queue.begin(); iter != this->packet_queue.end(); ++iter) {
 			if ((*iter)->GetTransmitPacketType() == queue_after_packet_type) {
-				++iter;
-				this->packet_queue.insert(iter, std::move(packet));
+				size_t position = std::max<size_t>((iter - this->packet_queue.begin()) + 1, min_position);
+				this->packet_queue.insert(this->packet_queue.begin() + position, std::move(packet));
 				return;
 			}
 		}
 	}
 
+	if (min_position > 1) {
+		this->packet_queue.insert(this->packet_queue.begin() + min_position, std::move(packet));
+		return;
+	}
+
 	/* The very first packet in the queue may be partially written out, so cannot be replaced.
 	 * If the queue is non-empty, swap packet with the first packet in the queue.
 	 * The insert the packet (either the incoming packet or the previous first packet) at the front. */
@@ -103,12 +130,67 @@ void NetworkTCPSocketHandler::ShrinkToFitSendQueue()
 	this->packet_queue.shrink_to_fit();
 }
 
+/**
+ * Prepare the packets at the front of the send queue for sending, e.g. encrypt them.
+ * Prepared packets are not moved or replaced, see #SendPrependPacket.
+ * @param max_packets The maximum number of packets to prepare.
+ * @return The number of packets at the front of the queue which are ready for sending.
+ */
+size_t NetworkTCPSocketHandler::PrepareSendBatch(size_t max_packets)
+{
+	size_t count = std::min(max_packets, this->packet_queue.size());
+	for (size_t i = this->packets_prepared_for_send; i < count; i++) {
+		this->packet_queue[i]->CheckPendingPreSendEncryption();
+	}
+	this->packets_prepared_for_send = std::max(this->packets_prepared_for_send, count);
+	return count;
+}
+
+/**
+ * Send the remaining data of the given number of packets at the front of the queue.
+ * Where available this uses a single scatter/gather send call for all the packets.
+ * The transfer position of each packet is advanced by the amount which was sent.
+ * @param count The number of packets to send, at most #MAX_PACKETS_PER_SEND.
+ * @return The return value of the send call.
+ */
+ssize_t NetworkTCPSocketHandler::TransferOutBatch(size_t count)
+{
+	assert(count > 0 && count <= MAX_PACKETS_PER_SEND);
+
+#if defined(WITH_SENDMSG)
+	std::array<iovec, MAX_PACKETS_PER_SEND> iov;
+	for (size_t i = 0; i < count; i++) {
+		std::span<const uint8_t> data = this->packet_queue[i]->GetPendingTransferData();
+		iov[i].iov_base = const_cast<uint8_t *>(data.data());
+		iov[i].iov_len = data.size();
+	}
+
+	msghdr msg{};
+	msg.msg_iov = iov.data();
+	msg.msg_iovlen = count;
+	ssize_t res = sendmsg(this->sock, &msg, 0);
+	if (res <= 0) return res;
+
+	size_t remaining = res;
+	for (size_t i = 0; i < count && remaining > 0; i++) {
+		Packet &p = *this->packet_queue[i];
+		size_t amount = std::min(remaining, p.RemainingBytesToTransfer());
+		p.MarkBytesTransferred(amount);
+		remaining -= amount;
+	}
+	return res;
+#else
+	return this->packet_queue.front()->TransferOut<int>(send, this->sock, 0);
+#endif
+}
+
 /**
  * Sends all the buffered packets out for this client. It stops when:
  *   1) all packets are send (queue is empty)
  *   2) the OS reports back that it can not send any more
  *      data right now (full network-buffer, it happens ;))
  *   3) sending took too long
+ * Where possible, multiple queued packets are sent using a single call.
  * @param closing_down Whether we are closing down the connection.
  * @return \c true if a (part of a) packet could be sent and
  *         the connection is not closed yet.
@@ -120,9 +202,13 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 	if (!this->IsConnected()) return SPS_CLOSED;
 
 	while (!this->packet_queue.empty()) {
-		Packet &p = *this->packet_queue.front();
-		p.CheckPendingPreSendEncryption();
-		ssize_t res = p.TransferOut<int>(send, this->sock, 0);
+		size_t count = this->PrepareSendBatch(MAX_PACKETS_PER_SEND);
+		size_t to_send = 0;
+		for (size_t i = 0; i < count; i++) {
+			to_send += this->packet_queue[i]->RemainingBytesToTransfer();
+		}
+
+		ssize_t res = this->TransferOutBatch(count);
 		if (res == -1) {
 			NetworkError err = NetworkError::GetLast();
 			if (!err.WouldBlock()) {
@@ -141,19 +227,131 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 			return SPS_CLOSED;
 		}
 
-		/* Is this packet sent? */
-		if (p.RemainingBytesToTransfer() == 0) {
-			/* Go to the next packet */
-			if (GetDebugLevel(DebugLevelID::net) >= 5) this->LogSentPacket(p);
+		/* Go to the next packet for each packet which has been completely sent */
+		while (!this->packet_queue.empty() && this->packet_queue.front()->RemainingBytesToTransfer() == 0) {
+			if (GetDebugLevel(DebugLevelID::net) >= 5) this->LogSentPacket(*this->packet_queue.front());
 			this->packet_queue.pop_front();
-		} else {
-			return SPS_PARTLY_SENT;
+			this->packets_prepared_for_send--;
 		}
+
+		/* Not everything could be sent, the OS buffer is full. */
+		if (static_cast<size_t>(res) < to_send) return SPS_PARTLY_SENT;
 	}
 
 	return SPS_ALL_SENT;
 }
 
+/**
+ * Read as much data as is available, and fits, from the socket into the receive buffer.
+ * @return True when data was read, false when no data is available (yet) or the connection has been closed.
+ */
+bool NetworkTCPSocketHandler::FillReceiveBuffer()
+{
+	if (this->recv_buffer.empty()) this->recv_buffer.resize(RECV_BUFFER_SIZE);
+
+	/* Move the data which has not been sliced out yet to the front, to make space at the end. */
+	if (this->recv_buffer_pos > 0) {
+		std::copy(this->recv_buffer.begin() + this->recv_buffer_pos, this->recv_buffer.begin() + this->recv_buffer_end, this->recv_buffer.begin());
+		this->recv_buffer_end -= this->recv_buffer_pos;
+		this->recv_buffer_pos = 0;
+	}
+	assert(this->recv_buffer_end < this->recv_buffer.size());
+
+	ssize_t res = recv(this->sock, reinterpret_cast<char *>(this->recv_buffer.data() + this->recv_buffer_end), static_cast<int>(this->recv_buffer.size() - this->recv_buffer_end), 0);
+	if (res == -1) {
+		NetworkError err = NetworkError::GetLast();
+		if (!err.WouldBlock()) {
+			/* Something went wrong... */
+			if (!err.IsConnectionReset()) Debug(net, 0, "Recv failed: {}", err.AsString());
+			this->CloseConnection();
+		}
+		/* Connection would block, so stop for now */
+		return false;
+	}
+	if (res == 0) {
+		/* Client/server has left */
+		this->CloseConnection();
+		return false;
+	}
+
+	this->recv_buffer_end += res;
+	return true;
+}
+
+/**
+ * Get the size of the packet at the read position of the receive buffer.
+ * @return The encoded size of the packet, or std::nullopt when not even the size has been received yet.
+ */
+std::optional<size_t> NetworkTCPSocketHandler::GetBufferedPacketSize() const
+{
+	if (this->recv_buffer_end - this->recv_buffer_pos < Packet::EncodedLengthOfPacketSize()) return std::nullopt;
+
+	const uint8_t *data = this->recv_buffer.data() + this->recv_buffer_pos;
+	return (size_t)data[0] + ((size_t)data[1] << 8);
+}
+
+/**
+ * Whether a complete packet is waiting in the receive buffer.
+ * Such a packet can be received without the socket being readable, so it must not wait for new data to arrive.
+ * @return True when #ReceivePacket can return a packet without reading from the socket.
+ */
+bool NetworkTCPSocketHandler::HasBufferedPacket() const
+{
+	if (!this->chunked_receive) return false;
+
+	/* An invalid size is reported as available too, so the connection gets closed by the receive. */
+	std::optional<size_t> size = this->GetBufferedPacketSize();
+	if (!size.has_value()) return false;
+	return *size < Packet::EncodedLengthOfPacketSize() + Packet::EncodedLengthOfPacketType() || *size > TCP_MTU || this->recv_buffer_end - this->recv_buffer_pos >= *size;
+}
+
+/**
+ * Receives a packet for the given client, reading from the socket in large chunks.
+ * Each packet is sliced out of the receive buffer, without any further system calls.
+ * @return The received packet (or nullptr when it didn't receive one)
+ */
+std::unique_ptr<Packet> NetworkTCPSocketHandler::ReceivePacketChunked()
+{
+	auto copy_from_buffer = [](const uint8_t *source, char *destination, size_t amount) -> ssize_t {
+		std::copy(source, source + amount, destination);
+		return amount;
+	};
+
+	while (true) {
+		const size_t available = this->recv_buffer_end - this->recv_buffer_pos;
+		const std::optional<size_t> buffered_size = this->GetBufferedPacketSize();
+		if (buffered_size.has_value()) {
+			const size_t size = *buffered_size;
+			const uint8_t *data = this->recv_buffer.data() + this->recv_buffer_pos;
+
+			/* Parse the size in the received data and if not valid, close the connection. */
+			if (size < Packet::EncodedLengthOfPacketSize() + Packet::EncodedLengthOfPacketType() || size > TCP_MTU) {
+				Debug(net, 0, "ParsePacketSize failed, possible packet stream corruption");
+				this->CloseConnection();
+				return nullptr;
+			}
+
+			if (available >= size) {
+				auto p = std::make_unique<Packet>(Packet::ReadTag{}, this, TCP_MTU);
+				p->TransferIn(copy_from_buffer, data);
+				[[maybe_unused]] bool size_ok = p->ParsePacketSize();
+				assert(size_ok);
+				p->TransferIn(copy_from_buffer, data + Packet::EncodedLengthOfPacketSize());
+				this->recv_buffer_pos += size;
+
+				if (!p->PrepareToRead()) {
+					Debug(net, 0, "Invalid packet received (too small / decryption error)");
+					this->CloseConnection();
+					return nullptr;
+				}
+				return p;
+			}
+		}
+
+		if (!this->FillReceiveBuffer()) return nullptr;
+	}
+}
+
 /**
  * Receives a packet for the given client
  * @return The received packet (or nullptr when it didn't receive one)
@@ -164,6 +362,8 @@ std::unique_ptr<Packet> NetworkTCPSocketHandler::ReceivePacket()
 
 	if (!this->IsConnected()) return nullptr;
 
+	if (this->chunked_receive) return this->ReceivePacketChunked();
+
 	if (this->packet_recv == nullptr) {
 		this->packet_recv = std::make_unique<Packet>(Packet::ReadTag{}, this, TCP_MTU);
 	}
@@ -35,8 +35,22 @@ enum SendPacketsState : uint8_t {
 class NetworkTCPSocketHandler : public NetworkSocketHandler {
 private:
 	ring_buffer<std::unique_ptr<Packet>> packet_queue; ///< Packets that are awaiting delivery
+	size_t packets_prepared_for_send = 0;              ///< Number of packets at the front of packet_queue which have been prepared for sending (e.g. encrypted), nothing may be inserted before these
 	std::unique_ptr<Packet> packet_recv;               ///< Partially received packet
 
+	std::vector<uint8_t> recv_buffer;                  ///< Buffer of raw received data, when receiving in chunks
+	size_t recv_buffer_pos = 0;                        ///< Read position of the first not yet sliced out byte in recv_buffer
+	size_t recv_buffer_end = 0;                        ///< End position of the received data in recv_buffer
+
+	size_t PrepareSendBatch(size_t max_packets);
+	ssize_t TransferOutBatch(size_t count);
+	std::unique_ptr<Packet> ReceivePacketChunked();
+	bool FillReceiveBuffer();
+	std::optional<size_t> GetBufferedPacketSize() const;
+
+protected:
+	bool chunked_receive = false; ///< Whether to read data from the socket in large chunks and slice packets out of that. Only use this when the socket is never handed over to another handler.
+
 public:
 	SOCKET sock = INVALID_SOCKET; ///< The socket currently connected to
 	bool writable = false; ///< Can we write to this socket?
@@ -57,6 +71,7 @@ public:
 	SendPacketsState SendPackets(bool closing_down = false);
 
 	virtual std::unique_ptr<Packet> ReceivePacket();
+	bool HasBufferedPacket() const;
 	virtual void LogSentPacket(const Packet &pkt);
 
 	bool CanSendReceive();
@@ -66,6 +66,10 @@ enum PacketAdminType : uint8_t {
 	ADMIN_PACKET_SERVER_AUTH_REQUEST,    ///< The server gives the admin the used authentication method and required parameters.
 	ADMIN_PACKET_SERVER_ENABLE_ENCRYPTION, ///< The server tells that authentication has completed and requests to enable encryption with the keys of the last \c ADMIN_PACKET_ADMIN_AUTH_RESPONSE.
 
+	/* JGRPP extensions, these are kept clear of the packet types which upstream may add. */
+	ADMIN_PACKET_SERVER_PERFORMANCE_TIMING = 0xC0, ///< The server gives the admin the recent timing measurements of a performance element.
+	ADMIN_PACKET_SERVER_PERFORMANCE_STATS, ///< The server gives the admin entity counts, link graph and save statistics.
+
 	INVALID_ADMIN_PACKET = 0xFF,         ///< An invalid marker for admin packets.
 };
 
@@ -89,9 +93,40 @@ enum AdminUpdateType : uint8_t {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_PERFORMANCE,     ///< The admin would like to have performance measurements.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
+
+	ADMIN_UPDATE_EXTENSION_BEGIN = ADMIN_UPDATE_PERFORMANCE, ///< First update type which is a JGRPP extension.
 };
 
+/** ID on the network of the first update type which is a JGRPP extension, these are kept clear of the update types which upstream may add. */
+static const uint8_t ADMIN_UPDATE_EXTENSION_FIRST_ID = 0xC0;
+
+/**
+ * Get the ID of an update type on the network.
+ * @param type The update type.
+ * @return The ID.
+ */
+inline uint16_t GetAdminUpdateTypeID(AdminUpdateType type)
+{
+	if (type >= ADMIN_UPDATE_EXTENSION_BEGIN) return ADMIN_UPDATE_EXTENSION_FIRST_ID + (type - ADMIN_UPDATE_EXTENSION_BEGIN);
+	return type;
+}
+
+/**
+ * Get the update type of an ID on the network.
+ * @param id The ID.
+ * @return The update type, or #ADMIN_UPDATE_END if the ID is unknown.
+ */
+inline AdminUpdateType GetAdminUpdateTypeFromID(uint16_t id)
+{
+	if (id >= ADMIN_UPDATE_EXTENSION_FIRST_ID) {
+		const uint type = ADMIN_UPDATE_EXTENSION_BEGIN + (id - ADMIN_UPDATE_EXTENSION_FIRST_ID);
+		return type < ADMIN_UPDATE_END ? static_cast<AdminUpdateType>(type) : ADMIN_UPDATE_END;
+	}
+	return id < ADMIN_UPDATE_EXTENSION_BEGIN ? static_cast<AdminUpdateType>(id) : ADMIN_UPDATE_END;
+}
+
 /** Update frequencies an admin can register. */
 enum AdminUpdateFrequency : uint8_t {
 	ADMIN_FREQUENCY_POLL      = 0x01, ///< The admin can poll this.
@@ -540,6 +575,47 @@ protected:
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_RCON_END(Packet &p);
 
+	/**
+	 * Recent timing measurements of a performance element (see framerate window).
+	 * Sent once for each element which has measurements.
+	 * uint16_t  ID of the performance element (see #PerformanceElement).
+	 * uint16_t  Number of valid measurements the data is based on.
+	 * uint32_t  Current rate, in thousandths of cycles per second.
+	 * uint32_t  Expected rate, in thousandths of cycles per second.
+	 * uint32_t  Average duration of the most recent measurements, in microseconds.
+	 * uint32_t  Average duration of all measurements, in microseconds.
+	 * uint32_t  Maximum duration, in microseconds.
+	 * uint8_t   Number of histogram buckets.
+	 * These two fields are repeated for each histogram bucket:
+	 * uint32_t  Upper limit (exclusive) of the bucket in microseconds, UINT32_MAX for the last bucket.
+	 * uint16_t  Number of measurements in the bucket.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_PERFORMANCE_TIMING(Packet &p);
+
+	/**
+	 * General performance related statistics of the server.
+	 * uint64_t  Tick counter.
+	 * uint32_t  Number of vehicles.
+	 * uint32_t  Number of stations (including waypoints).
+	 * uint32_t  Number of towns.
+	 * uint32_t  Number of industries.
+	 * uint32_t  Number of orders.
+	 * uint32_t  Number of cargo packets.
+	 * uint32_t  Number of link graphs.
+	 * uint16_t  Number of link graphs queued for a new link graph job.
+	 * uint16_t  Number of running link graph jobs.
+	 * uint32_t  Maximum number of ticks an unfinished link graph job is past its join tick.
+	 * uint32_t  Number of ticks since the oldest running link graph job was started.
+	 * uint32_t  Number of saves completed since start-up.
+	 * uint64_t  Duration of serialising the last save, during which the game loop is blocked, in microseconds.
+	 * uint64_t  Total duration of the last save, in microseconds.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_PERFORMANCE_STATS(Packet &p);
+
 	NetworkRecvStatus HandlePacket(Packet &p);
 public:
 	NetworkRecvStatus CloseConnection(bool error = true) override;
@@ -128,7 +128,8 @@ public:
 		/* read stuff from clients */
 		for (Tsocket *cs : Tsocket::Iterate()) {
 			cs->writable = !!FD_ISSET(cs->sock, &write_fd);
-			if (FD_ISSET(cs->sock, &read_fd)) {
+			/* Packets which are already buffered must be handled, even when no new data arrived. */
+			if (FD_ISSET(cs->sock, &read_fd) || cs->HasBufferedPacket()) {
 				cs->ReceivePackets();
 			}
 		}
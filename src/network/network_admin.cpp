@@ -22,6 +22,16 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../framerate_type.h"
+#include "../vehicle_base.h"
+#include "../station_base.h"
+#include "../town.h"
+#include "../industry.h"
+#include "../order_base.h"
+#include "../cargopacket.h"
+#include "../linkgraph/linkgraph.h"
+#include "../linkgraph/linkgraphschedule.h"
+#include "../sl/saveload.h"
 
 #include <numeric>
 
@@ -56,6 +66,7 @@ static const AdminUpdateFrequency _admin_update_type_frequencies[] = {
 	ADMIN_FREQUENCY_POLL,                                                                                                                                  ///< ADMIN_UPDATE_CMD_NAMES
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CMD_LOGGING
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_GAMESCRIPT
+	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY | ADMIN_FREQUENCY_AUTOMATIC, ///< ADMIN_UPDATE_PERFORMANCE
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -68,6 +79,7 @@ ServerNetworkAdminSocketHandler::ServerNetworkAdminSocketHandler(SOCKET s) : Net
 {
 	this->status = ADMIN_STATUS_INACTIVE;
 	this->connect_time = std::chrono::steady_clock::now();
+	this->chunked_receive = true;
 }
 
 /**
@@ -102,6 +114,14 @@ ServerNetworkAdminSocketHandler::~ServerNetworkAdminSocketHandler()
 			as->CloseConnection(true);
 			continue;
 		}
+		if (as->status == ADMIN_STATUS_ACTIVE && (as->update_frequency[ADMIN_UPDATE_PERFORMANCE] & ADMIN_FREQUENCY_AUTOMATIC)) {
+			/* Automatic performance updates are sent at a wall-clock interval, so they keep coming when the game is slow or paused. */
+			auto now = std::chrono::steady_clock::now();
+			if (now >= as->last_performance_update + std::chrono::seconds(_settings_client.network.admin_performance_interval)) {
+				as->last_performance_update = now;
+				as->SendPerformance();
+			}
+		}
 		if (as->writable) {
 			as->SendPackets();
 		}
@@ -156,7 +176,7 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendProtocol()
 
 	for (int i = 0; i < ADMIN_UPDATE_END; i++) {
 		p->Send_bool  (true);
-		p->Send_uint16(i);
+		p->Send_uint16(GetAdminUpdateTypeID(static_cast<AdminUpdateType>(i)));
 		p->Send_uint16(_admin_update_type_frequencies[i]);
 	}
 
@@ -437,6 +457,59 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/** Send the performance measurements and statistics. */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendPerformance()
+{
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		PerformanceSummary summary;
+		if (!GetPerformanceSummary(e, summary)) continue;
+
+		auto p = std::make_unique<Packet>(this, ADMIN_PACKET_SERVER_PERFORMANCE_TIMING);
+
+		p->Send_uint16(e);
+		p->Send_uint16(ClampTo<uint16_t>(summary.num_valid));
+		p->Send_uint32(static_cast<uint32_t>(std::min<double>(summary.rate * 1000, UINT32_MAX)));
+		p->Send_uint32(static_cast<uint32_t>(std::min<double>(summary.expected_rate * 1000, UINT32_MAX)));
+		p->Send_uint32(ClampTo<uint32_t>(summary.avg_recent));
+		p->Send_uint32(ClampTo<uint32_t>(summary.avg_all));
+		p->Send_uint32(ClampTo<uint32_t>(summary.max));
+
+		p->Send_uint8(static_cast<uint8_t>(PerformanceSummary::HISTOGRAM_BUCKETS));
+		for (size_t i = 0; i < PerformanceSummary::HISTOGRAM_BUCKETS; i++) {
+			p->Send_uint32(i < PerformanceSummary::HISTOGRAM_LIMITS.size() ? ClampTo<uint32_t>(PerformanceSummary::HISTOGRAM_LIMITS[i]) : UINT32_MAX);
+			p->Send_uint16(summary.histogram[i]);
+		}
+
+		this->SendPacket(std::move(p));
+	}
+
+	auto p = std::make_unique<Packet>(this, ADMIN_PACKET_SERVER_PERFORMANCE_STATS);
+
+	p->Send_uint64(_tick_counter);
+	p->Send_uint32(static_cast<uint32_t>(Vehicle::GetNumItems()));
+	p->Send_uint32(static_cast<uint32_t>(BaseStation::GetNumItems()));
+	p->Send_uint32(static_cast<uint32_t>(Town::GetNumItems()));
+	p->Send_uint32(static_cast<uint32_t>(Industry::GetNumItems()));
+	p->Send_uint32(static_cast<uint32_t>(OrderPoolItem::GetNumItems()));
+	p->Send_uint32(static_cast<uint32_t>(CargoPacket::GetNumItems()));
+	p->Send_uint32(static_cast<uint32_t>(LinkGraph::GetNumItems()));
+
+	LinkGraphSchedule::Statistics lg_stats = LinkGraphSchedule::instance.GetStatistics();
+	p->Send_uint16(ClampTo<uint16_t>(lg_stats.scheduled));
+	p->Send_uint16(ClampTo<uint16_t>(lg_stats.running));
+	p->Send_uint32(ClampTo<uint32_t>(lg_stats.max_overdue));
+	p->Send_uint32(ClampTo<uint32_t>(lg_stats.max_age));
+
+	const SaveDurations &save = GetLastSaveDurations();
+	p->Send_uint32(save.count);
+	p->Send_uint64(save.serialise);
+	p->Send_uint64(save.total);
+
+	this->SendPacket(std::move(p));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -673,7 +746,7 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_UPDATE_FREQUENC
 {
 	if (this->status <= ADMIN_STATUS_AUTHENTICATE) return this->SendError(NETWORK_ERROR_NOT_EXPECTED);
 
-	AdminUpdateType type = (AdminUpdateType)p.Recv_uint16();
+	AdminUpdateType type = GetAdminUpdateTypeFromID(p.Recv_uint16());
 	AdminUpdateFrequency freq = (AdminUpdateFrequency)p.Recv_uint16();
 
 	if (type >= ADMIN_UPDATE_END || (_admin_update_type_frequencies[type] & freq) != freq) {
@@ -693,7 +766,7 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet &p)
 {
 	if (this->status <= ADMIN_STATUS_AUTHENTICATE) return this->SendError(NETWORK_ERROR_NOT_EXPECTED);
 
-	AdminUpdateType type = (AdminUpdateType)p.Recv_uint8();
+	AdminUpdateType type = GetAdminUpdateTypeFromID(p.Recv_uint8());
 	uint32_t d1 = p.Recv_uint32();
 
 	switch (type) {
@@ -746,6 +819,11 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet &p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_PERFORMANCE:
+			/* The admin is requesting performance measurements. */
+			this->SendPerformance();
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			Debug(net, 1, "[admin] Not supported poll {} ({}) from '{}' ({}).", type, d1, this->admin_name, this->admin_version);
@@ -1089,6 +1167,10 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendCompanyStats();
 						break;
 
+					case ADMIN_UPDATE_PERFORMANCE:
+						as->SendPerformance();
+						break;
+
 					default: NOT_REACHED();
 				}
 			}
@@ -146,13 +146,20 @@ static void DistributeCommandPacket(CommandPacket cp, const NetworkClientSocket
 	CommandCallback callback = cp.callback;
 	cp.frame = _frame_counter_max + 1;
 
+	/* Serialise the payload only once, all clients share the same serialised data.
+	 * Only the callback and my_cmd fields differ per client. */
+	std::optional<OutgoingCommandPacket> serialised;
+
 	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
 		if (cs->status >= NetworkClientSocket::STATUS_MAP) {
+			if (!serialised.has_value()) serialised = SerialiseCommandPacket(cp);
+
+			OutgoingCommandPacket &out = cs->outgoing_queue.emplace_back(*serialised);
+
 			/* Callbacks are only send back to the client who sent them in the
 			 *  first place. This filters that out. */
-			cp.callback = (cs != owner) ? CommandCallback::None : callback;
-			cp.my_cmd = (cs == owner);
-			cs->outgoing_queue.push_back(SerialiseCommandPacket(cp));
+			out.callback = (cs != owner) ? CommandCallback::None : callback;
+			out.my_cmd = (cs == owner);
 		}
 	}
 
@@ -142,7 +142,9 @@ inline OutgoingCommandPacket SerialiseCommandPacketUsingPayload(const CommandPac
 	out.command_container.cmd = cp.command_container.cmd;
 	out.command_container.error_msg = cp.command_container.error_msg;
 	out.command_container.tile = cp.command_container.tile;
-	payload.Serialise(BufferSerialisationRef(out.command_container.payload.serialised_data));
+	std::vector<uint8_t> serialised_data;
+	payload.Serialise(BufferSerialisationRef(serialised_data));
+	out.command_container.payload.serialised_data = std::make_shared<const std::vector<uint8_t>>(std::move(serialised_data));
 
 	out.callback = cp.callback;
 	out.callback_param = cp.callback_param;
@@ -11702,11 +11702,29 @@ static void LoadNewGRFFileFromFile(GRFConfig &config, GrfLoadingStage stage, Spr
 
 	ReusableBuffer<uint8_t> buf;
 
-	while ((num = (grf_container_version >= 2 ? file.ReadDword() : file.ReadWord())) != 0) {
-		uint8_t type = file.ReadByte();
+	/* Size of the length and type fields preceding the sprite data. */
+	const size_t header_size = (grf_container_version >= 2 ? 4 : 2) + 1;
+
+	for (;;) {
+		/* Sprites which were already passed by an earlier stage are found in the index of the (cached) file.
+		 * This avoids parsing their headers again and, more importantly, the data of real sprites. */
+		const size_t sprite_pos = file.GetPos();
+		const SpriteFileIndexEntry *indexed = file.FindIndexedSprite(sprite_pos);
+		uint8_t type;
+		if (indexed != nullptr) {
+			num = indexed->num;
+			type = indexed->type;
+			file.SeekTo(sprite_pos + header_size, SEEK_SET);
+		} else {
+			num = grf_container_version >= 2 ? file.ReadDword() : file.ReadWord();
+			if (num == 0) break;
+			type = file.ReadByte();
+		}
 		_cur.nfo_line++;
 
 		if (type == 0xFF) {
+			if (indexed == nullptr) file.AddIndexedSprite({ sprite_pos, sprite_pos + header_size + num, num, type });
+
 			if (_cur.skip_sprites == 0) {
 				DecodeSpecialSprite(buf.Allocate(num), num, stage);
 
@@ -11724,12 +11742,17 @@ static void LoadNewGRFFileFromFile(GRFConfig &config, GrfLoadingStage stage, Spr
 				break;
 			}
 
-			if (grf_container_version >= 2 && type == 0xFD) {
-				/* Reference to data section. Container version >= 2 only. */
-				file.SkipBytes(num);
+			if (indexed != nullptr) {
+				file.SeekTo(indexed->next_pos, SEEK_SET);
 			} else {
-				file.SkipBytes(7);
-				SkipSpriteData(file, type, num - 8);
+				if (grf_container_version >= 2 && type == 0xFD) {
+					/* Reference to data section. Container version >= 2 only. */
+					file.SkipBytes(num);
+				} else {
+					file.SkipBytes(7);
+					SkipSpriteData(file, type, num - 8);
+				}
+				file.AddIndexedSprite({ sprite_pos, file.GetPos(), num, type });
 			}
 		}
 
@@ -12244,6 +12267,11 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 	/* Call any functions that should be run after GRFs have been loaded. */
 	AfterLoadGRFs();
 
+	/* Sprites are only read on demand from now on, release what was only needed while loading. */
+	for (const auto &file : GetCachedSpriteFiles()) {
+		file->FinishLoading();
+	}
+
 	/* Now revert back to the original situation */
 	CalTime::Detail::now = cal_state;
 	EconTime::Detail::now = econ_state;
@@ -22,6 +22,7 @@
 #include "textfile_gui.h"
 #include "thread.h"
 #include "newgrf_config.h"
+#include "newgrf_scan_cache.h"
 #include "newgrf_text.h"
 
 #include "fileio_func.h"
@@ -590,6 +591,8 @@ class GRFFileScanner : FileScanner {
 	std::chrono::steady_clock::time_point next_update; ///< The next moment we do update the screen.
 	uint num_scanned; ///< The number of GRFs we have scanned.
 	std::vector<std::unique_ptr<GRFConfig>> grfs;
+	GRFScanCache cache; ///< Results of previous scans.
+	std::vector<std::pair<GRFScanCacheKey, const GRFConfig *>> to_cache; ///< Scanned NewGRFs to add to the cache once their MD5 sums are known.
 
 public:
 	GRFFileScanner() : num_scanned(0)
@@ -610,9 +613,17 @@ public:
 		CalcGRFMD5ThreadingStart();
 		GRFFileScanner fs;
 		fs.grfs.clear();
+		fs.cache.Load();
 		int ret = fs.Scan(".grf", NEWGRF_DIR);
 		CalcGRFMD5ThreadingEnd();
 
+		if (!_exit_game) {
+			for (const auto &[key, config] : fs.to_cache) {
+				fs.cache.Store(key, config);
+			}
+			fs.cache.Save();
+		}
+
 		for (std::unique_ptr<GRFConfig> &c : fs.grfs) {
 			if (std::ranges::none_of(_all_grfs, [&c](const auto &gc) { return c->ident.grfid == gc->ident.grfid && c->ident.md5sum == gc->ident.md5sum; })) {
 				_all_grfs.push_back(std::move(c));
@@ -626,14 +637,27 @@ public:
 	}
 };
 
-bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &)
+bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename)
 {
 	/* Abort if the user stopped the game during a scan. */
 	if (_exit_game) return false;
 
 	auto c = std::make_unique<GRFConfig>(filename.substr(basepath_length));
 	GRFConfig *grfconfig = c.get();
-	bool added = FillGRFDetails(*c, false);
+
+	/* Unchanged files need neither parsing nor hashing again. */
+	std::optional<GRFScanCacheKey> key = GetGRFScanCacheKey(filename, tar_filename);
+	std::optional<bool> cached = key.has_value() ? this->cache.Lookup(*key, *c) : std::nullopt;
+
+	bool added = cached.has_value() ? *cached : FillGRFDetails(*c, false);
+	if (key.has_value() && !cached.has_value()) {
+		if (added) {
+			/* The MD5 sum may still be calculated by another thread, so store it after the scan. */
+			this->to_cache.emplace_back(std::move(*key), grfconfig);
+		} else {
+			this->cache.Store(*key, nullptr);
+		}
+	}
 	if (added) {
 		this->grfs.push_back(std::move(c));
 	}
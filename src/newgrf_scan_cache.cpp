@@ -0,0 +1,355 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file newgrf_scan_cache.cpp Persistent cache of the results of scanning NewGRF files. */
+
+#include "stdafx.h"
+#include "newgrf_scan_cache.h"
+#include "newgrf_text.h"
+#include "debug.h"
+#include "fileio_func.h"
+#include "rev.h"
+#include "core/serialisation.hpp"
+
+#include <filesystem>
+
+#include "safeguards.h"
+
+extern std::string _personal_dir;
+
+/** Magic number at the start of the cache file. */
+static const uint32_t GRF_SCAN_CACHE_MAGIC = 0x4F475343; // 'OGSC'
+/** Version of the format of the cache file, increase when the serialised data changes. */
+static const uint32_t GRF_SCAN_CACHE_VERSION = 2;
+/** Upper limit of the size of the cache file that is read. */
+static const size_t GRF_SCAN_CACHE_MAX_SIZE = 256 * 1024 * 1024;
+
+/** Validation settings for strings in the cache, GRF texts contain control codes and newlines. */
+static const StringValidationSettings GRF_SCAN_CACHE_STRING_SETTINGS = SVS_REPLACE_WITH_QUESTION_MARK | SVS_ALLOW_CONTROL_CODE | SVS_ALLOW_NEWLINE;
+
+/**
+ * Get the name of the file the cache is stored in.
+ * @return The full path of the cache file.
+ */
+static std::string GetGRFScanCacheFilename()
+{
+	return _personal_dir + "newgrf_scan.cache";
+}
+
+/**
+ * Get the key identifying the current state of a NewGRF file on disk.
+ * For files within a tar the state of the tar itself is used.
+ * @param filename     The full path of the file.
+ * @param tar_filename The full path of the tar containing the file, or empty when it is not in a tar.
+ * @return The key, or std::nullopt when the file could not be examined.
+ */
+std::optional<GRFScanCacheKey> GetGRFScanCacheKey(const std::string &filename, const std::string &tar_filename)
+{
+	std::filesystem::path path(OTTD2FS(tar_filename.empty() ? filename : tar_filename));
+
+	std::error_code ec;
+	uintmax_t size = std::filesystem::file_size(path, ec);
+	if (ec) return std::nullopt;
+	std::filesystem::file_time_type mtime = std::filesystem::last_write_time(path, ec);
+	if (ec) return std::nullopt;
+
+	return GRFScanCacheKey{ filename, static_cast<uint64_t>(size), static_cast<int64_t>(mtime.time_since_epoch().count()) };
+}
+
+static void SerialiseGRFTextList(BufferSerialisationRef &buffer, const GRFTextList &list)
+{
+	buffer.Send_varuint(list.size());
+	for (const GRFText &text : list) {
+		buffer.Send_uint8(text.langid);
+		buffer.Send_string(text.text);
+	}
+}
+
+static void DeserialiseGRFTextList(DeserialisationBuffer &buffer, GRFTextList &list)
+{
+	size_t count = buffer.Recv_varuint();
+	list.clear();
+	for (size_t i = 0; i < count && !buffer.error; i++) {
+		GRFText &text = list.emplace_back();
+		text.langid = buffer.Recv_uint8();
+		buffer.Recv_string(text.text, GRF_SCAN_CACHE_STRING_SETTINGS);
+	}
+}
+
+static void SerialiseGRFTextWrapper(BufferSerialisationRef &buffer, const GRFTextWrapper &wrapper)
+{
+	buffer.Send_bool(wrapper != nullptr);
+	if (wrapper != nullptr) SerialiseGRFTextList(buffer, *wrapper);
+}
+
+static void DeserialiseGRFTextWrapper(DeserialisationBuffer &buffer, GRFTextWrapper &wrapper)
+{
+	if (buffer.Recv_bool()) {
+		wrapper = std::make_shared<GRFTextList>();
+		DeserialiseGRFTextList(buffer, *wrapper);
+	} else {
+		wrapper.reset();
+	}
+}
+
+/**
+ * Serialise the details found by scanning a NewGRF.
+ * The filename is not included, it is known by the scanner.
+ * @param buffer The buffer to write to.
+ * @param config The scanned NewGRF.
+ */
+static void SerialiseGRFConfig(BufferSerialisationRef &buffer, const GRFConfig &config)
+{
+	buffer.Send_uint32(config.ident.grfid);
+	buffer.Send_binary(config.ident.md5sum);
+	SerialiseGRFTextWrapper(buffer, config.name);
+	SerialiseGRFTextWrapper(buffer, config.info);
+	SerialiseGRFTextWrapper(buffer, config.url);
+	buffer.Send_uint32(config.version);
+	buffer.Send_uint32(config.min_loadable_version);
+	buffer.Send_uint8(config.flags.base());
+	buffer.Send_uint8(config.num_valid_params);
+	buffer.Send_uint8(config.palette);
+	buffer.Send_bool(config.has_param_defaults);
+
+	buffer.Send_varuint(config.param_info.size());
+	for (const std::optional<GRFParameterInfo> &info : config.param_info) {
+		buffer.Send_bool(info.has_value());
+		if (!info.has_value()) continue;
+
+		SerialiseGRFTextList(buffer, info->name);
+		SerialiseGRFTextList(buffer, info->desc);
+		buffer.Send_uint32(info->min_value);
+		buffer.Send_uint32(info->max_value);
+		buffer.Send_uint32(info->def_value);
+		buffer.Send_uint8(info->type);
+		buffer.Send_uint8(info->param_nr);
+		buffer.Send_uint8(info->first_bit);
+		buffer.Send_uint8(info->num_bit);
+		buffer.Send_bool(info->complete_labels);
+		buffer.Send_varuint(info->value_names.size());
+		for (const GRFParameterInfo::ValueName &value_name : info->value_names) {
+			buffer.Send_uint32(value_name.first);
+			SerialiseGRFTextList(buffer, value_name.second);
+		}
+	}
+
+	buffer.Send_varuint(config.param.size());
+	for (uint32_t value : config.param) {
+		buffer.Send_uint32(value);
+	}
+}
+
+/**
+ * Deserialise the details of a NewGRF, as written by #SerialiseGRFConfig.
+ * @param buffer The buffer to read from.
+ * @param config The NewGRF to fill.
+ * @return True when the data was valid.
+ */
+static bool DeserialiseGRFConfig(DeserialisationBuffer &buffer, GRFConfig &config)
+{
+	config.ident.grfid = buffer.Recv_uint32();
+	buffer.Recv_binary(config.ident.md5sum);
+	DeserialiseGRFTextWrapper(buffer, config.name);
+	DeserialiseGRFTextWrapper(buffer, config.info);
+	DeserialiseGRFTextWrapper(buffer, config.url);
+	config.version = buffer.Recv_uint32();
+	config.min_loadable_version = buffer.Recv_uint32();
+	config.flags = GRFConfigFlags(buffer.Recv_uint8());
+	config.num_valid_params = buffer.Recv_uint8();
+	config.palette = buffer.Recv_uint8();
+	config.has_param_defaults = buffer.Recv_bool();
+
+	size_t param_info_count = buffer.Recv_varuint();
+	if (param_info_count > GRFConfig::MAX_NUM_PARAMS) return false;
+	config.param_info.clear();
+	for (size_t i = 0; i < param_info_count && !buffer.error; i++) {
+		std::optional<GRFParameterInfo> &info = config.param_info.emplace_back();
+		if (!buffer.Recv_bool()) continue;
+
+		info.emplace(0);
+		DeserialiseGRFTextList(buffer, info->name);
+		DeserialiseGRFTextList(buffer, info->desc);
+		info->min_value = buffer.Recv_uint32();
+		info->max_value = buffer.Recv_uint32();
+		info->def_value = buffer.Recv_uint32();
+		info->type = static_cast<GRFParameterType>(buffer.Recv_uint8());
+		info->param_nr = buffer.Recv_uint8();
+		info->first_bit = buffer.Recv_uint8();
+		info->num_bit = buffer.Recv_uint8();
+		info->complete_labels = buffer.Recv_bool();
+		size_t value_name_count = buffer.Recv_varuint();
+		for (size_t j = 0; j < value_name_count && !buffer.error; j++) {
+			GRFParameterInfo::ValueName &value_name = info->value_names.emplace_back();
+			value_name.first = buffer.Recv_uint32();
+			DeserialiseGRFTextList(buffer, value_name.second);
+		}
+		if (info->type >= PTYPE_END) return false;
+	}
+
+	size_t param_count = buffer.Recv_varuint();
+	if (param_count > GRFConfig::MAX_NUM_PARAMS) return false;
+	config.param.clear();
+	for (size_t i = 0; i < param_count && !buffer.error; i++) {
+		config.param.push_back(buffer.Recv_uint32());
+	}
+
+	return !buffer.error && buffer.pos == buffer.size;
+}
+
+/**
+ * Read the cache from disk, dropping any previously loaded entries.
+ * A cache written by a different version of the game is ignored, as the results of scanning may differ.
+ * A cache of which the size does not match the size in its header, e.g. because writing it was interrupted, is ignored too.
+ */
+void GRFScanCache::Load()
+{
+	this->loaded.clear();
+	this->current.clear();
+
+	size_t len;
+	std::unique_ptr<char[]> data = ReadFileToMem(GetGRFScanCacheFilename(), len, GRF_SCAN_CACHE_MAX_SIZE);
+	if (data == nullptr) return;
+
+	DeserialisationBuffer buffer(reinterpret_cast<const uint8_t *>(data.get()), len);
+	if (buffer.Recv_uint32() != GRF_SCAN_CACHE_MAGIC || buffer.Recv_uint32() != GRF_SCAN_CACHE_VERSION) return;
+
+	uint64_t payload_size = buffer.Recv_uint64();
+	if (buffer.error || payload_size != buffer.size - buffer.pos) {
+		Debug(grf, 0, "NewGRF scan cache is truncated, ignoring it");
+		return;
+	}
+
+	std::string revision;
+	buffer.Recv_string(revision);
+	if (revision != _openttd_revision) {
+		Debug(grf, 1, "NewGRF scan cache was written by a different version, ignoring it");
+		return;
+	}
+
+	size_t count = buffer.Recv_varuint();
+	for (size_t i = 0; i < count && !buffer.error; i++) {
+		std::string filename;
+		buffer.Recv_string(filename, SVS_NONE);
+		Entry entry;
+		entry.size = buffer.Recv_uint64();
+		entry.mtime = static_cast<int64_t>(buffer.Recv_uint64());
+		size_t data_size = buffer.Recv_varuint();
+		std::span<const uint8_t> view = buffer.Recv_binary_view(data_size);
+		entry.data.assign(view.begin(), view.end());
+		if (!buffer.error) this->loaded[std::move(filename)] = std::move(entry);
+	}
+
+	if (buffer.error || buffer.pos != buffer.size) {
+		Debug(grf, 0, "NewGRF scan cache is corrupt, ignoring it");
+		this->loaded.clear();
+		return;
+	}
+
+	Debug(grf, 2, "Loaded NewGRF scan cache with {} entries", this->loaded.size());
+}
+
+/**
+ * Write the entries of the files found by the current scan to disk.
+ * Entries of files which were not found again are dropped.
+ * The cache is first written to a temporary file, which then replaces the old cache, so that an interrupted
+ * write does not leave a truncated cache behind.
+ */
+void GRFScanCache::Save() const
+{
+	std::vector<uint8_t> payload;
+	BufferSerialisationRef buffer(payload);
+	buffer.Send_string(_openttd_revision);
+	buffer.Send_varuint(this->current.size());
+	for (const auto &[filename, entry] : this->current) {
+		buffer.Send_string(filename);
+		buffer.Send_uint64(entry.size);
+		buffer.Send_uint64(static_cast<uint64_t>(entry.mtime));
+		buffer.Send_varuint(entry.data.size());
+		buffer.Send_binary(entry.data);
+	}
+
+	std::vector<uint8_t> data;
+	BufferSerialisationRef header(data);
+	header.Send_uint32(GRF_SCAN_CACHE_MAGIC);
+	header.Send_uint32(GRF_SCAN_CACHE_VERSION);
+	header.Send_uint64(payload.size());
+	data.insert(data.end(), payload.begin(), payload.end());
+
+	const std::string filename = GetGRFScanCacheFilename();
+	const std::string file_new = filename + ".new";
+	bool written = false;
+	{
+		auto f = FileHandle::Open(file_new, "wb");
+		written = f.has_value() && fwrite(data.data(), 1, data.size(), *f) == data.size() && fflush(*f) == 0;
+	}
+	if (!written) {
+		Debug(grf, 0, "Writing NewGRF scan cache to {} failed", file_new);
+		FioRemove(file_new);
+		return;
+	}
+
+	if (!FioRenameFile(file_new, filename)) {
+		Debug(grf, 0, "Renaming {} to {} failed; NewGRF scan cache not saved", file_new, filename);
+		FioRemove(file_new);
+		return;
+	}
+
+	Debug(grf, 2, "Saved NewGRF scan cache with {} entries", this->current.size());
+}
+
+/**
+ * Look up a NewGRF in the cache, and fill its details when it has not changed since it was cached.
+ * The entry is retained for the next time the cache is saved.
+ * @param key    The current state of the file.
+ * @param config The NewGRF to fill, with the filename already set.
+ * @return std::nullopt when the file needs to be scanned, otherwise whether it is a usable NewGRF.
+ */
+std::optional<bool> GRFScanCache::Lookup(const GRFScanCacheKey &key, GRFConfig &config)
+{
+	auto it = this->loaded.find(key.filename);
+	if (it == this->loaded.end()) return std::nullopt;
+
+	auto node = this->loaded.extract(it);
+	const Entry &entry = node.mapped();
+	if (entry.size != key.size || entry.mtime != key.mtime) return std::nullopt;
+
+	if (entry.data.empty()) {
+		this->current.insert(std::move(node));
+		return false;
+	}
+
+	DeserialisationBuffer buffer(entry.data.data(), entry.data.size());
+	if (!DeserialiseGRFConfig(buffer, config)) {
+		Debug(grf, 1, "NewGRF scan cache entry for {} is corrupt, rescanning", key.filename);
+		return std::nullopt;
+	}
+	config.SetSuitablePalette();
+
+	this->current.insert(std::move(node));
+	return true;
+}
+
+/**
+ * Store the details of a freshly scanned NewGRF, including its MD5 sum.
+ * NewGRFs which ran into an error while scanning are not stored, so they will be scanned again.
+ * @param key    The state of the file when it was scanned.
+ * @param config The scanned NewGRF, or nullptr when the file is not a usable NewGRF.
+ */
+void GRFScanCache::Store(const GRFScanCacheKey &key, const GRFConfig *config)
+{
+	if (config != nullptr && (config->status != GCS_UNKNOWN || config->error.has_value())) return;
+
+	Entry &entry = this->current[key.filename];
+	entry.size = key.size;
+	entry.mtime = key.mtime;
+	entry.data.clear();
+	if (config != nullptr) {
+		BufferSerialisationRef buffer(entry.data);
+		SerialiseGRFConfig(buffer, *config);
+	}
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file newgrf_scan_cache.h Persistent cache of the results of scanning NewGRF files. */
+
+#ifndef NEWGRF_SCAN_CACHE_H
+#define NEWGRF_SCAN_CACHE_H
+
+#include "newgrf_config.h"
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** Identifies the state on disk of a scanned NewGRF file. */
+struct GRFScanCacheKey {
+	std::string filename; ///< Full path of the NewGRF file, or of the file within its tar.
+	uint64_t size;        ///< Size of the file on disk, or of the tar containing it.
+	int64_t mtime;        ///< Modification time of the file on disk, or of the tar containing it.
+};
+
+std::optional<GRFScanCacheKey> GetGRFScanCacheKey(const std::string &filename, const std::string &tar_filename);
+
+/**
+ * Cache of the details found by scanning NewGRF files, together with their MD5 sums.
+ * Files which are unchanged since they were last scanned do not need to be parsed and hashed again.
+ */
+class GRFScanCache {
+	/** Details of a single scanned file. */
+	struct Entry {
+		uint64_t size;             ///< Size of the file when it was scanned.
+		int64_t mtime;             ///< Modification time of the file when it was scanned.
+		std::vector<uint8_t> data; ///< Serialised details of the NewGRF, empty when the file was not a usable NewGRF.
+	};
+
+	std::unordered_map<std::string, Entry> loaded;  ///< Entries read from disk which have not been looked up yet.
+	std::unordered_map<std::string, Entry> current; ///< Entries of the files found by the current scan.
+
+public:
+	void Load();
+	void Save() const;
+
+	std::optional<bool> Lookup(const GRFScanCacheKey &key, GRFConfig &config);
+	void Store(const GRFScanCacheKey &key, const GRFConfig *config);
+};
+
+#endif /* NEWGRF_SCAN_CACHE_H */
@@ -71,6 +71,7 @@
 #include "viewport_func.h"
 #include "viewport_sprite_sorter.h"
 #include "framerate_type.h"
+#include "zone_profiler.h"
 #include "programmable_signals.h"
 #include "smallmap_gui.h"
 #include "viewport_func.h"
@@ -1538,6 +1539,7 @@ void StateGameLoop()
 
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
+	ZoneProfilerScope zone(ZPZ_TICK, static_cast<uint32_t>(_tick_counter));
 
 	Layouter::ReduceLineCache();
 
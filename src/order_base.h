@@ -1033,6 +1033,18 @@ private:
 
 	std::vector<DispatchSchedule> dispatch_schedules; ///< Scheduled dispatch schedules
 
+	/**
+	 * Key of a next stopping station result: current implicit order index and last visited station in the upper and lower
+	 * 16 bits respectively, and the cargo mask.
+	 */
+	using NextStoppingStationCacheKey = std::pair<uint32_t, CargoTypes>;
+	mutable btree::btree_map<NextStoppingStationCacheKey, CargoMaskedStationIDStack> next_stopping_station_cache; ///< NOSAVE: Memo of GetNextStoppingStation results.
+
+	static inline uint32_t schedule_version_counter = 0;                     ///< Source of schedule versions, shared by all order lists.
+	uint32_t schedule_version = ++OrderList::schedule_version_counter;     ///< NOSAVE: Schedule version, see GetScheduleVersion.
+
+	CargoMaskedStationIDStack CalculateNextStoppingStation(const Vehicle *v, CargoTypes cargo_mask, const Order *first, uint hops) const;
+
 public:
 	/** Default constructor producing an invalid order list. */
 	OrderList()
@@ -1174,6 +1186,28 @@ public:
 	CargoMaskedStationIDStack GetNextStoppingStation(const Vehicle *v, CargoTypes cargo_mask, const Order *first = nullptr, uint hops = 0) const;
 	const Order *GetNextDecisionNode(const Order *next, uint hops, CargoTypes &cargo_mask) const;
 
+	/**
+	 * Clear the memo of next stopping stations, this must be called whenever the orders in the list are changed.
+	 */
+	inline void InvalidateNextStoppingStationCache() { this->next_stopping_station_cache.clear(); }
+
+	/**
+	 * Note that the orders, timetable or dispatch schedules of this list have changed.
+	 * This clears the memo of next stopping stations and moves the list to a new schedule version.
+	 */
+	inline void OnScheduleChanged()
+	{
+		this->InvalidateNextStoppingStationCache();
+		this->schedule_version = ++OrderList::schedule_version_counter;
+	}
+
+	/**
+	 * Get the schedule version of this order list.
+	 * This changes whenever OnScheduleChanged is called, and is never shared with any other order list.
+	 * @return schedule version
+	 */
+	inline uint32_t GetScheduleVersion() const { return this->schedule_version; }
+
 	void InsertOrderAt(Order &&new_order, VehicleOrderID index);
 	void DeleteOrderAt(VehicleOrderID index);
 	void MoveOrder(VehicleOrderID from, VehicleOrderID to);
@@ -456,6 +456,7 @@ void OrderList::Initialize(Vehicle *v)
 	this->num_vehicles = 1;
 	this->timetable_duration = 0;
 	this->total_duration = 0;
+	this->OnScheduleChanged();
 
 	VehicleType type = v->type;
 	Owner owner = v->owner;
@@ -505,6 +506,7 @@ void OrderList::FreeChain(bool keep_orderlist)
 		if (!CleaningPool()) o->InvalidateGuiOnRemove();
 	}
 	this->orders.clear();
+	this->OnScheduleChanged();
 
 	if (keep_orderlist) {
 		this->num_manual_orders = 0;
@@ -569,17 +571,40 @@ const Order *OrderList::GetNextDecisionNode(const Order *next, uint hops, CargoT
 	return next;
 }
 
+/** Maximum number of entries in the next stopping station memo of an order list before it is cleared. */
+static const size_t NEXT_STOPPING_STATION_CACHE_MAX_SIZE = 1024;
+
 /**
- * Recursively determine the next deterministic station to stop at.
+ * Determine the next deterministic station to stop at.
+ * Results of searches starting at the vehicle's current implicit order are memoised per order list,
+ * as the result only depends on the orders, the current implicit order index, the last visited station and the cargo mask.
+ * Conditional orders are not evaluated, both of their branches are followed, so they do not depend on the vehicle's state.
  * @param v The vehicle we're looking at.
  * @param CargoTypes cargo_mask Bit-set of the cargo IDs of interest. This may be 0 to ignore cargo types entirely.
  * @param first Order to start searching at or nullptr to start at cur_implicit_order_index + 1.
  * @param hops Number of orders we have already looked at.
  * @return A CargoMaskedStationIDStack of the cargo mask the result is valid for, and the next stopping station or INVALID_STATION.
  * @pre The vehicle is currently loading and v->last_station_visited is meaningful.
- * @note This function may draw a random number. Don't use it from the GUI.
  */
 CargoMaskedStationIDStack OrderList::GetNextStoppingStation(const Vehicle *v, CargoTypes cargo_mask, const Order *first, uint hops) const
+{
+	if (first != nullptr || hops != 0) return this->CalculateNextStoppingStation(v, cargo_mask, first, hops);
+
+	const NextStoppingStationCacheKey key((static_cast<uint32_t>(v->cur_implicit_order_index) << 16) | v->last_station_visited, cargo_mask);
+	auto it = this->next_stopping_station_cache.find(key);
+	if (it != this->next_stopping_station_cache.end()) return it->second;
+
+	CargoMaskedStationIDStack result = this->CalculateNextStoppingStation(v, cargo_mask, nullptr, 0);
+	if (this->next_stopping_station_cache.size() >= NEXT_STOPPING_STATION_CACHE_MAX_SIZE) this->next_stopping_station_cache.clear();
+	this->next_stopping_station_cache.insert({ key, result });
+	return result;
+}
+
+/**
+ * Recursively determine the next deterministic station to stop at, without using the memo.
+ * @see OrderList::GetNextStoppingStation
+ */
+CargoMaskedStationIDStack OrderList::CalculateNextStoppingStation(const Vehicle *v, CargoTypes cargo_mask, const Order *first, uint hops) const
 {
 	static std::vector<bool> seen_orders_container;
 	if (hops == 0) {
@@ -630,9 +655,9 @@ CargoMaskedStationIDStack OrderList::GetNextStoppingStation(const Vehicle *v, Ca
 			} else if (skip_to == nullptr || skip_to == first || seen_order(skip_to)) {
 				next = (advance == first) ? nullptr : advance;
 			} else {
-				CargoMaskedStationIDStack st1 = this->GetNextStoppingStation(v, cargo_mask, skip_to, hops);
+				CargoMaskedStationIDStack st1 = this->CalculateNextStoppingStation(v, cargo_mask, skip_to, hops);
 				cargo_mask &= st1.cargo_mask;
-				CargoMaskedStationIDStack st2 = this->GetNextStoppingStation(v, cargo_mask, advance, hops);
+				CargoMaskedStationIDStack st2 = this->CalculateNextStoppingStation(v, cargo_mask, advance, hops);
 				st1.cargo_mask &= st2.cargo_mask;
 				while (!st2.station.IsEmpty()) st1.station.Push(st2.station.Pop());
 				return st1;
@@ -671,6 +696,7 @@ void OrderList::InsertOrderAt(Order &&ins_order, VehicleOrderID index)
 	}
 
 	Order *new_order = &*this->orders.emplace(this->orders.begin() + index, std::move(ins_order));
+	this->OnScheduleChanged();
 
 	if (!new_order->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 	if (!new_order->IsType(OT_CONDITIONAL)) {
@@ -709,6 +735,7 @@ void OrderList::DeleteOrderAt(VehicleOrderID index)
 	to_remove->InvalidateGuiOnRemove();
 
 	this->orders.erase(this->orders.begin() + index);
+	this->OnScheduleChanged();
 }
 
 /**
@@ -729,6 +756,7 @@ void OrderList::MoveOrder(VehicleOrderID from, VehicleOrderID to)
 		const auto it = this->orders.begin();
 		std::rotate(it + to, it + from, it + from + 1);
 	}
+	this->OnScheduleChanged();
 }
 
 /**
@@ -1734,6 +1762,7 @@ CommandCost CmdReverseOrderList(DoCommandFlag flags, VehicleID veh, ReverseOrder
 				if (flags & DC_EXEC) {
 					Order *order = v->orders->GetOrderAt(order_count);
 					order->SetRefit(new_order.GetRefitCargo());
+					v->orders->OnScheduleChanged();
 					order->SetMaxSpeed(new_order.GetMaxSpeed());
 					SetOrderFixedWaitTime(v, order_count, new_order.GetWaitTime(), wait_timetabled, wait_fixed);
 				}
@@ -2124,6 +2153,8 @@ CommandCost CmdModifyOrder(DoCommandFlag flags, VehicleID veh, VehicleOrderID se
 	}
 
 	if (flags & DC_EXEC) {
+		v->orders->OnScheduleChanged();
+
 		switch (mof) {
 			case MOF_NON_STOP:
 				order->SetNonStopType((OrderNonStopFlags)data);
@@ -2798,6 +2829,7 @@ CommandCost CmdOrderRefit(DoCommandFlag flags, VehicleID veh, VehicleOrderID ord
 
 	if (flags & DC_EXEC) {
 		order->SetRefit(cargo);
+		v->orders->OnScheduleChanged();
 
 		/* Make the depot order an 'always go' order. */
 		if (cargo != CARGO_NO_REFIT && order->IsType(OT_GOTO_DEPOT)) {
@@ -3991,6 +4023,7 @@ CommandCost CmdMassChangeOrder(DoCommandFlag flags, DestinationID from_dest, Veh
 
 							order = v->orders->GetOrderAt(index);
 							order->SetRefit(new_order.GetRefitCargo());
+							v->orders->OnScheduleChanged();
 							order->SetMaxSpeed(new_order.GetMaxSpeed());
 							SetOrderFixedWaitTime(v, index, new_order.GetWaitTime(), wait_timetabled, wait_fixed);
 						}
@@ -24,79 +24,71 @@
 #include "../stdafx.h"
 #include "../core/alloc_func.hpp"
 #include "aystar.h"
+#include "../map_func.h"
 
 #include "../safeguards.h"
 #include "../core/mem_func.hpp"
 
 /**
- * This looks in the hash whether a node exists in the closed list.
- * @param node Node to search.
- * @return The #PathNode if it is available, else \c nullptr
+ * Get the slot of the flat node store holding the first node record of a tile.
+ * The tile page is allocated or reset on first use in the current search.
+ * @param tile Tile to look up.
+ * @return Pointer to the slot, UINT32_MAX in the slot means no records.
  */
-PathNode *AyStar::ClosedListIsInList(const AyStarNode *node)
+uint32_t *AyStar::GetTileSlot(TileIndex tile)
 {
-	const auto result = this->closedlist_hash.find(this->HashKey(node->tile, node->direction));
-
-	return (result == this->closedlist_hash.end()) ? nullptr : this->closedlist_nodes[result->second];
-}
-
-/**
- * This adds a node to the closed list.
- * It makes a copy of the data.
- * @param node Node to add to the closed list.
- */
-void AyStar::ClosedListAdd(const PathNode *node)
-{
-	/* Add a node to the ClosedList */
-	std::pair<uint32_t, PathNode *> new_node = this->closedlist_nodes.Allocate();
-	*(new_node.second) = *node;
-
-	this->closedlist_hash[this->HashKey(node->node.tile, node->node.direction)] = new_node.first;
-}
+	const uint page = tile.base() >> TILE_PAGE_BITS;
+	if (page >= this->tile_pages.size()) {
+		this->tile_pages.resize(page + 1);
+		this->tile_page_generation.resize(page + 1);
+	}
 
-/**
- * Check whether a node is in the open list.
- * @param node Node to search.
- * @return If the node is available, it is returned, else \c UINT32_MAX is returned.
- */
-uint32_t AyStar::OpenListIsInList(const AyStarNode *node)
-{
-	const auto result = this->openlist_hash.find(this->HashKey(node->tile, node->direction));
+	std::unique_ptr<uint32_t[]> &tile_page = this->tile_pages[page];
+	if (tile_page == nullptr) {
+		tile_page.reset(new uint32_t[TILE_PAGE_SIZE]);
+		this->tile_page_generation[page] = this->generation - 1;
+	}
+	if (this->tile_page_generation[page] != this->generation) {
+		std::fill_n(tile_page.get(), TILE_PAGE_SIZE, UINT32_MAX);
+		this->tile_page_generation[page] = this->generation;
+	}
 
-	return (result == this->openlist_hash.end()) ? UINT32_MAX : result->second;
+	return &tile_page[tile.base() & (TILE_PAGE_SIZE - 1)];
 }
 
 /**
- * Gets the best node from the open list.
- * It deletes the returned node from the open list.
- * @returns the best node available, or \c nullptr of none is found.
+ * Find the node record of a tile and direction.
+ * @param slot Tile slot, as returned by #GetTileSlot.
+ * @param td Direction of the node.
+ * @return Index and pointer of the record, or UINT32_MAX and \c nullptr if there is no such node.
  */
-std::pair<uint32_t, OpenListNode *> AyStar::OpenListPop()
+std::pair<uint32_t, AyStar::NodeRecord *> AyStar::FindNode(uint32_t *slot, Trackdir td)
 {
-	/* Return the item the Queue returns.. the best next OpenList item. */
-	uint32_t idx = this->openlist_queue.Pop();
-	if (idx == UINT32_MAX) return std::pair<uint32_t, OpenListNode *>(idx, nullptr);
-
-	OpenListNode *res = this->openlist_nodes[idx];
-	this->openlist_hash.erase(this->HashKey(res->path.node.tile, res->path.node.direction));
-
-	return std::make_pair(idx, res);
+	for (uint32_t idx = *slot; idx != UINT32_MAX;) {
+		NodeRecord *record = this->nodes[idx];
+		if (record->node.path.node.direction == td) return std::make_pair(idx, record);
+		idx = record->next_in_tile;
+	}
+	return std::pair<uint32_t, NodeRecord *>(UINT32_MAX, nullptr);
 }
 
 /**
  * Adds a node to the open list.
  * It makes a copy of node, and puts the pointer of parent in the struct.
+ * @param slot Tile slot of the node, as returned by #GetTileSlot.
  */
-void AyStar::OpenListAdd(PathNode *parent, const AyStarNode *node, int f, int g)
+void AyStar::OpenListAdd(uint32_t *slot, PathNode *parent, const AyStarNode *node, int f, int g)
 {
 	/* Add a new Node to the OpenList */
 	uint32_t idx;
-	OpenListNode *new_node;
-	std::tie(idx, new_node) = this->openlist_nodes.Allocate();
-	new_node->g = g;
-	new_node->path.parent = parent;
-	new_node->path.node = *node;
-	this->openlist_hash[this->HashKey(node->tile, node->direction)] = idx;
+	NodeRecord *new_node;
+	std::tie(idx, new_node) = this->nodes.Allocate();
+	new_node->node.g = g;
+	new_node->node.path.parent = parent;
+	new_node->node.path.node = *node;
+	new_node->closed = false;
+	new_node->next_in_tile = *slot;
+	*slot = idx;
 
 	/* Add it to the queue */
 	this->openlist_queue.Push(idx, f);
@@ -104,14 +96,17 @@ void AyStar::OpenListAdd(PathNode *parent, const AyStarNode *node, int f, int g)
 
 /**
  * Checks one tile and calculate its f-value
+ * @param parent Expanded node, this must be a node of this %AyStar.
  */
 void AyStar::CheckTile(AyStarNode *current, OpenListNode *parent)
 {
 	int new_f, new_g, new_h;
-	PathNode *closedlist_parent;
+
+	uint32_t *slot = this->GetTileSlot(current->tile);
+	auto [check_idx, check] = this->FindNode(slot, current->direction);
 
 	/* Check the new node against the ClosedList */
-	if (this->ClosedListIsInList(current) != nullptr) return;
+	if (check != nullptr && check->closed) return;
 
 	/* Calculate the G-value for this node */
 	new_g = this->CalculateG(this, current, parent);
@@ -132,26 +127,20 @@ void AyStar::CheckTile(AyStarNode *current, OpenListNode *parent)
 	/* The f-value if g + h */
 	new_f = new_g + new_h;
 
-	/* Get the pointer to the parent in the ClosedList (the current one is to a copy of the one in the OpenList) */
-	closedlist_parent = this->ClosedListIsInList(&parent->path.node);
-
 	/* Check if this item is already in the OpenList */
-	uint32_t check_idx = this->OpenListIsInList(current);
-	if (check_idx != UINT32_MAX) {
-		OpenListNode *check = this->openlist_nodes[check_idx];
-
+	if (check != nullptr) {
 		/* Yes, check if this g value is lower.. */
-		if (new_g >= check->g) return;
-		this->openlist_queue.Delete(check_idx, 0);
+		if (new_g >= check->node.g) return;
+		this->openlist_queue.Delete(check_idx);
 
 		/* It is lower, so change it to this item */
-		check->g = new_g;
-		check->path.parent = closedlist_parent;
+		check->node.g = new_g;
+		check->node.path.parent = &parent->path;
 		/* Re-add it in the openlist_queue. */
 		this->openlist_queue.Push(check_idx, new_f);
 	} else {
 		/* A new node, add it to the OpenList */
-		this->OpenListAdd(closedlist_parent, current, new_f, new_g);
+		this->OpenListAdd(slot, &parent->path, current, new_f, new_g);
 	}
 }
 
@@ -169,23 +158,23 @@ AyStarStatus AyStar::Loop()
 	int i;
 
 	/* Get the best node from OpenList */
-	OpenListNode *current;
-	uint32_t current_idx;
-	std::tie(current_idx, current) = this->OpenListPop();
+	uint32_t current_idx = this->openlist_queue.Pop();
 	/* If empty, drop an error */
-	if (current == nullptr) return AyStarStatus::EmptyOpenList;
+	if (current_idx == UINT32_MAX) return AyStarStatus::EmptyOpenList;
+	NodeRecord *record = this->nodes[current_idx];
+	OpenListNode *current = &record->node;
 
 	/* Check for end node and if found, return that code */
 	if (this->EndNodeCheck(this, current) == AyStarStatus::FoundEndNode && current->path.parent != nullptr) {
 		if (this->FoundEndNode != nullptr) {
 			this->FoundEndNode(this, current);
 		}
-		this->openlist_nodes.Free(current_idx, current);
 		return AyStarStatus::FoundEndNode;
 	}
 
-	/* Add the node to the ClosedList */
-	this->ClosedListAdd(&current->path);
+	/* Move the node to the ClosedList, it stays in place so that children can point at it */
+	record->closed = true;
+	this->closed_count++;
 
 	/* Load the neighbours */
 	this->GetNeighbours(this, current);
@@ -196,10 +185,7 @@ AyStarStatus AyStar::Loop()
 		this->CheckTile(&this->neighbours[i], current);
 	}
 
-	/* Free the node */
-	this->openlist_nodes.Free(current_idx, current);
-
-	if (this->max_search_nodes != 0 && this->closedlist_hash.size() >= this->max_search_nodes) {
+	if (this->max_search_nodes != 0 && this->closed_count >= this->max_search_nodes) {
 		/* We've expanded enough nodes */
 		return AyStarStatus::LimitReached;
 	} else {
@@ -214,10 +200,10 @@ AyStarStatus AyStar::Loop()
 void AyStar::Free()
 {
 	this->openlist_queue.Free();
-	this->openlist_nodes.Clear();
-	this->openlist_hash.clear();
-	this->closedlist_nodes.Clear();
-	this->closedlist_hash.clear();
+	this->nodes.Clear();
+	this->tile_pages.clear();
+	this->tile_page_generation.clear();
+	this->closed_count = 0;
 #ifdef AYSTAR_DEBUG
 	printf("[AyStar] Memory free'd\n");
 #endif
@@ -232,12 +218,10 @@ void AyStar::Clear()
 	/* Clean the Queue. */
 	this->openlist_queue.Clear();
 
-	/* Clean the hashes */
-	this->openlist_nodes.Clear();
-	this->openlist_hash.clear();
-
-	this->closedlist_nodes.Clear();
-	this->closedlist_hash.clear();
+	/* Clean the node store, the tile pages are reset lazily when touched again */
+	this->nodes.Clear();
+	this->generation++;
+	this->closed_count = 0;
 
 #ifdef AYSTAR_DEBUG
 	printf("[AyStar] Cleared AyStar\n");
@@ -295,21 +279,18 @@ void AyStar::AddStartNode(AyStarNode *start_node, uint g)
 	printf("[AyStar] Starting A* Algorithm from node (%d, %d, %d)\n",
 		TileX(start_node->tile), TileY(start_node->tile), start_node->direction);
 #endif
-	this->OpenListAdd(nullptr, start_node, 0, g);
+	this->OpenListAdd(this->GetTileSlot(start_node->tile), nullptr, start_node, 0, g);
 }
 
 /**
  * Initialize an #AyStar. You should fill all appropriate fields before
  * calling #Init (see the declaration of #AyStar for which fields are internal).
  */
-void AyStar::Init(uint num_buckets)
+void AyStar::Init()
 {
 	MemSetT(&neighbours, 0);
-	MemSetT(&openlist_queue, 0);
 
-	/* Set up our sorting queue
-	 *  BinaryHeap allocates a block of 1024 nodes
-	 *  When that one gets full it reserves another one, till this number
-	 *  That is why it can stay this high */
-	this->openlist_queue.Init(102400);
+	/* Size the tile page table for the whole map, the pages themselves are allocated when first touched. */
+	this->tile_pages.resize((Map::Size() + TILE_PAGE_SIZE - 1) >> TILE_PAGE_BITS);
+	this->tile_page_generation.resize(this->tile_pages.size());
 }
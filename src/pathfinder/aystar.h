@@ -23,7 +23,7 @@
 #include "../track_type.h"
 
 #include "../core/pod_pool.hpp"
-#include "../3rdparty/robin_hood/robin_hood.h"
+#include <vector>
 
 static const int AYSTAR_DEF_MAX_SEARCH_NODES = 10000; ///< Reference limit for #AyStar::max_search_nodes
 
@@ -145,7 +145,7 @@ struct AyStar {
 	AyStarNode neighbours[12];
 	uint8_t num_neighbours;
 
-	void Init(uint num_buckets);
+	void Init();
 
 	/* These will contain the methods for manipulating the AyStar. Only
 	 * Main() should be called externally */
@@ -158,22 +158,27 @@ struct AyStar {
 
 protected:
 
-	inline uint32_t HashKey(TileIndex tile, Trackdir td) const { return tile.base() | (td << 28); }
+	/** Node record of the flat node store, a node is either in the open list or in the closed list. */
+	struct NodeRecord {
+		OpenListNode node;     ///< The node as seen by the callbacks, #PathNode parent pointers point into other records.
+		uint32_t next_in_tile; ///< Next record of the same tile (with a different direction), or UINT32_MAX.
+		bool closed;           ///< Whether the node has been expanded, i.e. is in the closed list.
+	};
 
-	PodPool<PathNode*, sizeof(PathNode), 8192> closedlist_nodes;
-	robin_hood::unordered_flat_map<uint32_t, uint32_t> closedlist_hash;
+	static constexpr uint TILE_PAGE_BITS = 10; ///< Number of bits of a tile index that are resolved within a tile page.
+	static constexpr uint TILE_PAGE_SIZE = 1 << TILE_PAGE_BITS; ///< Number of tiles per tile page.
 
-	BinaryHeap openlist_queue;  ///< The open queue.
+	PodPool<NodeRecord*, sizeof(NodeRecord), 8192> nodes; ///< All nodes of the current search, never freed until #Clear().
+	std::vector<std::unique_ptr<uint32_t[]>> tile_pages;  ///< Per tile the index of the first node record of that tile, allocated in pages on demand.
+	std::vector<uint32_t> tile_page_generation;           ///< Per tile page the #generation it was last reset in; stale pages are reset when touched.
+	uint32_t generation = 0;                              ///< Current search generation, incremented to clear the tile pages in constant time.
+	uint closed_count = 0;                                ///< Number of nodes in the closed list.
 
-	PodPool<OpenListNode*, sizeof(OpenListNode), 8192> openlist_nodes;
-	robin_hood::unordered_flat_map<uint32_t, uint32_t> openlist_hash;
+	BucketQueue openlist_queue;  ///< The open queue.
 
-	void OpenListAdd(PathNode *parent, const AyStarNode *node, int f, int g);
-	uint32_t OpenListIsInList(const AyStarNode *node);
-	std::pair<uint32_t, OpenListNode *> OpenListPop();
-
-	void ClosedListAdd(const PathNode *node);
-	PathNode *ClosedListIsInList(const AyStarNode *node);
+	uint32_t *GetTileSlot(TileIndex tile);
+	std::pair<uint32_t, NodeRecord *> FindNode(uint32_t *slot, Trackdir td);
+	void OpenListAdd(uint32_t *slot, PathNode *parent, const AyStarNode *node, int f, int g);
 };
 
 #endif /* AYSTAR_H */
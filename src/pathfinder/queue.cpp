@@ -5,7 +5,7 @@
  * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
  */
 
-/** @file queue.cpp Implementation of the #BinaryHeap/#Hash. */
+/** @file queue.cpp Implementation of the #BucketQueue/#Hash. */
 
 #include "../stdafx.h"
 #include "../core/alloc_func.hpp"
@@ -15,188 +15,97 @@
 
 
 /*
- * Binary Heap
- * For information, see: http://www.policyalmanac.org/games/binaryHeaps.htm
+ * Bucket queue
  */
 
-const int BinaryHeap::BINARY_HEAP_BLOCKSIZE_BITS = 10; ///< The number of elements that will be malloc'd at a time.
-const int BinaryHeap::BINARY_HEAP_BLOCKSIZE      = 1 << BinaryHeap::BINARY_HEAP_BLOCKSIZE_BITS;
-const int BinaryHeap::BINARY_HEAP_BLOCKSIZE_MASK = BinaryHeap::BINARY_HEAP_BLOCKSIZE - 1;
-
 /**
- * Clears the queue, by removing all values from it. Its state is
- * effectively reset.
+ * Adds an item to the queue.
+ * @param item Item to add, must not already be in the queue.
+ * @param priority Priority of the item, lower values are popped first.
  */
-void BinaryHeap::Clear()
+void BucketQueue::Push(uint32_t item, int priority)
 {
-	/* Free all items if needed and free all but the first blocks of memory */
-	uint i;
-
-	for (i = 0; i < this->blocks; i++) {
-		if (this->elements[i] == nullptr) {
-			/* No more allocated blocks */
-			break;
-		}
-		if (i != 0) {
-			/* Leave the first block of memory alone */
-			free(this->elements[i]);
-			this->elements[i] = nullptr;
-		}
+	if (this->buckets.empty()) {
+		this->base = priority;
+		this->cursor = 0;
+	} else if (priority < this->base) {
+		/* Non-monotone push below the first bucket, shift the buckets up */
+		const uint shift = this->base - priority;
+		this->buckets.insert(this->buckets.begin(), shift, UINT32_MAX);
+		this->cursor += shift;
+		this->base = priority;
 	}
-	this->size = 0;
-	this->blocks = 1;
-}
-
-/**
- * Frees the queue, by reclaiming all memory allocated by it. After
- * this it is no longer usable.
- */
-void BinaryHeap::Free()
-{
-	uint i;
 
-	this->Clear();
-	for (i = 0; i < this->blocks; i++) {
-		if (this->elements[i] == nullptr) break;
-		free(this->elements[i]);
-	}
-	free(this->elements);
-}
+	const uint bucket = priority - this->base;
+	if (bucket >= this->buckets.size()) this->buckets.resize(bucket + 1, UINT32_MAX);
+	if (item >= this->links.size()) this->links.resize(item + 1);
 
-/**
- * Pushes an element into the queue, at the appropriate place for the queue.
- * Requires the queue pointer to be of an appropriate type, of course.
- */
-bool BinaryHeap::Push(uint32_t item, int priority)
-{
-	if (this->size == this->max_size) return false;
-	dbg_assert(this->size < this->max_size);
-
-	if (this->elements[this->size >> BINARY_HEAP_BLOCKSIZE_BITS] == nullptr) {
-		/* The currently allocated blocks are full, allocate a new one */
-		dbg_assert((this->size & BINARY_HEAP_BLOCKSIZE_MASK) == 0);
-		this->elements[this->size >> BINARY_HEAP_BLOCKSIZE_BITS] = MallocT<BinaryHeapNode>(BINARY_HEAP_BLOCKSIZE);
-		this->blocks++;
-	}
+	Link &link = this->links[item];
+	link.prev = UINT32_MAX;
+	link.next = this->buckets[bucket];
+	link.priority = priority;
+	if (link.next != UINT32_MAX) this->links[link.next].prev = item;
+	this->buckets[bucket] = item;
 
-	/* Add the item at the end of the array */
-	BinaryHeapNode &new_item = this->GetElement(this->size + 1);
-	new_item.priority = priority;
-	new_item.item = item;
+	this->cursor = std::min(this->cursor, bucket);
 	this->size++;
-
-	/* Now we are going to check where it belongs. As long as the parent is
-	 * bigger, we switch with the parent */
-	{
-		int i = this->size;
-		while (i > 1) {
-			/* Get the parent of this object (divide by 2) */
-			int j = i / 2;
-			/* Is the parent bigger than the current, switch them */
-			BinaryHeapNode &elem_i = this->GetElement(i);
-			BinaryHeapNode &elem_j = this->GetElement(j);
-			if (elem_i.priority <= elem_j.priority) {
-				std::swap(elem_i, elem_j);
-				i = j;
-			} else {
-				/* It is not, we're done! */
-				break;
-			}
-		}
-	}
-
-	return true;
 }
 
 /**
- * Deletes the item from the queue. priority should be specified if
- * known, which speeds up the deleting for some queue's. Should be -1
- * if not known.
+ * Removes an item from the queue.
+ * @param item Item to remove, must be in the queue.
  */
-bool BinaryHeap::Delete(uint32_t item, int priority)
+void BucketQueue::Delete(uint32_t item)
 {
-	uint i = 0;
+	dbg_assert(this->size > 0);
 
-	/* First, we try to find the item.. */
-	do {
-		if (this->GetElement(i + 1).item == item) break;
-		i++;
-	} while (i < this->size);
-	/* We did not find the item, so we return false */
-	if (i == this->size) return false;
-
-	/* Now we put the last item over the current item while decreasing the size of the elements */
-	this->size--;
-	this->GetElement(i + 1) = this->GetElement(this->size + 1);
-
-	/* Now the only thing we have to do, is resort it..
-	 * On place i there is the item to be sorted.. let's start there */
-	{
-		/* Because of the fact that Binary Heap uses array from 1 to n, we need to
-		 * increase i by 1
-		 */
-		i++;
-
-		for (;;) {
-			uint j = i;
-			/* Check if we have 2 children */
-			if (2 * j + 1 <= this->size) {
-				/* Is this child smaller than the parent? */
-				if (this->GetElement(j).priority >= this->GetElement(2 * j).priority) i = 2 * j;
-				/* Yes, we _need_ to use i here, not j, because we want to have the smallest child
-				 *  This way we get that straight away! */
-				if (this->GetElement(i).priority >= this->GetElement(2 * j + 1).priority) i = 2 * j + 1;
-			/* Do we have one child? */
-			} else if (2 * j <= this->size) {
-				if (this->GetElement(j).priority >= this->GetElement(2 * j).priority) i = 2 * j;
-			}
-
-			/* One of our children is smaller than we are, switch */
-			if (i != j) {
-				std::swap(this->GetElement(i), this->GetElement(j));
-			} else {
-				/* None of our children is smaller, so we stay here.. stop :) */
-				break;
-			}
-		}
+	const Link &link = this->links[item];
+	if (link.prev != UINT32_MAX) {
+		this->links[link.prev].next = link.next;
+	} else {
+		this->buckets[link.priority - this->base] = link.next;
 	}
+	if (link.next != UINT32_MAX) this->links[link.next].prev = link.prev;
 
-	return true;
+	this->size--;
 }
 
 /**
- * Pops the first element from the queue. What exactly is the first element,
- * is defined by the exact type of queue.
+ * Pops the item with the lowest priority from the queue.
+ * @return The item, or UINT32_MAX if the queue is empty.
  */
-uint32_t BinaryHeap::Pop()
+uint32_t BucketQueue::Pop()
 {
 	if (this->size == 0) return UINT32_MAX;
 
-	/* The best item is always on top, so give that as result */
-	BinaryHeapNode result = this->GetElement(1);
-	/* And now we should get rid of this item... */
-	this->Delete(result.item, result.priority);
+	while (this->buckets[this->cursor] == UINT32_MAX) this->cursor++;
 
-	return result.item;
+	const uint32_t item = this->buckets[this->cursor];
+	this->Delete(item);
+	return item;
 }
 
 /**
- * Initializes a binary heap and allocates internal memory for maximum of
- * max_size elements
+ * Clears the queue, the allocated memory is kept for reuse.
  */
-void BinaryHeap::Init(uint max_size)
+void BucketQueue::Clear()
 {
-	this->max_size = max_size;
+	this->buckets.clear();
+	this->links.clear();
+	this->base = 0;
+	this->cursor = 0;
 	this->size = 0;
-	/* We malloc memory in block of BINARY_HEAP_BLOCKSIZE
-	 *   It autosizes when it runs out of memory */
-	this->elements = CallocT<BinaryHeapNode*>((max_size - 1) / BINARY_HEAP_BLOCKSIZE + 1);
-	this->elements[0] = MallocT<BinaryHeapNode>(BINARY_HEAP_BLOCKSIZE);
-	this->blocks = 1;
 }
 
-/* Because we don't want anyone else to bother with our defines */
-#undef BIN_HEAP_ARR
+/**
+ * Clears the queue and releases its memory.
+ */
+void BucketQueue::Free()
+{
+	this->Clear();
+	this->buckets.shrink_to_fit();
+	this->links.shrink_to_fit();
+}
 
 /*
  * Hash
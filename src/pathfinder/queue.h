@@ -5,7 +5,7 @@
  * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
  */
 
-/** @file queue.h Binary heap implementation, hash implementation. */
+/** @file queue.h Bucket queue implementation, hash implementation. */
 
 #ifndef QUEUE_H
 #define QUEUE_H
@@ -13,47 +13,49 @@
 #include "../../tile_type.h"
 #include "../../track_type.h"
 
-//#define HASH_STATS
-
+#include <vector>
 
-struct BinaryHeapNode {
-	uint32_t item;
-	int priority;
-};
+//#define HASH_STATS
 
 
 /**
- * Binary Heap.
- * For information, see: http://www.policyalmanac.org/games/binaryHeaps.htm
+ * Bucket queue.
+ * Priority queue for integer priorities, which keeps one doubly linked list of items per priority value.
+ * Push, Delete and Pop are constant time when the popped priorities are monotonically non-decreasing
+ * and lie within a bounded range, as is the case for A* with a consistent heuristic.
+ * Pushing a priority lower than the last popped one is supported, but moves the scan position back.
+ * Items are expected to be small dense indices (e.g. pool indices), they index the link table directly.
+ * Items of equal priority are popped in LIFO order. This tie order differs from the binary heap AyStar used before,
+ * so where paths of equal cost exist, rivers and public roads generated from the same seed differ from older versions.
  */
-struct BinaryHeap {
-	static const int BINARY_HEAP_BLOCKSIZE;
-	static const int BINARY_HEAP_BLOCKSIZE_BITS;
-	static const int BINARY_HEAP_BLOCKSIZE_MASK;
-
-	void Init(uint max_size);
-
-	bool Push(uint32_t item, int priority);
+struct BucketQueue {
+	void Push(uint32_t item, int priority);
 	uint32_t Pop();
-	bool Delete(uint32_t item, int priority);
+	void Delete(uint32_t item);
 	void Clear();
 	void Free();
 
 	/**
-	 * Get an element from the #elements.
-	 * @param i Element to access (starts at offset \c 1).
-	 * @return Value of the element.
+	 * Get the number of items in the queue.
+	 * @return Number of items.
 	 */
-	inline BinaryHeapNode &GetElement(uint i)
+	inline uint Size() const
 	{
-		dbg_assert(i > 0);
-		return this->elements[(i - 1) >> BINARY_HEAP_BLOCKSIZE_BITS][(i - 1) & BINARY_HEAP_BLOCKSIZE_MASK];
+		return this->size;
 	}
 
-	uint max_size;
-	uint size;
-	uint blocks; ///< The amount of blocks for which space is reserved in elements
-	BinaryHeapNode **elements;
+private:
+	struct Link {
+		uint32_t prev;  ///< Previous item in the same bucket, or UINT32_MAX.
+		uint32_t next;  ///< Next item in the same bucket, or UINT32_MAX.
+		int priority;   ///< Priority of the item.
+	};
+
+	std::vector<uint32_t> buckets; ///< First item of each bucket, indexed by priority - base.
+	std::vector<Link> links;       ///< Bucket links, indexed by item.
+	int base = 0;                  ///< Priority of the first bucket.
+	uint cursor = 0;               ///< All buckets before this one are empty.
+	uint size = 0;                 ///< Number of items in the queue.
 };
 
 
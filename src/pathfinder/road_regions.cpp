@@ -0,0 +1,612 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /** @file road_regions.cpp Handles dividing the roads in the map into square regions to assist pathfinding. */
+
+#include "../stdafx.h"
+#include "../debug.h"
+#include "../map_func.h"
+#include "road_regions.h"
+#include "../road.h"
+#include "../road_map.h"
+#include "../station_map.h"
+#include "../tunnelbridge_map.h"
+#include "../bridge_map.h"
+#include "../tilearea_type.h"
+
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "../safeguards.h"
+
+using RoadRegionValidBlockT = size_t;
+static constexpr uint ROAD_REGION_VALID_BLOCK_BITS = std::numeric_limits<RoadRegionValidBlockT>::digits;
+
+using TRoadRegionTraversabilityBits = uint16_t;
+constexpr TRoadRegionPatchLabel FIRST_ROAD_REGION_LABEL = 1;
+
+/* Unconnected road pieces can give every tile of a region its own patch, so a label must be able to count all tiles. */
+static_assert(std::numeric_limits<TRoadRegionPatchLabel>::max() >= ROAD_REGION_NUMBER_OF_TILES);
+
+/** Number of bits of the patch label in the hash of a road region patch. */
+constexpr uint ROAD_REGION_PATCH_LABEL_HASH_BITS = 9;
+static_assert((1 << ROAD_REGION_PATCH_LABEL_HASH_BITS) > ROAD_REGION_NUMBER_OF_TILES);
+static_assert(MAX_MAP_TILES_BITS - (2 * ROAD_REGION_EDGE_LENGTH_LOG) + ROAD_REGION_PATCH_LABEL_HASH_BITS <= 32);
+
+static_assert(sizeof(TRoadRegionTraversabilityBits) * 8 == ROAD_REGION_EDGE_LENGTH);
+
+static inline uint32_t GetRoadRegionX(TileIndex tile) { return TileX(tile) / ROAD_REGION_EDGE_LENGTH; }
+static inline uint32_t GetRoadRegionY(TileIndex tile) { return TileY(tile) / ROAD_REGION_EDGE_LENGTH; }
+
+static inline uint32_t GetRoadRegionMapSizeX() { return Map::SizeX() / ROAD_REGION_EDGE_LENGTH; }
+static inline uint32_t GetRoadRegionMapSizeY() { return Map::SizeY() / ROAD_REGION_EDGE_LENGTH; }
+
+static inline uint32_t GetRoadRegionYShift() { return Map::LogX() - ROAD_REGION_EDGE_LENGTH_LOG; }
+
+static inline TRoadRegionIndex GetRoadRegionIndex(uint32_t region_x, uint32_t region_y) { return (region_y << GetRoadRegionYShift()) + region_x; }
+static inline TRoadRegionIndex GetRoadRegionIndex(TileIndex tile) { return GetRoadRegionIndex(GetRoadRegionX(tile), GetRoadRegionY(tile)); }
+
+/**
+ * Get the road bits of a tile which connect it to its direct neighbours, for the purpose of road region connectivity.
+ * This deliberately ignores road works, one-way roads, road types and owners: road regions only describe the layout,
+ * so that they do not need to be invalidated by anything other than construction and removal of road pieces.
+ * The entrance of a tunnel or bridge is not included, this is handled separately.
+ * @param tile The tile to check.
+ * @param rtt Road or tram.
+ * @return The connecting road bits.
+ */
+static RoadBits GetRoadRegionRoadBits(TileIndex tile, RoadTramType rtt)
+{
+	switch (GetTileType(tile)) {
+		case MP_ROAD:
+			if (!HasTileRoadType(tile, rtt)) return ROAD_NONE;
+			switch (GetRoadTileType(tile)) {
+				case ROAD_TILE_NORMAL: return GetRoadBits(tile, rtt);
+				case ROAD_TILE_CROSSING: return GetCrossingRoadBits(tile);
+				case ROAD_TILE_DEPOT: return DiagDirToRoadBits(GetRoadDepotDirection(tile));
+				default: NOT_REACHED();
+			}
+
+		case MP_STATION:
+			if (!IsAnyRoadStop(tile) || !HasTileRoadType(tile, rtt)) return ROAD_NONE;
+			if (IsDriveThroughStopTile(tile)) return AxisToRoadBits(GetDriveThroughStopAxis(tile));
+			return DiagDirToRoadBits(GetBayRoadStopDir(tile));
+
+		case MP_TUNNELBRIDGE: {
+			if (GetTunnelBridgeTransportType(tile) != TRANSPORT_ROAD || !HasTileRoadType(tile, rtt)) return ROAD_NONE;
+			const DiagDirection dir = GetTunnelBridgeDirection(tile);
+			if (IsTunnel(tile)) return DiagDirToRoadBits(ReverseDiagDir(dir));
+			return GetCustomBridgeHeadRoadBits(tile, rtt) & ~DiagDirToRoadBits(dir);
+		}
+
+		default:
+			return ROAD_NONE;
+	}
+}
+
+/**
+ * Check whether a tile is the end of a road tunnel or bridge with the given road/tram type.
+ * @param tile The tile to check.
+ * @param rtt Road or tram.
+ * @return True if the tile is a tunnel or bridge end which can be passed by \p rtt.
+ */
+static inline bool IsRoadRegionTunnelBridgeTile(TileIndex tile, RoadTramType rtt)
+{
+	return IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeTransportType(tile) == TRANSPORT_ROAD && HasTileRoadType(tile, rtt);
+}
+
+/**
+ * Get the tile adjacent to a tile which is reached by leaving it in the given direction, if the road connects both tiles.
+ * @param tile The tile to leave.
+ * @param dir The direction to leave the tile in.
+ * @param rtt Road or tram.
+ * @return The adjacent tile, or INVALID_TILE if the road does not connect.
+ */
+static TileIndex GetConnectedRoadNeighbour(TileIndex tile, DiagDirection dir, RoadTramType rtt)
+{
+	const TileIndexDiffC offset = TileIndexDiffCByDiagDir(dir);
+	/* Unsigned underflow is allowed here, not UB */
+	const uint x = TileX(tile) + (uint)offset.x;
+	const uint y = TileY(tile) + (uint)offset.y;
+	if (x >= Map::SizeX() || y >= Map::SizeY()) return INVALID_TILE;
+
+	const TileIndex neighbour = TileXY(x, y);
+	if ((GetRoadRegionRoadBits(neighbour, rtt) & DiagDirToRoadBits(ReverseDiagDir(dir))) == 0) return INVALID_TILE;
+	return neighbour;
+}
+
+struct RoadRegionTileIterator {
+	uint32_t x;
+	uint32_t y;
+
+	inline operator TileIndex () const
+	{
+		return TileXY(this->x, this->y);
+	}
+
+	inline TileIndex operator *() const
+	{
+		return TileXY(this->x, this->y);
+	}
+
+	RoadRegionTileIterator& operator ++()
+	{
+		this->x++;
+		if ((this->x & ROAD_REGION_EDGE_MASK) == 0) {
+			/* reached end of row */
+			this->x -= ROAD_REGION_EDGE_LENGTH;
+			this->y++;
+		}
+		return *this;
+	}
+
+	bool operator==(const RoadRegionTileIterator&) const = default;
+};
+
+using TRoadRegionPatchLabelArray = std::array<TRoadRegionPatchLabel, ROAD_REGION_NUMBER_OF_TILES>;
+
+/**
+ * Represents a square section of the map of a fixed size. Within this square individual unconnected patches of road are
+ * identified using a Connected Component Labeling (CCL) algorithm, in the same way as for water regions.
+ * Road and tram have their own, independent, sets of road regions.
+ * @see WaterRegion
+ */
+class RoadRegion
+{
+	friend class RoadRegionReference;
+
+	std::array<TRoadRegionTraversabilityBits, DIAGDIR_END> edge_traversability_bits{};
+	bool has_cross_region_tunnelbridges = false;
+	TRoadRegionPatchLabel number_of_patches = 0; // 0 = no road, 1 = one single patch of road, etc...
+	std::unique_ptr<TRoadRegionPatchLabelArray> tile_patch_labels;
+};
+
+static std::unique_ptr<RoadRegion[]> _road_regions[2];
+static std::unique_ptr<RoadRegionValidBlockT[]> _is_road_region_valid[2];
+static std::unique_ptr<TRoadRegionPatchLabelArray> _spare_road_labels;
+
+class RoadRegionReference {
+	const uint32_t tile_x;
+	const uint32_t tile_y;
+	const TRoadRegionIndex region_id;
+	const RoadTramType rtt;
+	RoadRegion &rr;
+
+	inline bool ContainsTile(TileIndex tile) const
+	{
+		const uint32_t x = TileX(tile);
+		const uint32_t y = TileY(tile);
+		return x >= this->tile_x && x < this->tile_x + ROAD_REGION_EDGE_LENGTH
+				&& y >= this->tile_y && y < this->tile_y + ROAD_REGION_EDGE_LENGTH;
+	}
+
+	/**
+	 * Returns the local index of the tile within the region.
+	 * @param tile Tile within the road region.
+	 * @returns The local index.
+	 * @see WaterRegionReference::GetLocalIndex
+	 */
+	inline int GetLocalIndex(TileIndex tile) const
+	{
+		assert(this->ContainsTile(tile));
+		return (TileX(tile) - this->tile_x) + ROAD_REGION_EDGE_LENGTH * (TileY(tile) - this->tile_y);
+	}
+
+	inline bool HasNonMatchingPatchLabel(TRoadRegionPatchLabel expected_label) const
+	{
+		for (TRoadRegionPatchLabel label : *this->rr.tile_patch_labels) {
+			if (label != expected_label) return true;
+		}
+		return false;
+	}
+
+	inline RoadRegionValidBlockT &GetValidBlock() const
+	{
+		return _is_road_region_valid[this->rtt][this->region_id / ROAD_REGION_VALID_BLOCK_BITS];
+	}
+
+public:
+	RoadRegionReference(uint32_t region_x, uint32_t region_y, RoadTramType rtt)
+		: tile_x(region_x * ROAD_REGION_EDGE_LENGTH), tile_y(region_y * ROAD_REGION_EDGE_LENGTH), region_id(GetRoadRegionIndex(region_x, region_y)),
+		rtt(rtt), rr(_road_regions[rtt][this->region_id])
+	{}
+
+	RoadRegionTileIterator begin() const { return { this->tile_x, this->tile_y }; }
+	RoadRegionTileIterator end() const { return { this->tile_x, this->tile_y + ROAD_REGION_EDGE_LENGTH }; }
+
+	bool IsInitialized() const { return HasBit(this->GetValidBlock(), this->region_id % ROAD_REGION_VALID_BLOCK_BITS); }
+
+	/**
+	 * Mark the region as valid.
+	 * @return True if the region was not valid before, and so needs to be updated.
+	 */
+	bool MarkedValid()
+	{
+		RoadRegionValidBlockT &block = this->GetValidBlock();
+		if (HasBit(block, this->region_id % ROAD_REGION_VALID_BLOCK_BITS)) return false;
+
+		SetBit(block, this->region_id % ROAD_REGION_VALID_BLOCK_BITS);
+		return true;
+	}
+
+	/**
+	 * Returns a set of bits indicating whether an edge tile on a particular side is traversable or not.
+	 * @param side Which side of the region we want to know the edge traversability of.
+	 * @returns A value holding the edge traversability bits.
+	 */
+	TRoadRegionTraversabilityBits GetEdgeTraversabilityBits(DiagDirection side) const { return this->rr.edge_traversability_bits[side]; }
+
+	/**
+	 * @returns The amount of individual road patches present within the road region. A value of
+	 * 0 means there is no road present in the road region at all.
+	 */
+	int NumberOfPatches() const { return static_cast<int>(this->rr.number_of_patches); }
+
+	/**
+	 * @returns Whether the road region contains tunnels or bridges that cross the region boundaries.
+	 */
+	bool HasCrossRegionTunnelBridges() const { return this->rr.has_cross_region_tunnelbridges; }
+
+	/**
+	 * Returns the patch label that was assigned to the tile.
+	 * @param tile The tile of which we want to retrieve the label.
+	 * @returns The label assigned to the tile.
+	 */
+	TRoadRegionPatchLabel GetLabel(TileIndex tile) const
+	{
+		assert(this->ContainsTile(tile));
+		if (this->rr.tile_patch_labels == nullptr) {
+			return this->NumberOfPatches() == 0 ? INVALID_ROAD_REGION_PATCH : FIRST_ROAD_REGION_LABEL;
+		}
+		return (*this->rr.tile_patch_labels)[this->GetLocalIndex(tile)];
+	}
+
+	/**
+	 * Performs the connected component labeling and other data gathering.
+	 * @see RoadRegion
+	 */
+	void ForceUpdate()
+	{
+		this->rr.has_cross_region_tunnelbridges = false;
+
+		if (this->rr.tile_patch_labels == nullptr) {
+			if (_spare_road_labels != nullptr) {
+				this->rr.tile_patch_labels = std::move(_spare_road_labels);
+			} else {
+				this->rr.tile_patch_labels = std::make_unique<TRoadRegionPatchLabelArray>();
+			}
+		}
+
+		this->rr.tile_patch_labels->fill(INVALID_ROAD_REGION_PATCH);
+		this->rr.edge_traversability_bits.fill(0);
+
+		TRoadRegionPatchLabel current_label = FIRST_ROAD_REGION_LABEL;
+		TRoadRegionPatchLabel highest_assigned_label = INVALID_ROAD_REGION_PATCH;
+
+		/* Perform connected component labeling. This uses a flooding algorithm that expands until no
+		 * additional tiles can be added. Only tiles inside the road region are considered. */
+		for (const TileIndex start_tile : *this) {
+			static std::vector<TileIndex> tiles_to_check;
+			tiles_to_check.clear();
+			tiles_to_check.push_back(start_tile);
+
+			bool increase_label = false;
+			while (!tiles_to_check.empty()) {
+				const TileIndex tile = tiles_to_check.back();
+				tiles_to_check.pop_back();
+
+				const bool is_tunnelbridge = IsRoadRegionTunnelBridgeTile(tile, this->rtt);
+				const RoadBits bits = GetRoadRegionRoadBits(tile, this->rtt);
+				if (bits == ROAD_NONE && !is_tunnelbridge) continue;
+
+				TRoadRegionPatchLabel &tile_patch = (*this->rr.tile_patch_labels)[this->GetLocalIndex(tile)];
+				if (tile_patch != INVALID_ROAD_REGION_PATCH) continue;
+
+				tile_patch = current_label;
+				highest_assigned_label = current_label;
+				increase_label = true;
+
+				if (is_tunnelbridge) {
+					const TileIndex other_end = GetOtherTunnelBridgeEnd(tile);
+					if (this->ContainsTile(other_end)) {
+						tiles_to_check.push_back(other_end);
+					} else {
+						this->rr.has_cross_region_tunnelbridges = true;
+					}
+				}
+
+				for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+					if ((bits & DiagDirToRoadBits(dir)) == 0) continue;
+
+					const TileIndex neighbour = GetConnectedRoadNeighbour(tile, dir, this->rtt);
+					if (neighbour == INVALID_TILE) continue;
+
+					if (this->ContainsTile(neighbour)) {
+						tiles_to_check.push_back(neighbour);
+					} else {
+						const int local_x_or_y = DiagDirToAxis(dir) == AXIS_X ? TileY(tile) - this->tile_y : TileX(tile) - this->tile_x;
+						SetBit(this->rr.edge_traversability_bits[dir], local_x_or_y);
+					}
+				}
+			}
+
+			if (increase_label) current_label++;
+		}
+
+		this->rr.number_of_patches = highest_assigned_label;
+
+		if (this->rr.number_of_patches == 0 || (this->rr.number_of_patches == 1 && !this->HasNonMatchingPatchLabel(FIRST_ROAD_REGION_LABEL))) {
+			/* No need for patch storage: trivial cases */
+			_spare_road_labels = std::move(this->rr.tile_patch_labels);
+		}
+	}
+
+	TRoadRegionPatchLabelArray CopyPatchLabelArray() const
+	{
+		TRoadRegionPatchLabelArray out;
+		if (this->rr.tile_patch_labels != nullptr) {
+			out = *this->rr.tile_patch_labels;
+		} else {
+			out.fill(this->NumberOfPatches() == 0 ? INVALID_ROAD_REGION_PATCH : FIRST_ROAD_REGION_LABEL);
+		}
+		return out;
+	}
+};
+
+static TileIndex GetTileIndexFromLocalCoordinate(uint32_t region_x, uint32_t region_y, uint32_t local_x, uint32_t local_y)
+{
+	assert(local_x < ROAD_REGION_EDGE_LENGTH);
+	assert(local_y < ROAD_REGION_EDGE_LENGTH);
+	return TileXY(ROAD_REGION_EDGE_LENGTH * region_x + local_x, ROAD_REGION_EDGE_LENGTH * region_y + local_y);
+}
+
+static TileIndex GetEdgeTileCoordinate(uint32_t region_x, uint32_t region_y, DiagDirection side, uint32_t x_or_y)
+{
+	assert(x_or_y < ROAD_REGION_EDGE_LENGTH);
+	switch (side) {
+		case DIAGDIR_NE: return GetTileIndexFromLocalCoordinate(region_x, region_y, 0, x_or_y);
+		case DIAGDIR_SW: return GetTileIndexFromLocalCoordinate(region_x, region_y, ROAD_REGION_EDGE_LENGTH - 1, x_or_y);
+		case DIAGDIR_NW: return GetTileIndexFromLocalCoordinate(region_x, region_y, x_or_y, 0);
+		case DIAGDIR_SE: return GetTileIndexFromLocalCoordinate(region_x, region_y, x_or_y, ROAD_REGION_EDGE_LENGTH - 1);
+		default: NOT_REACHED();
+	}
+}
+
+static RoadRegionReference GetUpdatedRoadRegion(uint32_t region_x, uint32_t region_y, RoadTramType rtt)
+{
+	RoadRegionReference ref(region_x, region_y, rtt);
+	if (ref.MarkedValid()) ref.ForceUpdate();
+	return ref;
+}
+
+static RoadRegionReference GetUpdatedRoadRegion(TileIndex tile, RoadTramType rtt)
+{
+	return GetUpdatedRoadRegion(GetRoadRegionX(tile), GetRoadRegionY(tile), rtt);
+}
+
+/**
+ * Returns the index of the road region.
+ * @param road_region The road region to return the index for.
+ */
+TRoadRegionIndex GetRoadRegionIndex(const RoadRegionDesc &road_region)
+{
+	return GetRoadRegionIndex(road_region.x, road_region.y);
+}
+
+/**
+ * Calculates a number that uniquely identifies the provided road region patch.
+ * @param road_region_patch The road region to calculate the hash for.
+ */
+uint32_t CalculateRoadRegionPatchHash(const RoadRegionPatchDesc &road_region_patch)
+{
+	return road_region_patch.label | GetRoadRegionIndex(road_region_patch) << ROAD_REGION_PATCH_LABEL_HASH_BITS;
+}
+
+/**
+ * Returns basic road region information for the provided tile.
+ * @param tile The tile for which the information will be calculated.
+ */
+RoadRegionDesc GetRoadRegionInfo(TileIndex tile)
+{
+	return RoadRegionDesc{ GetRoadRegionX(tile), GetRoadRegionY(tile) };
+}
+
+/**
+ * Returns basic road region patch information for the provided tile.
+ * @param tile The tile for which the information will be calculated.
+ * @param rtt Road or tram.
+ */
+RoadRegionPatchDesc GetRoadRegionPatchInfo(TileIndex tile, RoadTramType rtt)
+{
+	RoadRegionReference region = GetUpdatedRoadRegion(tile, rtt);
+	return RoadRegionPatchDesc{ GetRoadRegionX(tile), GetRoadRegionY(tile), region.GetLabel(tile) };
+}
+
+static void InvalidateRoadRegionIndex(TRoadRegionIndex region)
+{
+	for (RoadTramType rtt : _roadtramtypes) {
+		ClrBit(_is_road_region_valid[rtt][region / ROAD_REGION_VALID_BLOCK_BITS], region % ROAD_REGION_VALID_BLOCK_BITS);
+	}
+}
+
+/**
+ * Marks the road regions (for both road and tram) that tile is part of as invalid.
+ * This must be called whenever a road piece is built or removed, as the road regions are used by the road vehicle pathfinder.
+ * @param tile Tile within the road region that we wish to invalidate.
+ */
+void InvalidateRoadRegion(TileIndex tile)
+{
+	if (tile >= Map::Size()) return;
+
+	const TRoadRegionIndex region = GetRoadRegionIndex(tile);
+	InvalidateRoadRegionIndex(region);
+
+	/* When updating the road region we look into the first tile of adjacent road regions to determine edge
+	 * traversability. This means that if we invalidate any region edge tiles we might also change the traversability
+	 * of the adjacent region. This code ensures the adjacent regions also get invalidated in such a case. */
+	const uint x = TileX(tile);
+	const uint y = TileY(tile);
+	if ((x & ROAD_REGION_EDGE_MASK) ==                     0 && x >         0) InvalidateRoadRegionIndex(region - 1);
+	if ((x & ROAD_REGION_EDGE_MASK) == ROAD_REGION_EDGE_MASK && x < Map::MaxX()) InvalidateRoadRegionIndex(region + 1);
+	if ((y & ROAD_REGION_EDGE_MASK) ==                     0 && y >         0) InvalidateRoadRegionIndex(region - GetRoadRegionMapSizeX());
+	if ((y & ROAD_REGION_EDGE_MASK) == ROAD_REGION_EDGE_MASK && y < Map::MaxY()) InvalidateRoadRegionIndex(region + GetRoadRegionMapSizeX());
+}
+
+/**
+ * Marks the road regions of all tiles in the rectangle spanned by two tiles as invalid.
+ * @param start First corner tile.
+ * @param end Opposite corner tile.
+ * @see InvalidateRoadRegion
+ */
+void InvalidateRoadRegions(TileIndex start, TileIndex end)
+{
+	if (start == end) {
+		InvalidateRoadRegion(start);
+		return;
+	}
+
+	for (TileIndex tile : TileArea(start, end)) InvalidateRoadRegion(tile);
+}
+
+/**
+ * Calls the provided callback function for all road region patches
+ * accessible from one particular side of the starting patch.
+ * @param road_region_patch Road patch within the road region to start searching from
+ * @param rtt Road or tram.
+ * @param side Side of the road region to look for neighbouring patches of road
+ * @param callback The function that will be called for each neighbour that is found
+ */
+static inline void VisitAdjacentRoadRegionPatchNeighbours(const RoadRegionPatchDesc &road_region_patch, RoadTramType rtt, DiagDirection side, TVisitRoadRegionPatchCallBack &func)
+{
+	const RoadRegionReference current_region = GetUpdatedRoadRegion(road_region_patch.x, road_region_patch.y, rtt);
+
+	const TileIndexDiffC offset = TileIndexDiffCByDiagDir(side);
+	/* Unsigned underflow is allowed here, not UB */
+	const uint32_t nx = road_region_patch.x + (uint32_t)offset.x;
+	const uint32_t ny = road_region_patch.y + (uint32_t)offset.y;
+
+	if (nx >= GetRoadRegionMapSizeX() || ny >= GetRoadRegionMapSizeY()) return;
+
+	if (current_region.GetEdgeTraversabilityBits(side) == 0) return;
+
+	const RoadRegionReference neighbouring_region = GetUpdatedRoadRegion(nx, ny, rtt);
+	const DiagDirection opposite_side = ReverseDiagDir(side);
+
+	/* Indicates via which local x or y coordinates (depends on the "side" parameter) we can cross over into the adjacent region. */
+	const TRoadRegionTraversabilityBits traversability_bits = current_region.GetEdgeTraversabilityBits(side)
+		& neighbouring_region.GetEdgeTraversabilityBits(opposite_side);
+	if (traversability_bits == 0) return;
+
+	if (current_region.NumberOfPatches() == 1 && neighbouring_region.NumberOfPatches() == 1) {
+		func(RoadRegionPatchDesc{ nx, ny, FIRST_ROAD_REGION_LABEL }); // No further checks needed because we know there is just one patch for both adjacent regions
+		return;
+	}
+
+	/* Multiple road patches can be reached from the current patch. Check each edge tile individually. */
+	static std::vector<TRoadRegionPatchLabel> unique_labels; // static and vector-instead-of-map for performance reasons
+	unique_labels.clear();
+	for (uint32_t x_or_y = 0; x_or_y < ROAD_REGION_EDGE_LENGTH; ++x_or_y) {
+		if (!HasBit(traversability_bits, x_or_y)) continue;
+
+		const TileIndex current_edge_tile = GetEdgeTileCoordinate(road_region_patch.x, road_region_patch.y, side, x_or_y);
+		const TRoadRegionPatchLabel current_label = current_region.GetLabel(current_edge_tile);
+		if (current_label != road_region_patch.label) continue;
+
+		const TileIndex neighbour_edge_tile = GetEdgeTileCoordinate(nx, ny, opposite_side, x_or_y);
+		const TRoadRegionPatchLabel neighbour_label = neighbouring_region.GetLabel(neighbour_edge_tile);
+		assert(neighbour_label != INVALID_ROAD_REGION_PATCH);
+		if (std::ranges::find(unique_labels, neighbour_label) == unique_labels.end()) unique_labels.push_back(neighbour_label);
+	}
+	for (TRoadRegionPatchLabel unique_label : unique_labels) func(RoadRegionPatchDesc{ nx, ny, unique_label });
+}
+
+/**
+ * Calls the provided callback function on all accessible road region patches in
+ * each cardinal direction, plus any others that are reachable via tunnels and bridges.
+ * @param road_region_patch Road patch within the road region to start searching from
+ * @param rtt Road or tram.
+ * @param callback The function that will be called for each accessible road patch that is found
+ */
+void VisitRoadRegionPatchNeighbours(const RoadRegionPatchDesc &road_region_patch, RoadTramType rtt, TVisitRoadRegionPatchCallBack &callback)
+{
+	if (road_region_patch.label == INVALID_ROAD_REGION_PATCH) return;
+
+	const RoadRegionReference current_region = GetUpdatedRoadRegion(road_region_patch.x, road_region_patch.y, rtt);
+
+	/* Visit adjacent road region patches in each cardinal direction */
+	for (DiagDirection side = DIAGDIR_BEGIN; side < DIAGDIR_END; side++) VisitAdjacentRoadRegionPatchNeighbours(road_region_patch, rtt, side, callback);
+
+	/* Visit neighbouring road patches accessible via cross-region tunnels and bridges */
+	if (current_region.HasCrossRegionTunnelBridges()) {
+		for (const TileIndex tile : current_region) {
+			if (!IsRoadRegionTunnelBridgeTile(tile, rtt) || current_region.GetLabel(tile) != road_region_patch.label) continue;
+
+			const TileIndex other_end_tile = GetOtherTunnelBridgeEnd(tile);
+			if (GetRoadRegionIndex(tile) != GetRoadRegionIndex(other_end_tile)) callback(GetRoadRegionPatchInfo(other_end_tile, rtt));
+		}
+	}
+}
+
+static size_t GetRoadRegionValidSize()
+{
+	return CeilDivT<size_t>(GetRoadRegionMapSizeX() * GetRoadRegionMapSizeY(), ROAD_REGION_VALID_BLOCK_BITS);
+}
+
+/**
+ * Initializes all road regions. Road regions are updated lazily, when first used by the pathfinder.
+ */
+void InitializeRoadRegions()
+{
+	for (RoadTramType rtt : _roadtramtypes) {
+		_road_regions[rtt].reset(new RoadRegion[GetRoadRegionMapSizeX() * GetRoadRegionMapSizeY()]);
+		_is_road_region_valid[rtt].reset(new RoadRegionValidBlockT[GetRoadRegionValidSize()]{});
+	}
+}
+
+void RoadRegionCheckCaches(std::function<void(std::string_view)> log)
+{
+	const uint32_t size_x = GetRoadRegionMapSizeX();
+	const uint32_t size_y = GetRoadRegionMapSizeY();
+	for (RoadTramType rtt : _roadtramtypes) {
+		for (uint32_t y = 0; y < size_y; y++) {
+			for (uint32_t x = 0; x < size_x; x++) {
+				auto cclog = [&]<typename... T>(fmt::format_string<T...> fmtstr, T&&... args) {
+					format_buffer cc_buffer;
+					cc_buffer.format("Road region ({}): {} x {} to {} x {}: ", rtt == RTT_TRAM ? "tram" : "road",
+							x * ROAD_REGION_EDGE_LENGTH, y * ROAD_REGION_EDGE_LENGTH, (x * ROAD_REGION_EDGE_LENGTH) + ROAD_REGION_EDGE_MASK, (y * ROAD_REGION_EDGE_LENGTH) + ROAD_REGION_EDGE_MASK);
+					cc_buffer.format(fmtstr, std::forward<T>(args)...);
+					log(cc_buffer);
+				};
+
+				RoadRegionReference rr(x, y, rtt);
+				if (!rr.IsInitialized()) continue;
+
+				const bool old_has_cross_region_tunnelbridges = rr.HasCrossRegionTunnelBridges();
+				const int old_number_of_patches = rr.NumberOfPatches();
+				const TRoadRegionPatchLabelArray old_patch_labels = rr.CopyPatchLabelArray();
+				std::array<TRoadRegionTraversabilityBits, DIAGDIR_END> old_edge_bits;
+				for (DiagDirection side = DIAGDIR_BEGIN; side < DIAGDIR_END; side++) old_edge_bits[side] = rr.GetEdgeTraversabilityBits(side);
+
+				rr.ForceUpdate();
+
+				if (old_has_cross_region_tunnelbridges != rr.HasCrossRegionTunnelBridges()) {
+					cclog("Has cross region tunnels/bridges mismatch: {} -> {}", old_has_cross_region_tunnelbridges, rr.HasCrossRegionTunnelBridges());
+				}
+				if (old_number_of_patches != rr.NumberOfPatches()) {
+					cclog("Number of patches mismatch: {} -> {}", old_number_of_patches, rr.NumberOfPatches());
+				}
+				if (old_patch_labels != rr.CopyPatchLabelArray()) {
+					cclog("Patch label mismatch");
+				}
+				for (DiagDirection side = DIAGDIR_BEGIN; side < DIAGDIR_END; side++) {
+					if (old_edge_bits[side] != rr.GetEdgeTraversabilityBits(side)) cclog("Edge traversability mismatch: side {}", side);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /** @file road_regions.h Handles dividing the roads in the map into regions to assist pathfinding. */
+
+#ifndef ROAD_REGIONS_H
+#define ROAD_REGIONS_H
+
+#include "../tile_type.h"
+#include "../map_func.h"
+
+#include <functional>
+
+enum RoadTramType : bool;
+
+using TRoadRegionPatchLabel = uint16_t;
+using TRoadRegionIndex = uint32_t;
+
+constexpr uint32_t ROAD_REGION_EDGE_LENGTH = 16;
+constexpr uint32_t ROAD_REGION_EDGE_LENGTH_LOG = 4;
+static_assert(1 << ROAD_REGION_EDGE_LENGTH_LOG == ROAD_REGION_EDGE_LENGTH);
+
+constexpr uint32_t ROAD_REGION_EDGE_MASK = ROAD_REGION_EDGE_LENGTH - 1;
+static_assert((ROAD_REGION_EDGE_LENGTH & ROAD_REGION_EDGE_MASK) == 0);
+
+constexpr uint32_t ROAD_REGION_NUMBER_OF_TILES = ROAD_REGION_EDGE_LENGTH * ROAD_REGION_EDGE_LENGTH;
+
+constexpr TRoadRegionPatchLabel INVALID_ROAD_REGION_PATCH = 0;
+
+/**
+ * Describes a single interconnected patch of road (or tram track) within a particular road region.
+ */
+struct RoadRegionPatchDesc
+{
+	uint32_t x; ///< The X coordinate of the road region, i.e. X=2 is the 3rd road region along the X-axis
+	uint32_t y; ///< The Y coordinate of the road region, i.e. Y=2 is the 3rd road region along the Y-axis
+	TRoadRegionPatchLabel label; ///< Unique label identifying the patch within the region
+
+	bool operator==(const RoadRegionPatchDesc &other) const { return x == other.x && y == other.y && label == other.label; }
+	bool operator!=(const RoadRegionPatchDesc &other) const { return !(*this == other); }
+};
+
+/**
+ * Describes a single square road region.
+ */
+struct RoadRegionDesc
+{
+	uint32_t x; ///< The X coordinate of the road region, i.e. X=2 is the 3rd road region along the X-axis
+	uint32_t y; ///< The Y coordinate of the road region, i.e. Y=2 is the 3rd road region along the Y-axis
+
+	RoadRegionDesc(const uint32_t x, const uint32_t y) : x(x), y(y) {}
+	RoadRegionDesc(const RoadRegionPatchDesc &road_region_patch) : x(road_region_patch.x), y(road_region_patch.y) {}
+
+	bool operator==(const RoadRegionDesc &other) const { return x == other.x && y == other.y; }
+	bool operator!=(const RoadRegionDesc &other) const { return !(*this == other); }
+};
+
+uint32_t CalculateRoadRegionPatchHash(const RoadRegionPatchDesc &road_region_patch);
+TRoadRegionIndex GetRoadRegionIndex(const RoadRegionDesc &road_region);
+
+RoadRegionDesc GetRoadRegionInfo(TileIndex tile);
+RoadRegionPatchDesc GetRoadRegionPatchInfo(TileIndex tile, RoadTramType rtt);
+
+void InvalidateRoadRegion(TileIndex tile);
+void InvalidateRoadRegions(TileIndex start, TileIndex end);
+
+using TVisitRoadRegionPatchCallBack = std::function<void(const RoadRegionPatchDesc &)>;
+void VisitRoadRegionPatchNeighbours(const RoadRegionPatchDesc &road_region_patch, RoadTramType rtt, TVisitRoadRegionPatchCallBack &callback);
+
+void InitializeRoadRegions();
+
+#endif /* ROAD_REGIONS_H */
@@ -19,6 +19,7 @@
 #include "../../tracerestrict.h"
 #include "../../debug.h"
 #include "../../misc/dbg_helpers.h"
+#include "../../zone_profiler.h"
 
 #include "../../safeguards.h"
 
@@ -734,6 +735,7 @@ struct CYapfAnySafeTileRail2 : CYapfT<CYapfRail_TypesT<CYapfAnySafeTileRail2, CF
 
 Track YapfTrainChooseTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
 {
+	ZoneProfilerScope zone(ZPZ_PF_TRAIN, v->index);
 	Trackdir td_ret = _settings_game.pf.forbid_90_deg
 		? CYapfRail2::stChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest)
 		: CYapfRail1::stChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest);
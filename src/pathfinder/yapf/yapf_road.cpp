@@ -10,8 +10,10 @@
 #include "../../stdafx.h"
 #include "yapf.hpp"
 #include "yapf_node_road.hpp"
+#include "yapf_road_regions.h"
 #include "../../roadstop_base.h"
 #include "../../vehicle_func.h"
+#include "../../zone_profiler.h"
 
 #include "../../safeguards.h"
 
@@ -26,6 +28,9 @@ const uint MAX_RV_PF_TILES = 1 << 11;
 
 const int MAX_RV_LEADER_TARGETS = 4;
 
+/** Minimum Manhattan distance to the destination before the search is restricted to a corridor of road regions. */
+const uint MIN_RV_ROAD_REGION_PF_DISTANCE = 4 * ROAD_REGION_EDGE_LENGTH;
+
 template <class Types>
 class CYapfCostRoadT
 {
@@ -306,6 +311,21 @@ public:
 		return this->dest_station != INVALID_STATION ? Station::GetIfValid(this->dest_station) : nullptr;
 	}
 
+	/**
+	 * Get a lower bound of the cost of any path from a tile to the destination.
+	 * This uses the same distance measure as #PfCalcEstimate, measured from the centre of the tile.
+	 * @param tile The tile to measure from.
+	 * @return The lower bound of the path cost.
+	 */
+	inline int GetDistanceEstimate(TileIndex tile) const
+	{
+		int dx = abs(2 * (int)TileX(tile) - 2 * (int)TileX(this->dest_tile));
+		int dy = abs(2 * (int)TileY(tile) - 2 * (int)TileY(this->dest_tile));
+		int dmin = std::min(dx, dy);
+		int dxy = abs(dx - dy);
+		return dmin * YAPF_TILE_CORNER_LENGTH + std::max(dxy - 2, 0) * (YAPF_TILE_LENGTH / 2);
+	}
+
 protected:
 	/** to access inherited path finder */
 	Tpf &Yapf()
@@ -415,6 +435,8 @@ protected:
 		return *static_cast<Tpf *>(this);
 	}
 
+	std::vector<TRoadRegionIndex> road_region_corridor; ///< Sorted indices of the road regions the search is restricted to, empty if unrestricted.
+
 public:
 
 	/**
@@ -426,8 +448,50 @@ public:
 	{
 		TrackFollower F(Yapf().GetVehicle());
 		if (F.Follow(old_node.segment_last_tile, old_node.segment_last_td)) {
-			Yapf().AddMultipleNodes(&old_node, F);
+			if (this->road_region_corridor.empty()
+					|| std::ranges::binary_search(this->road_region_corridor, GetRoadRegionIndex(GetRoadRegionInfo(F.new_tile)))) {
+				Yapf().AddMultipleNodes(&old_node, F);
+			}
+		}
+	}
+
+	/**
+	 * Restricts the search to a corridor around a road region path.
+	 * Road region patches only describe connectivity within a region, and roads frequently wander across region
+	 * edges, so the direct neighbours of each region on the path are included as well.
+	 * @param path The road region path to restrict the search to.
+	 */
+	inline void RestrictSearch(const std::vector<RoadRegionPatchDesc> &path)
+	{
+		const uint32_t size_x = Map::SizeX() / ROAD_REGION_EDGE_LENGTH;
+		const uint32_t size_y = Map::SizeY() / ROAD_REGION_EDGE_LENGTH;
+
+		this->road_region_corridor.clear();
+		for (const RoadRegionPatchDesc &path_entry : path) {
+			for (uint32_t y = path_entry.y > 0 ? path_entry.y - 1 : 0; y <= std::min(path_entry.y + 1, size_y - 1); y++) {
+				for (uint32_t x = path_entry.x > 0 ? path_entry.x - 1 : 0; x <= std::min(path_entry.x + 1, size_x - 1); x++) {
+					this->road_region_corridor.push_back(GetRoadRegionIndex(RoadRegionDesc{ x, y }));
+				}
+			}
 		}
+		std::ranges::sort(this->road_region_corridor);
+		this->road_region_corridor.erase(std::unique(this->road_region_corridor.begin(), this->road_region_corridor.end()), this->road_region_corridor.end());
+	}
+
+	/**
+	 * Check whether the path found by a restricted search is within the allowed detour.
+	 * The path cost is compared with a lower bound of the cost of any path, so this also bounds
+	 * how much worse the path can be than the path found by an unrestricted search.
+	 * @param origin The origin tile of the search.
+	 * @param max_detour The maximum detour, in percent.
+	 * @return True if the best path is within the detour.
+	 */
+	inline bool IsPathWithinDetour(TileIndex origin, uint max_detour)
+	{
+		const Node *best = Yapf().GetBestNode();
+		if (best == nullptr) return false;
+		const int64_t lower_bound = Yapf().GetDistanceEstimate(origin);
+		return (int64_t)best->cost * 100 <= lower_bound * (100 + max_detour);
 	}
 
 	/** return debug report character to identify the transportation type */
@@ -436,8 +500,43 @@ public:
 		return 'r';
 	}
 
+	/**
+	 * Add the road layout regions crossed by the segment of a node, by walking it again from its first to its last tile.
+	 * @param node The node.
+	 * @param regions The region indices are appended to this.
+	 */
+	inline void AddSegmentRoadLayoutRegions(const Node &node, std::vector<uint32_t> &regions)
+	{
+		TileIndex tile = node.GetTile();
+		Trackdir trackdir = node.GetTrackdir();
+		regions.push_back(GetRoadLayoutRegion(tile));
+		for (uint tiles = 0; (tile != node.segment_last_tile || trackdir != node.segment_last_td) && tiles <= MAX_RV_PF_TILES; tiles++) {
+			TrackFollower F(Yapf().GetVehicle());
+			if (!F.Follow(tile, trackdir) || KillFirstBit(F.new_td_bits) != TRACKDIR_BIT_NONE) break;
+			tile = F.new_tile;
+			trackdir = (Trackdir)FindFirstBit(F.new_td_bits);
+			regions.push_back(GetRoadLayoutRegion(tile));
+		}
+	}
+
 	static Trackdir stChooseRoadTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, bool &path_found, RoadVehPathCache &path_cache)
 	{
+		/* For long distance searches, first find a path through the road regions and restrict the search to a corridor around it.
+		 * This bounds the number of nodes expanded on large road networks, but the best path may lie outside the corridor.
+		 * If no path is found, for instance because the road region path leads along a one-way road in the wrong direction,
+		 * or the path found is a longer detour than allowed, the search is repeated without restriction. */
+		const uint max_detour = _settings_game.pf.yapf.road_region_max_detour;
+		if (max_detour > 0 && DistanceManhattan(tile, v->dest_tile) >= MIN_RV_ROAD_REGION_PF_DISTANCE) {
+			const std::vector<RoadRegionPatchDesc> high_level_path = YapfRoadVehicleFindRoadRegionPath(v, tile);
+			if (!high_level_path.empty()) {
+				Tpf pf;
+				pf.RestrictSearch(high_level_path);
+				const Trackdir result = pf.ChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
+				if (path_found && pf.IsPathWithinDetour(tile, max_detour)) return result;
+				path_cache.clear();
+			}
+		}
+
 		Tpf pf;
 		return pf.ChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
 	}
@@ -496,10 +595,15 @@ public:
 		Node *pNode = Yapf().GetBestNode();
 		if (pNode != nullptr) {
 			/* path was found or at least suggested
-			 * walk through the path back to its origin */
+			 * walk through the path back to its origin, recording the road layout regions crossed by each leg */
+			path_cache.clear();
+			std::vector<uint32_t> leg_regions;
 			while (pNode->parent != nullptr) {
+				this->AddSegmentRoadLayoutRegions(*pNode, leg_regions);
 				if (pNode->GetIsChoice()) {
+					(path_cache.empty() ? path_cache.tail_regions : path_cache.regions[path_cache.start]).swap(leg_regions);
 					path_cache.push_front(pNode->GetTile(), pNode->GetTrackdir());
+					leg_regions.clear();
 				}
 				pNode = pNode->parent;
 			}
@@ -507,6 +611,8 @@ public:
 			Node &best_next_node = *pNode;
 			assert(best_next_node.GetTile() == tile);
 			next_trackdir = best_next_node.GetTrackdir();
+			this->AddSegmentRoadLayoutRegions(best_next_node, leg_regions);
+			(path_cache.empty() ? path_cache.tail_regions : path_cache.regions[path_cache.start]).swap(leg_regions);
 			/* remove last element for the special case when tile == dest_tile */
 			if (path_found && !path_cache.empty() && tile == v->dest_tile) {
 				path_cache.pop_back();
@@ -521,6 +627,15 @@ public:
 					path_cache.pop_back();
 				}
 			}
+
+			auto sort_regions = [](std::vector<uint32_t> &regions) {
+				std::ranges::sort(regions);
+				regions.erase(std::unique(regions.begin(), regions.end()), regions.end());
+			};
+			for (uint i = 0; i < path_cache.size(); i++) {
+				sort_regions(path_cache.regions[(path_cache.start + i) & RV_PATH_CACHE_SEGMENT_MASK]);
+			}
+			sort_regions(path_cache.tail_regions);
 		}
 		return next_trackdir;
 	}
@@ -628,6 +743,7 @@ struct CYapfRoadAnyDepot2 : CYapfRoadCommon<CYapfRoad_TypesT<CYapfRoadAnyDepot2,
 
 Trackdir YapfRoadVehicleChooseTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, TrackdirBits trackdirs, bool &path_found, RoadVehPathCache &path_cache)
 {
+	ZoneProfilerScope zone(ZPZ_PF_ROAD, v->index);
 	Trackdir td_ret = _settings_game.pf.yapf.disable_node_optimization
 		? CYapfRoad1::stChooseRoadTrack(v, tile, enterdir, path_found, path_cache) // Trackdir
 		: CYapfRoad2::stChooseRoadTrack(v, tile, enterdir, path_found, path_cache); // ExitDir, allow 90-deg
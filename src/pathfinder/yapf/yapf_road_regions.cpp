@@ -0,0 +1,288 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /** @file yapf_road_regions.cpp Implementation of YAPF for road regions, which are used to restrict long distance road vehicle searches. */
+
+#include "../../stdafx.h"
+#include "../../roadveh.h"
+#include "../../station_base.h"
+#include "../../core/math_func.hpp"
+
+#include "yapf.hpp"
+#include "yapf_road_regions.h"
+#include "../road_regions.h"
+
+#include "../../safeguards.h"
+
+constexpr int ROAD_REGION_DIRECT_NEIGHBOUR_COST = 100;
+constexpr int ROAD_NODES_PER_REGION = 4;
+constexpr uint32_t ROAD_REGION_MAX_NUMBER_OF_NODES = 65536;
+
+/** Yapf Node Key that represents a single patch of interconnected road within a road region. */
+struct CYapfRoadRegionPatchNodeKey {
+	using HashKey = uint32_t;
+
+	RoadRegionPatchDesc road_region_patch;
+
+	inline void Set(const RoadRegionPatchDesc &road_region_patch)
+	{
+		this->road_region_patch = road_region_patch;
+	}
+
+	inline uint32_t GetHashKey() const { return CalculateRoadRegionPatchHash(this->road_region_patch); }
+	inline bool operator==(const CYapfRoadRegionPatchNodeKey &other) const { return GetHashKey() == other.GetHashKey(); }
+};
+
+inline uint ManhattanDistance(const CYapfRoadRegionPatchNodeKey &a, const CYapfRoadRegionPatchNodeKey &b)
+{
+	return (Delta(a.road_region_patch.x, b.road_region_patch.x) + Delta(a.road_region_patch.y, b.road_region_patch.y)) * ROAD_REGION_DIRECT_NEIGHBOUR_COST;
+}
+
+/** Yapf Node for road regions. */
+template <class Tkey_>
+struct CYapfRoadRegionNodeT : CYapfNodeT<Tkey_, CYapfRoadRegionNodeT<Tkey_> > {
+	typedef Tkey_ Key;
+	typedef CYapfRoadRegionNodeT<Tkey_> Node;
+
+	inline void Set(Node *parent, const RoadRegionPatchDesc &road_region_patch)
+	{
+		this->key.Set(road_region_patch);
+		this->parent = parent;
+		this->cost = 0;
+		this->estimate = 0;
+	}
+
+	inline void Set(Node *parent, const Key &key)
+	{
+		this->Set(parent, key.road_region_patch);
+	}
+};
+
+/** YAPF origin for road regions. */
+template <class Types>
+class CYapfOriginRoadRegionT
+{
+public:
+	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
+	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
+	typedef typename Node::Key Key; ///< Key to hash tables.
+
+protected:
+	inline Tpf &Yapf() { return *static_cast<Tpf*>(this); }
+
+private:
+	std::vector<CYapfRoadRegionPatchNodeKey> origin_keys;
+
+public:
+	void AddOrigin(const RoadRegionPatchDesc &road_region_patch)
+	{
+		if (road_region_patch.label == INVALID_ROAD_REGION_PATCH) return;
+		if (!HasOrigin(road_region_patch)) this->origin_keys.push_back(CYapfRoadRegionPatchNodeKey{ road_region_patch });
+	}
+
+	bool HasOrigin(const RoadRegionPatchDesc &road_region_patch)
+	{
+		return std::ranges::find(this->origin_keys, CYapfRoadRegionPatchNodeKey{ road_region_patch }) != this->origin_keys.end();
+	}
+
+	bool HasAnyOrigin() const
+	{
+		return !this->origin_keys.empty();
+	}
+
+	void PfSetStartupNodes()
+	{
+		for (const CYapfRoadRegionPatchNodeKey &origin_key : this->origin_keys) {
+			Node &node = Yapf().CreateNewNode();
+			node.Set(nullptr, origin_key);
+			Yapf().AddStartupNode(node);
+		}
+	}
+};
+
+/** YAPF destination provider for road regions. */
+template <class Types>
+class CYapfDestinationRoadRegionT
+{
+public:
+	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
+	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
+	typedef typename Node::Key Key; ///< Key to hash tables.
+
+protected:
+	Key dest;
+
+public:
+	void SetDestination(const RoadRegionPatchDesc &road_region_patch)
+	{
+		this->dest.Set(road_region_patch);
+	}
+
+protected:
+	Tpf &Yapf() { return *static_cast<Tpf*>(this); }
+
+public:
+	inline bool PfDetectDestination(Node &n) const
+	{
+		return n.key == this->dest;
+	}
+
+	inline bool PfCalcEstimate(Node &n)
+	{
+		if (this->PfDetectDestination(n)) {
+			n.estimate = n.cost;
+			return true;
+		}
+
+		n.estimate = n.cost + ManhattanDistance(n.key, this->dest);
+
+		return true;
+	}
+};
+
+/** YAPF node following for road region pathfinding. */
+template <class Types>
+class CYapfFollowRoadRegionT
+{
+public:
+	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
+	typedef typename Types::TrackFollower TrackFollower;
+	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
+	typedef typename Node::Key Key; ///< Key to hash tables.
+
+protected:
+	inline Tpf &Yapf() { return *static_cast<Tpf*>(this); }
+
+	RoadTramType rtt = RTT_ROAD;
+
+public:
+	inline void PfFollowNode(Node &old_node)
+	{
+		TVisitRoadRegionPatchCallBack visitFunc = [&](const RoadRegionPatchDesc &road_region_patch)
+		{
+			Node &node = Yapf().CreateNewNode();
+			node.Set(&old_node, road_region_patch);
+			Yapf().AddNewNode(node, TrackFollower{});
+		};
+		VisitRoadRegionPatchNeighbours(old_node.key.road_region_patch, this->rtt, visitFunc);
+	}
+
+	inline char TransportTypeChar() const { return '%'; }
+
+	static std::vector<RoadRegionPatchDesc> FindRoadRegionPath(const RoadVehicle *v, TileIndex start_tile)
+	{
+		const RoadTramType rtt = GetRoadTramType(v->roadtype);
+		const RoadRegionPatchDesc start_road_region_patch = GetRoadRegionPatchInfo(start_tile, rtt);
+		if (start_road_region_patch.label == INVALID_ROAD_REGION_PATCH) return {};
+
+		/* We reserve 4 nodes (patches) per road region, capped in the same way as for the water region pathfinder. */
+		Tpf pf(std::min(static_cast<uint32_t>(Map::Size() * ROAD_NODES_PER_REGION) / ROAD_REGION_NUMBER_OF_TILES, ROAD_REGION_MAX_NUMBER_OF_NODES));
+		pf.rtt = rtt;
+		pf.SetDestination(start_road_region_patch);
+
+		/* The search is done backwards, from all possible destination tiles to the start tile. */
+		const StationType station_type = v->current_order.IsType(OT_GOTO_WAYPOINT) ? StationType::RoadWaypoint : (v->IsBus() ? StationType::Bus : StationType::Truck);
+		if (v->current_order.IsType(OT_GOTO_STATION) || v->current_order.IsType(OT_GOTO_WAYPOINT)) {
+			const StationID station_id = v->current_order.GetDestination().ToStationID();
+			const BaseStation *station = BaseStation::GetIfValid(station_id);
+			if (station == nullptr) return {};
+			TileArea tile_area;
+			station->GetTileArea(&tile_area, station_type);
+			for (const auto &tile : tile_area) {
+				if (IsTileType(tile, MP_STATION) && GetStationIndex(tile) == station_id && GetStationType(tile) == station_type) {
+					pf.AddOrigin(GetRoadRegionPatchInfo(tile, rtt));
+				}
+			}
+		} else {
+			pf.AddOrigin(GetRoadRegionPatchInfo(v->dest_tile, rtt));
+		}
+		if (!pf.HasAnyOrigin()) return {};
+
+		/* If origin and destination are the same we simply return that road patch. */
+		std::vector<RoadRegionPatchDesc> path = { start_road_region_patch };
+		if (pf.HasOrigin(start_road_region_patch)) return path;
+
+		/* Find best path. */
+		if (!pf.FindPath(v)) return {}; // Path not found.
+
+		for (Node *node = pf.GetBestNode()->parent; node != nullptr; node = node->parent) {
+			path.push_back(node->key.road_region_patch);
+		}
+		return path;
+	}
+};
+
+/** Cost Provider of YAPF for road regions. */
+template <class Types>
+class CYapfCostRoadRegionT
+{
+public:
+	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
+	typedef typename Types::TrackFollower TrackFollower;
+	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
+	typedef typename Node::Key Key; ///< Key to hash tables.
+
+protected:
+	/** To access inherited path finder. */
+	Tpf &Yapf() { return *static_cast<Tpf*>(this); }
+
+public:
+	/**
+	 * Called by YAPF to calculate the cost from the origin to the given node.
+	 * Calculates only the cost of given node, adds it to the parent node cost
+	 * and stores the result into Node::cost member.
+	 */
+	inline bool PfCalcCost(Node &n, const TrackFollower *)
+	{
+		n.cost = n.parent->cost + ManhattanDistance(n.key, n.parent->key);
+		return true;
+	}
+};
+
+/* We don't need a follower but YAPF requires one. */
+struct RoadRegionDummyFollower : public CFollowTrackRoad {};
+
+/**
+ * Config struct of YAPF for road region route planning.
+ * Defines all 6 base YAPF modules as classes providing services for CYapfBaseT.
+ */
+template <class Tpf_, class Tnode_list>
+struct CYapfRoadRegion_TypesT
+{
+	typedef CYapfRoadRegion_TypesT<Tpf_, Tnode_list> Types;         ///< Shortcut for this struct type.
+	typedef Tpf_                                     Tpf;           ///< Pathfinder type.
+	typedef RoadRegionDummyFollower                  TrackFollower; ///< Track follower helper class
+	typedef Tnode_list                               NodeList;
+	typedef RoadVehicle                              VehicleType;
+
+	/** Pathfinder components (modules). */
+	typedef CYapfBaseT<Types>                 PfBase;        ///< Base pathfinder class.
+	typedef CYapfFollowRoadRegionT<Types>     PfFollow;      ///< Node follower.
+	typedef CYapfOriginRoadRegionT<Types>     PfOrigin;      ///< Origin provider.
+	typedef CYapfDestinationRoadRegionT<Types> PfDestination; ///< Destination/distance provider.
+	typedef CYapfSegmentCostCacheNoneT<Types> PfCache;       ///< Segment cost cache provider.
+	typedef CYapfCostRoadRegionT<Types>       PfCost;        ///< Cost provider.
+};
+
+typedef NodeList<CYapfRoadRegionNodeT<CYapfRoadRegionPatchNodeKey>> CRoadRegionNodeList;
+
+struct CYapfRoadRegion : CYapfT<CYapfRoadRegion_TypesT<CYapfRoadRegion, CRoadRegionNodeList>>
+{
+	explicit CYapfRoadRegion(int max_nodes) { this->max_search_nodes = max_nodes; }
+};
+
+/**
+ * Finds a path at the road region level, from the tile a road vehicle is about to enter to its destination.
+ * Note that the starting region is always included if the path was found.
+ * @param v The road vehicle to find a path for.
+ * @param start_tile The tile to start searching from.
+ * @returns A path of road region patches, starting at \p start_tile, or an empty vector if no path was found.
+ */
+std::vector<RoadRegionPatchDesc> YapfRoadVehicleFindRoadRegionPath(const RoadVehicle *v, TileIndex start_tile)
+{
+	return CYapfRoadRegion::FindRoadRegionPath(v, start_tile);
+}
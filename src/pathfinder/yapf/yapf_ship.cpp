@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "../../ship.h"
 #include "../../vehicle_func.h"
+#include "../../zone_profiler.h"
 
 #include "yapf.hpp"
 #include "yapf_node_ship.hpp"
@@ -424,6 +425,7 @@ struct CYapfShip : CYapfT<CYapfShip_TypesT<CYapfShip, CFollowTrackWater, CShipNo
 /** Ship controller helper - path finder invoker. */
 Track YapfShipChooseTrack(const Ship *v, TileIndex tile, bool &path_found, ShipPathCache &path_cache)
 {
+	ZoneProfilerScope zone(ZPZ_PF_SHIP, v->index);
 	Trackdir best_origin_dir = INVALID_TRACKDIR;
 	const TrackdirBits origin_dirs = TrackdirToTrackdirBits(v->GetVehicleTrackdir());
 	const Trackdir td_ret = CYapfShip::ChooseShipTrack(v, tile, origin_dirs, TRACKDIR_BIT_NONE, path_found, path_cache, best_origin_dir);
@@ -40,6 +40,7 @@
 #include "scope.h"
 #include "newgrf_newsignals.h"
 #include "pathfinder/water_regions.h"
+#include "pathfinder/road_regions.h"
 #include "landscape_cmd.h"
 #include "rail_cmd.h"
 
@@ -860,6 +861,7 @@ CommandCost CmdBuildSingleRail(DoCommandFlag flags, TileIndex tile, RailType rai
 					if (flags & DC_EXEC) {
 						MakeRoadCrossing(tile, road_owner, tram_owner, _current_company, (track == TRACK_X ? AXIS_Y : AXIS_X), railtype, roadtype_road, roadtype_tram, GetTownIndex(tile));
 						UpdateLevelCrossing(tile, false);
+						InvalidateRoadRegion(tile);
 						MarkDirtyAdjacentLevelCrossingTilesOnAdd(tile, GetCrossingRoadAxis(tile));
 						Company::Get(_current_company)->infrastructure.rail[railtype] += LEVELCROSSING_TRACKBIT_FACTOR;
 						DirtyCompanyInfrastructureWindows(_current_company);
@@ -15,6 +15,11 @@
 #include "fileio_func.h"
 #include "string_func.h"
 
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+#	include <sys/mman.h>
+#	define WITH_RANDOM_ACCESS_FILE_MMAP
+#endif
+
 #include "safeguards.h"
 
 /**
@@ -42,9 +47,60 @@ RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory sub
 	this->simplified_filename = name_without_path.substr(0, name_without_path.rfind('.'));
 	strtolower(this->simplified_filename);
 
+	this->buffer_begin = this->buffer_start;
+
 	this->SeekToIntl(static_cast<size_t>(pos), SEEK_SET);
 }
 
+RandomAccessFile::~RandomAccessFile()
+{
+#ifdef WITH_RANDOM_ACCESS_FILE_MMAP
+	if (this->mapping != nullptr) munmap(this->mapping, this->end_pos);
+#endif
+}
+
+/**
+ * Try to replace the buffered reads by a read-only memory mapping of the file.
+ * The mapping starts at offset 0 so that positions within tar files can be used unchanged.
+ * The file handle is kept open, so that #ReleaseMemoryMap can return to buffered reads.
+ * On failure, or on platforms without support, the file keeps using buffered reads.
+ */
+void RandomAccessFile::TryMemoryMap()
+{
+#ifdef WITH_RANDOM_ACCESS_FILE_MMAP
+	if (this->mapping != nullptr || this->end_pos == 0) return;
+
+	void *map = mmap(nullptr, this->end_pos, PROT_READ, MAP_PRIVATE, fileno(*this->file_handle), 0);
+	if (map == MAP_FAILED) {
+		Debug(misc, 3, "Memory mapping {} failed, using buffered reads", this->filename);
+		return;
+	}
+
+	const size_t pos = this->GetPos();
+	this->mapping = static_cast<uint8_t *>(map);
+	this->buffer_begin = this->mapping;
+	this->SeekToIntl(pos, SEEK_SET);
+#endif
+}
+
+/**
+ * Return to buffered reads, if the file is memory mapped.
+ * A mapping must not be kept for longer than needed: when the file is truncated or replaced
+ * on disk while it is mapped, accessing the mapping crashes the game.
+ */
+void RandomAccessFile::ReleaseMemoryMap()
+{
+#ifdef WITH_RANDOM_ACCESS_FILE_MMAP
+	if (this->mapping == nullptr) return;
+
+	const size_t pos = this->GetPos();
+	munmap(this->mapping, this->end_pos);
+	this->mapping = nullptr;
+	this->buffer_begin = this->buffer_start;
+	this->SeekToIntl(pos, SEEK_SET);
+#endif
+}
+
 /**
  * Get the filename of the opened file with the path from the SubDirectory and the extension.
  * @return Name of the file.
@@ -96,7 +152,7 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 			return;
 		}
 	} else {
-		if (pos <= this->pos && (this->pos - pos) <= (size_t)(this->buffer_end - this->buffer_start)) {
+		if (pos <= this->pos && (this->pos - pos) <= (size_t)(this->buffer_end - this->buffer_begin)) {
 			/* Seeking within existing buffer, no need to clear and re-read buffer */
 			this->buffer = this->buffer_end - (this->pos - pos);
 			return;
@@ -115,6 +171,14 @@ void RandomAccessFile::SeekToIntl(size_t pos, int mode)
 {
 	if (mode == SEEK_CUR) pos += this->GetPos();
 
+	if (this->mapping != nullptr) {
+		/* The whole file is available, the buffer always spans until the end of the file. */
+		this->pos = this->end_pos;
+		this->buffer_end = this->mapping + this->end_pos;
+		this->buffer = this->mapping + std::min(pos, this->end_pos);
+		return;
+	}
+
 	this->pos = pos;
 	if (fseek(*this->file_handle, this->pos, SEEK_SET) < 0) {
 		Debug(misc, 0, "Seeking in {} failed", this->filename);
@@ -131,6 +195,9 @@ void RandomAccessFile::SeekToIntl(size_t pos, int mode)
 uint8_t RandomAccessFile::ReadByteIntl()
 {
 	if (this->buffer == this->buffer_end) {
+		/* A memory mapped file has no more data to read past its end. */
+		if (this->mapping != nullptr) return 0;
+
 		this->buffer = this->buffer_start;
 		size_t size = fread(this->buffer, 1, RandomAccessFile::BUFFER_SIZE, *this->file_handle);
 		this->pos += size;
@@ -177,6 +244,9 @@ void RandomAccessFile::ReadBlock(void *ptr, size_t size)
 		ptr = ((char *)ptr) + to_copy;
 	}
 
+	/* A memory mapped file has no more data to read past its end. */
+	if (this->mapping != nullptr) return;
+
 	/* Reset the buffer, so the next ReadByte will read bytes from the file. */
 	this->buffer = this->buffer_end = this->buffer_start;
 
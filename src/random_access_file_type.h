@@ -36,6 +36,8 @@ class RandomAccessFile {
 
 	uint8_t *buffer;                    ///< Current position within the local buffer.
 	uint8_t *buffer_end;                ///< Last valid byte of buffer.
+	uint8_t *buffer_begin;              ///< First valid byte of buffer, either #buffer_start or the start of the mapping.
+	uint8_t *mapping = nullptr;         ///< Read-only memory mapping of the file from offset 0 to #end_pos, or nullptr when reading via the local buffer.
 	uint8_t buffer_start[BUFFER_SIZE];  ///< Local buffer when read from file.
 
 	uint8_t ReadByteIntl();
@@ -49,7 +51,7 @@ public:
 	RandomAccessFile(const RandomAccessFile&) = delete;
 	void operator=(const RandomAccessFile&) = delete;
 
-	virtual ~RandomAccessFile() = default;
+	virtual ~RandomAccessFile();
 
 	const std::string &GetFilename() const;
 	const std::string &GetSimplifiedFilename() const;
@@ -60,6 +62,15 @@ public:
 	void SeekTo(size_t pos, int mode);
 	bool AtEndOfFile() const;
 
+	void TryMemoryMap();
+	void ReleaseMemoryMap();
+
+	/**
+	 * Whether the file is accessed via a memory mapping instead of buffered reads.
+	 * @return True when the file is memory mapped.
+	 */
+	bool IsMemoryMapped() const { return this->mapping != nullptr; }
+
 	inline uint8_t ReadByte()
 	{
 		if (likely(this->buffer != this->buffer_end)) return *this->buffer++;
@@ -41,6 +41,91 @@
 #include "safeguards.h"
 
 uint32_t _road_layout_change_counter = 0;
+std::vector<uint32_t> _road_layout_region_versions; ///< Per road layout region, the value of #_road_layout_change_counter when it last changed.
+
+/**
+ * Reset the road layout regions for the current map size, this is done when the map is allocated.
+ */
+void InitializeRoadLayoutRegions()
+{
+	_road_layout_region_versions.assign(Map::Size() >> (2 * ROAD_LAYOUT_REGION_EDGE_LOG), 0);
+}
+
+/**
+ * Call a function for each road layout region index touching the rectangle spanned by two tiles.
+ * @param start First corner tile.
+ * @param end Opposite corner tile.
+ * @param proc Function called with each region index, iteration stops when it returns true.
+ * @return Whether \p proc returned true.
+ */
+template <typename F>
+static bool IterateRoadLayoutRegions(TileIndex start, TileIndex end, F proc)
+{
+	const uint x1 = std::min(TileX(start), TileX(end)) >> ROAD_LAYOUT_REGION_EDGE_LOG;
+	const uint x2 = std::max(TileX(start), TileX(end)) >> ROAD_LAYOUT_REGION_EDGE_LOG;
+	const uint y1 = std::min(TileY(start), TileY(end)) >> ROAD_LAYOUT_REGION_EDGE_LOG;
+	const uint y2 = std::max(TileY(start), TileY(end)) >> ROAD_LAYOUT_REGION_EDGE_LOG;
+	const uint regions_x = GetRoadLayoutRegionsX();
+
+	for (uint y = y1; y <= y2; y++) {
+		for (uint x = x1; x <= x2; x++) {
+			if (proc((y * regions_x) + x)) return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Notify that the road layout changed in the rectangle spanned by two tiles (e.g. both ends of a bridge or a road stop area).
+ * Road vehicle path caches crossing any of the touched road layout regions are invalidated.
+ * @param start First corner tile.
+ * @param end Opposite corner tile.
+ */
+void NotifyRoadLayoutChanged(TileIndex start, TileIndex end)
+{
+	const uint32_t ctr = ++_road_layout_change_counter;
+	IterateRoadLayoutRegions(start, end, [&](uint region) {
+		_road_layout_region_versions[region] = ctr;
+		return false;
+	});
+}
+
+/**
+ * Notify that the road layout may have changed anywhere (e.g. a change of road owners), this invalidates all road vehicle path caches.
+ */
+void NotifyRoadLayoutChangedEverywhere()
+{
+	const uint32_t ctr = ++_road_layout_change_counter;
+	std::fill(_road_layout_region_versions.begin(), _road_layout_region_versions.end(), ctr);
+}
+
+/**
+ * Check whether the road layout changed in the rectangle spanned by two tiles.
+ * @param start First corner tile.
+ * @param end Opposite corner tile.
+ * @param layout_ctr Value of #_road_layout_change_counter to check against.
+ * @return Whether any road layout region touching the rectangle changed after \p layout_ctr.
+ */
+bool HasRoadLayoutChangedSince(TileIndex start, TileIndex end, uint32_t layout_ctr)
+{
+	return IterateRoadLayoutRegions(start, end, [&](uint region) {
+		return static_cast<int32_t>(_road_layout_region_versions[region] - layout_ctr) > 0;
+	});
+}
+
+/**
+ * Check whether the road layout changed in any of a list of road layout regions.
+ * @param regions Indices of the regions, see #GetRoadLayoutRegion.
+ * @param layout_ctr Value of #_road_layout_change_counter to check against.
+ * @return Whether any of the regions changed after \p layout_ctr.
+ */
+bool HasRoadLayoutChangedSince(std::span<const uint32_t> regions, uint32_t layout_ctr)
+{
+	for (uint32_t region : regions) {
+		if (static_cast<int32_t>(_road_layout_region_versions[region] - layout_ctr) > 0) return true;
+	}
+	return false;
+}
 
 /**
  * Return if the tile is a valid tile for a crossing.
@@ -308,7 +393,6 @@ RoadType GetRoadTypeByLabel(RoadTypeLabel label, bool allow_alternate_labels)
 /* ========================================================================= */
 
 static RoadType _public_road_type;
-static const uint _public_road_hash_size = 8U; ///< The number of bits the hash for river finding should have.
 static PublicRoadsConstruction _public_road_mode = PRC_NONE;
 
 /** Helper function to check if a slope along a certain direction is going up an inclined slope. */
@@ -920,7 +1004,7 @@ static AyStar PublicRoadAyStar()
 	finder.FoundEndNode = PublicRoad_FoundEndNode;
 	finder.max_search_nodes = 1 << 20;
 
-	finder.Init(1 << _public_road_hash_size);
+	finder.Init();
 
 	return finder;
 }
@@ -14,6 +14,7 @@
 #include "command_func.h"
 #include "company_func.h"
 #include "pathfinder/yapf/yapf_cache.h"
+#include "pathfinder/road_regions.h"
 #include "depot_base.h"
 #include "newgrf.h"
 #include "autoslope.h"
@@ -531,7 +532,7 @@ void NotifyRoadLayoutChangedIfTileNonLeaf(TileIndex tile, RoadTramType rtt, Road
 	if ((present_bits & ROAD_SW) && (GetAnyRoadBits(TileAddXY(tile,  1,  0), rtt) & ROAD_NE)) connections++;
 	if ((present_bits & ROAD_NW) && (GetAnyRoadBits(TileAddXY(tile,  0, -1), rtt) & ROAD_SE)) connections++;
 	if (connections >= 2) {
-		NotifyRoadLayoutChanged();
+		NotifyRoadLayoutChanged(tile);
 	}
 }
 
@@ -540,7 +541,7 @@ void NotifyRoadLayoutChangedIfSimpleTunnelBridgeNonLeaf(TileIndex start, TileInd
 	if (!(GetAnyRoadBits(TileAddByDiagDir(start, ReverseDiagDir(start_dir)), rtt) & DiagDirToRoadBits(start_dir))) return;
 	if (!(GetAnyRoadBits(TileAddByDiagDir(end, start_dir), rtt) & DiagDirToRoadBits(ReverseDiagDir(start_dir)))) return;
 
-	NotifyRoadLayoutChanged();
+	NotifyRoadLayoutChanged(start, end);
 }
 
 /**
@@ -743,8 +744,11 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				AddRoadTunnelBridgeInfrastructure(tile, other_end);
 				DirtyAllCompanyInfrastructureWindows();
 
+				InvalidateRoadRegion(tile);
+				InvalidateRoadRegion(other_end);
+
 				/* Todo: Change this to be more fine-grained if necessary */
-				NotifyRoadLayoutChanged(false);
+				NotifyRoadLayoutChanged(tile, other_end, false);
 				if (rtt == RTT_ROAD) {
 					UpdateRoadCachedOneWayStatesAroundTile(tile);
 					UpdateRoadCachedOneWayStatesAroundTile(other_end);
@@ -761,7 +765,8 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				}
 				SetRoadType(tile, rtt, INVALID_ROADTYPE);
 				MarkTileDirtyByTile(tile);
-				NotifyRoadLayoutChanged(false);
+				InvalidateRoadRegion(tile);
+				NotifyRoadLayoutChanged(tile, false);
 				if (rtt == RTT_ROAD) {
 					UpdateRoadCachedOneWayStatesAroundTile(tile);
 				}
@@ -817,6 +822,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 					}
 				}
 
+				InvalidateRoadRegion(tile);
 				if (RoadLayoutChangeNotificationEnabled(false)) NotifyRoadLayoutChangedIfTileNonLeaf(tile, rtt, present | pieces);
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -(int)CountBits(pieces));
 
@@ -869,6 +875,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -2);
 
 				Track railtrack = GetCrossingRailTrack(tile);
+				InvalidateRoadRegion(tile);
 				if (RoadLayoutChangeNotificationEnabled(false)) NotifyRoadLayoutChangedIfTileNonLeaf(tile, rtt, GetCrossingRoadBits(tile));
 				if (GetRoadType(tile, OtherRoadTramType(rtt)) == INVALID_ROADTYPE) {
 					TrackBits tracks = GetCrossingRailBits(tile);
@@ -1073,7 +1080,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 							if ((flags & DC_EXEC) && IsStraightRoad(existing)) {
 								SetDisallowedRoadDirections(tile, dis_new);
 								MarkTileDirtyByTile(tile);
-								NotifyRoadLayoutChanged(CountBits(dis_existing) > CountBits(dis_new));
+								NotifyRoadLayoutChanged(tile, CountBits(dis_existing) > CountBits(dis_new));
 								UpdateRoadCachedOneWayStatesAroundTile(tile);
 							}
 							return CommandCost();
@@ -1175,6 +1182,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 				SetCrossingReservation(tile, reserved);
 				UpdateLevelCrossing(tile, false);
 				MarkDirtyAdjacentLevelCrossingTilesOnAdd(tile, GetCrossingRoadAxis(tile));
+				InvalidateRoadRegion(tile);
 				if (RoadLayoutChangeNotificationEnabled(true)) NotifyRoadLayoutChangedIfTileNonLeaf(tile, rtt, GetCrossingRoadBits(tile));
 				if (rtt == RTT_ROAD) {
 					UpdateRoadCachedOneWayStatesAroundTile(tile);
@@ -1212,7 +1220,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 					if (flags & DC_EXEC) {
 						UpdateRoadStopTileDisallowedRoadDirection(tile, dis_new);
 						MarkTileDirtyByTile(tile, VMDF_NOT_MAP_MODE);
-						NotifyRoadLayoutChanged(CountBits(dis_existing) > CountBits(dis_new));
+						NotifyRoadLayoutChanged(tile, CountBits(dis_existing) > CountBits(dis_new));
 						UpdateRoadCachedOneWayStatesAroundTile(tile);
 					}
 					return CommandCost();
@@ -1284,7 +1292,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 							SetBridgeDisallowedRoadDirections(other_end, dis_new);
 							MarkTileDirtyByTile(tile);
 							MarkTileDirtyByTile(other_end);
-							NotifyRoadLayoutChanged(CountBits(dis_existing) > CountBits(dis_new));
+							NotifyRoadLayoutChanged(tile, other_end, CountBits(dis_existing) > CountBits(dis_new));
 							UpdateRoadCachedOneWayStatesAroundTile(tile);
 							UpdateRoadCachedOneWayStatesAroundTile(other_end);
 						}
@@ -1396,7 +1404,9 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 					MarkBridgeDirty(tile, other_end);
 
 					AddRoadTunnelBridgeInfrastructure(tile, other_end);
-					NotifyRoadLayoutChanged(true);
+					InvalidateRoadRegion(tile);
+					InvalidateRoadRegion(other_end);
+					NotifyRoadLayoutChanged(tile, other_end, true);
 					if (rtt == RTT_ROAD) {
 						SetBridgeDisallowedRoadDirections(tile, DRD_NONE);
 						SetBridgeDisallowedRoadDirections(other_end, DRD_NONE);
@@ -1493,6 +1503,7 @@ do_clear:;
 	cost.AddCost(num_pieces * RoadBuildCost(rt));
 
 	if (flags & DC_EXEC) {
+		InvalidateRoadRegion(tile);
 		switch (GetTileType(tile)) {
 			case MP_ROAD: {
 				RoadTileType rttype = GetRoadTileType(tile);
@@ -1508,6 +1519,7 @@ do_clear:;
 
 			case MP_TUNNELBRIDGE: {
 				TileIndex other_end = GetOtherTunnelBridgeEnd(tile);
+				InvalidateRoadRegion(other_end);
 
 				SetRoadType(other_end, rtt, rt);
 				SetRoadType(tile, rtt, rt);
@@ -1524,7 +1536,7 @@ do_clear:;
 				if (rtt == RTT_ROAD) {
 					UpdateRoadCachedOneWayStatesAroundTile(other_end);
 				}
-				NotifyRoadLayoutChanged(true);
+				NotifyRoadLayoutChanged(tile, other_end, true);
 				break;
 			}
 
@@ -1532,7 +1544,7 @@ do_clear:;
 				assert_tile(IsDriveThroughStopTile(tile), tile);
 				SetRoadType(tile, rtt, rt);
 				SetRoadOwner(tile, rtt, company);
-				NotifyRoadLayoutChanged(true);
+				NotifyRoadLayoutChanged(tile, true);
 				break;
 			}
 
@@ -1801,7 +1813,8 @@ CommandCost CmdBuildRoadDepot(DoCommandFlag flags, TileIndex tile, RoadType rt,
 		MarkTileDirtyByTile(tile);
 		MakeDefaultName(dep);
 
-		NotifyRoadLayoutChanged(true);
+		InvalidateRoadRegion(tile);
+		NotifyRoadLayoutChanged(tile, true);
 	}
 	cost.AddCost(_price[PR_BUILD_DEPOT_ROAD]);
 	return cost;
@@ -1830,7 +1843,8 @@ static CommandCost RemoveRoadDepot(TileIndex tile, DoCommandFlag flags)
 		delete Depot::GetByTile(tile);
 		DoClearSquare(tile);
 
-		NotifyRoadLayoutChanged(false);
+		InvalidateRoadRegion(tile);
+		NotifyRoadLayoutChanged(tile, false);
 		DeleteNewGRFInspectWindow(GSF_ROADTYPES, tile.base());
 	}
 
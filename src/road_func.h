@@ -15,6 +15,10 @@
 #include "economy_func.h"
 #include "transparency.h"
 #include "settings_type.h"
+#include "map_func.h"
+
+#include <span>
+#include <vector>
 
 /**
  * Whether the given roadtype is valid.
@@ -170,14 +174,52 @@ inline bool RoadLayoutChangeNotificationEnabled(bool added)
 	return _settings_game.pf.reroute_rv_on_layout_change >= (added ? 2 : 1);
 }
 
-inline void NotifyRoadLayoutChanged()
+static const uint ROAD_LAYOUT_REGION_EDGE_LOG = 4; ///< Log2 of the edge length of the regions in which road layout changes are tracked.
+
+extern std::vector<uint32_t> _road_layout_region_versions;
+
+void InitializeRoadLayoutRegions();
+void NotifyRoadLayoutChanged(TileIndex start, TileIndex end);
+void NotifyRoadLayoutChangedEverywhere();
+bool HasRoadLayoutChangedSince(TileIndex start, TileIndex end, uint32_t layout_ctr);
+bool HasRoadLayoutChangedSince(std::span<const uint32_t> regions, uint32_t layout_ctr);
+
+/**
+ * Get the number of road layout regions in the X direction.
+ * @return Region count.
+ */
+inline uint GetRoadLayoutRegionsX()
+{
+	return Map::SizeX() >> ROAD_LAYOUT_REGION_EDGE_LOG;
+}
+
+/**
+ * Get the index of the road layout region containing a tile.
+ * @param tile The tile.
+ * @return The region index.
+ */
+inline uint32_t GetRoadLayoutRegion(TileIndex tile)
+{
+	return ((TileY(tile) >> ROAD_LAYOUT_REGION_EDGE_LOG) * GetRoadLayoutRegionsX()) + (TileX(tile) >> ROAD_LAYOUT_REGION_EDGE_LOG);
+}
+
+/**
+ * Notify that the road layout of a tile changed, this invalidates road vehicle path caches which cross the tile's region.
+ * @param tile The changed tile.
+ */
+inline void NotifyRoadLayoutChanged(TileIndex tile)
+{
+	NotifyRoadLayoutChanged(tile, tile);
+}
+
+inline void NotifyRoadLayoutChanged(TileIndex tile, bool added)
 {
-	_road_layout_change_counter++;
+	if (RoadLayoutChangeNotificationEnabled(added)) NotifyRoadLayoutChanged(tile);
 }
 
-inline void NotifyRoadLayoutChanged(bool added)
+inline void NotifyRoadLayoutChanged(TileIndex start, TileIndex end, bool added)
 {
-	if (RoadLayoutChangeNotificationEnabled(added)) NotifyRoadLayoutChanged();
+	if (RoadLayoutChangeNotificationEnabled(added)) NotifyRoadLayoutChanged(start, end);
 }
 
 void NotifyRoadLayoutChangedIfTileNonLeaf(TileIndex tile, RoadTramType rtt, RoadBits present_bits);
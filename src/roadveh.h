@@ -18,6 +18,7 @@
 #include "road_map.h"
 #include "newgrf_engine.h"
 #include <array>
+#include <vector>
 
 struct RoadVehicle;
 
@@ -90,9 +91,12 @@ void GetRoadVehSpriteSize(EngineID engine, uint &width, uint &height, int &xoffs
 struct RoadVehPathCache {
 	std::array<TileIndex, RV_PATH_CACHE_SEGMENTS> tile;
 	std::array<Trackdir, RV_PATH_CACHE_SEGMENTS> td;
+	std::array<std::vector<uint32_t>, RV_PATH_CACHE_SEGMENTS> regions; ///< Road layout regions crossed by the leg leading up to each choice tile.
+	std::vector<uint32_t> tail_regions;                                ///< Road layout regions crossed after the last choice tile.
 	uint32_t layout_ctr = 0;
 	uint8_t start = 0;
 	uint8_t count = 0;
+	bool regions_known = true;                                         ///< False if the regions were not recorded (path loaded from an older savegame).
 
 	inline bool empty() const { return this->count == 0; }
 	inline uint8_t size() const { return this->count; }
@@ -102,6 +106,8 @@ struct RoadVehPathCache {
 	{
 		this->start = 0;
 		this->count = 0;
+		this->tail_regions.clear();
+		this->regions_known = true;
 	}
 
 	inline TileIndex front_tile() const { return this->tile[this->start]; }
@@ -111,25 +117,39 @@ struct RoadVehPathCache {
 	inline TileIndex back_tile() const { return this->tile[this->back_index()]; }
 	inline Trackdir back_td() const { return this->td[this->back_index()]; }
 
-	/* push an item to the front of the ring, if the ring is already full, the back item is overwritten */
+	/* push an item to the front of the ring, if the ring is already full, the back item is overwritten and its leg becomes part of the tail */
 	inline void push_front(TileIndex tile, Trackdir td)
 	{
+		if (this->full()) this->merge_back_regions_into_tail();
 		this->start = (this->start - 1) & RV_PATH_CACHE_SEGMENT_MASK;
 		if (!this->full()) this->count++;
 		this->tile[this->start] = tile;
 		this->td[this->start] = td;
+		this->regions[this->start].clear();
 	}
 
 	inline void pop_front()
 	{
+		this->regions[this->start].clear();
 		this->start = (this->start + 1) & RV_PATH_CACHE_SEGMENT_MASK;
 		this->count--;
+		if (this->count == 0) this->tail_regions.clear();
 	}
 
+	/* remove the back item, its leg becomes part of the tail */
 	inline void pop_back()
 	{
+		this->merge_back_regions_into_tail();
 		this->count--;
 	}
+
+private:
+	inline void merge_back_regions_into_tail()
+	{
+		std::vector<uint32_t> &back = this->regions[this->back_index()];
+		this->tail_regions.insert(this->tail_regions.end(), back.begin(), back.end());
+		back.clear();
+	}
 };
 
 enum RoadVehicleFlags {
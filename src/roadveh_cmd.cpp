@@ -40,6 +40,7 @@
 #include "core/checksum_func.hpp"
 #include "newgrf_roadstop.h"
 #include "road_cmd.h"
+#include "road_func.h"
 
 #include "table/strings.h"
 
@@ -1167,6 +1168,27 @@ static int PickRandomBit(uint bits)
 	return i;
 }
 
+/**
+ * Check whether the road layout along a cached path is unchanged since the path was found.
+ * Each remaining leg of the path, and the part after the last choice tile, is checked against the road layout regions it crossed when the path was found.
+ * If no leg was affected, the cached path is revalidated against the current road layout change counter.
+ * @param cache Path cache to check.
+ * @return true if the cached path can still be used.
+ */
+static bool IsRoadVehPathCacheLayoutValid(RoadVehPathCache &cache)
+{
+	if (cache.layout_ctr == _road_layout_change_counter) return true;
+	if (!cache.regions_known) return false;
+
+	for (uint i = 0; i < cache.count; i++) {
+		if (HasRoadLayoutChangedSince(cache.regions[(cache.start + i) & RV_PATH_CACHE_SEGMENT_MASK], cache.layout_ctr)) return false;
+	}
+	if (HasRoadLayoutChangedSince(cache.tail_regions, cache.layout_ctr)) return false;
+
+	cache.layout_ctr = _road_layout_change_counter;
+	return true;
+}
+
 /**
  * Returns direction to for a road vehicle to take or
  * INVALID_TRACKDIR if the direction is currently blocked
@@ -1263,7 +1285,7 @@ static Trackdir RoadFindPathToDest(RoadVehicle *v, TileIndex tile, DiagDirection
 	}
 
 	/* Path cache is out of date, clear it */
-	if (v->cached_path != nullptr && !v->cached_path->empty() && v->cached_path->layout_ctr != _road_layout_change_counter) {
+	if (v->cached_path != nullptr && !v->cached_path->empty() && !IsRoadVehPathCacheLayoutValid(*v->cached_path)) {
 		v->cached_path->clear();
 	}
 
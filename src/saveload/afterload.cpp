@@ -23,6 +23,7 @@
 #include "../clear_map.h"
 #include "../vehicle_func.h"
 #include "../string_func.h"
+#include "../strings_func.h"
 #include "../date_func.h"
 #include "../roadveh.h"
 #include "../train.h"
@@ -40,6 +41,7 @@
 #include "../tree_map.h"
 #include "../company_func.h"
 #include "../road_cmd.h"
+#include "../road_func.h"
 #include "../ai/ai.hpp"
 #include "../script/script_gui.h"
 #include "../game/game.hpp"
@@ -4571,6 +4573,11 @@ bool AfterLoadGame()
 		UpdateAllSignalsSpecialPropagationFlag();
 	}
 
+	if (SlXvIsFeatureMissing(XSLFI_ROAD_LAYOUT_CHANGE_CTR, 2)) {
+		/* Per-region road layout versions were not saved, treat all regions as changed at the last layout change. */
+		std::fill(_road_layout_region_versions.begin(), _road_layout_region_versions.end(), _road_layout_change_counter);
+	}
+
 	UpdateCargoScalers();
 
 	if (_networking && !_network_server) {
@@ -4646,6 +4653,7 @@ void ReloadNewGRFData()
 	GfxLoadSprites();
 	RecomputePrices();
 	LoadStringWidthTable();
+	InvalidateFormattedStringCache();
 	/* reload vehicles */
 	ResetVehicleHash();
 	AfterLoadLabelMaps();
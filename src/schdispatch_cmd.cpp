@@ -87,6 +87,7 @@ CommandCost CmdSchDispatchAdd(DoCommandFlag flags, VehicleID veh, uint32_t sched
 			if (time >= ds.GetScheduledDispatchDuration()) time -= ds.GetScheduledDispatchDuration();
 			ds.AddScheduledDispatch(time);
 		}
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -115,6 +116,7 @@ CommandCost CmdSchDispatchRemove(DoCommandFlag flags, VehicleID veh, uint32_t sc
 
 	if (flags & DC_EXEC) {
 		v->orders->GetDispatchScheduleByIndex(schedule_index).RemoveScheduledDispatch(time);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -146,6 +148,7 @@ CommandCost CmdSchDispatchSetDuration(DoCommandFlag flags, VehicleID veh, uint32
 		DispatchSchedule &ds = v->orders->GetDispatchScheduleByIndex(schedule_index);
 		ds.SetScheduledDispatchDuration(duration);
 		ds.UpdateScheduledDispatch(nullptr);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -177,6 +180,7 @@ CommandCost CmdSchDispatchSetStartDate(DoCommandFlag flags, VehicleID veh, uint3
 		DispatchSchedule &ds = v->orders->GetDispatchScheduleByIndex(schedule_index);
 		ds.SetScheduledDispatchStartTick(start_tick);
 		ds.UpdateScheduledDispatch(nullptr);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -206,6 +210,7 @@ CommandCost CmdSchDispatchSetDelay(DoCommandFlag flags, VehicleID veh, uint32_t
 
 	if (flags & DC_EXEC) {
 		v->orders->GetDispatchScheduleByIndex(schedule_index).SetScheduledDispatchDelay(max_delay);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -235,6 +240,7 @@ CommandCost CmdSchDispatchSetReuseSlots(DoCommandFlag flags, VehicleID veh, uint
 
 	if (flags & DC_EXEC) {
 		v->orders->GetDispatchScheduleByIndex(schedule_index).SetScheduledDispatchReuseSlots(re_use_slots);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -268,6 +274,7 @@ CommandCost CmdSchDispatchResetLastDispatch(DoCommandFlag flags, VehicleID veh,
 
 	if (flags & DC_EXEC) {
 		v->orders->GetDispatchScheduleByIndex(schedule_index).SetScheduledDispatchLastDispatch(INVALID_SCHEDULED_DISPATCH_OFFSET);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -296,6 +303,7 @@ CommandCost CmdSchDispatchClear(DoCommandFlag flags, VehicleID veh, uint32_t sch
 
 	if (flags & DC_EXEC) {
 		v->orders->GetDispatchScheduleByIndex(schedule_index).ClearScheduledDispatch();
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -328,6 +336,7 @@ CommandCost CmdSchDispatchAddNewSchedule(DoCommandFlag flags, VehicleID veh, Sta
 		ds.SetScheduledDispatchDuration(duration);
 		ds.SetScheduledDispatchStartTick(start_tick);
 		ds.UpdateScheduledDispatch(nullptr);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -427,6 +436,7 @@ CommandCost CmdSchDispatchRenameSchedule(DoCommandFlag flags, VehicleID veh, uin
 		} else {
 			v->orders->GetDispatchScheduleByIndex(schedule_index).ScheduleName() = name;
 		}
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH | STWDF_ORDERS);
 	}
 
@@ -460,6 +470,7 @@ CommandCost CmdSchDispatchRenameTag(DoCommandFlag flags, VehicleID veh, uint32_t
 
 	if (flags & DC_EXEC) {
 		v->orders->GetDispatchScheduleByIndex(schedule_index).SetSupplementaryName(SDSNT_DEPARTURE_TAG, tag_id, name);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH | STWDF_ORDERS);
 	}
 
@@ -491,6 +502,7 @@ CommandCost CmdSchDispatchDuplicateSchedule(DoCommandFlag flags, VehicleID veh,
 		DispatchSchedule &ds = v->orders->GetScheduledDispatchScheduleSet().emplace_back(v->orders->GetDispatchScheduleByIndex(schedule_index));
 		ds.SetScheduledDispatchLastDispatch(INVALID_SCHEDULED_DISPATCH_OFFSET);
 		ds.UpdateScheduledDispatch(nullptr);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -526,6 +538,7 @@ CommandCost CmdSchDispatchAppendVehSchedules(DoCommandFlag flags, VehicleID dst_
 			ds.SetScheduledDispatchLastDispatch(INVALID_SCHEDULED_DISPATCH_OFFSET);
 			ds.UpdateScheduledDispatch(nullptr);
 		}
+		v1->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v1, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -560,6 +573,7 @@ CommandCost CmdSchDispatchAdjust(DoCommandFlag flags, VehicleID veh, uint32_t sc
 	if (flags & DC_EXEC) {
 		ds.AdjustScheduledDispatch(adjustment);
 		ds.UpdateScheduledDispatch(nullptr);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -603,6 +617,7 @@ CommandCost CmdSchDispatchAdjustSlot(DoCommandFlag flags, VehicleID veh, uint32_
 				slot.offset = new_offset;
 				ds.ResortDispatchOffsets();
 				ds.UpdateScheduledDispatch(nullptr);
+				v->orders->OnScheduleChanged();
 				SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 			}
 			CommandCost cost;
@@ -673,6 +688,7 @@ CommandCost CmdSchDispatchSwapSchedules(DoCommandFlag flags, VehicleID veh, uint
 			}
 		}
 		SchdispatchInvalidateWindows(v);
+		v->orders->OnScheduleChanged();
 		SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 	}
 
@@ -713,6 +729,7 @@ CommandCost CmdSchDispatchSetSlotFlags(DoCommandFlag flags, VehicleID veh, uint3
 				slot.flags &= ~mask;
 				slot.flags |= values;
 				SchdispatchInvalidateWindows(v);
+				v->orders->OnScheduleChanged();
 				SetTimetableWindowsDirty(v, STWDF_SCHEDULED_DISPATCH);
 			}
 			return CommandCost();
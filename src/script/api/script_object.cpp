@@ -54,10 +54,17 @@ static ScriptStorage *GetStorage()
 
 
 /* static */ ScriptInstance *ScriptObject::ActiveInstance::active = nullptr;
+/* static */ std::thread::id ScriptObject::ActiveInstance::active_thread;
 
 ScriptObject::ActiveInstance::ActiveInstance(ScriptInstance *instance) : alc_scope(instance->engine)
 {
 	this->last_active = ScriptObject::ActiveInstance::active;
+	if (this->last_active == nullptr) {
+		ScriptObject::ActiveInstance::active_thread = std::this_thread::get_id();
+	} else {
+		/* The script API is not thread safe, see ScriptObject. */
+		assert(ScriptObject::ActiveInstance::active_thread == std::this_thread::get_id());
+	}
 	ScriptObject::ActiveInstance::active = instance;
 }
 
@@ -69,6 +76,8 @@ ScriptObject::ActiveInstance::~ActiveInstance()
 /* static */ ScriptInstance *ScriptObject::GetActiveInstance()
 {
 	assert(ScriptObject::ActiveInstance::active != nullptr);
+	/* The script API is not thread safe, see ScriptObject. */
+	assert(ScriptObject::ActiveInstance::active_thread == std::this_thread::get_id());
 	return ScriptObject::ActiveInstance::active;
 }
 
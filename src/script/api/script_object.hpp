@@ -21,6 +21,7 @@
 #include "../script_suspend.hpp"
 #include "../squirrel.hpp"
 
+#include <thread>
 #include <utility>
 
 /**
@@ -66,6 +67,20 @@ private:
  *   your script, as it doesn't publish any public functions. It is used
  *   internally to have a common place to handle general things, like internal
  *   command processing, and command-validation checks.
+ *
+ * Thread safety: no part of the script API may be called from more than one
+ *   thread, so script VMs cannot be run concurrently. All API calls depend on
+ *   process wide state:
+ *   - the active instance and its storage (delay, modes, last command result,
+ *     event queue, log), see ActiveInstance and GetActiveInstance;
+ *   - the Squirrel allocator of the active VM (_squirrel_allocator);
+ *   - _current_company, which every DoCommand, company and list call reads;
+ *   - the global string parameters used by ScriptText and name getters;
+ *   - the game state itself, which commands are test-run against and which
+ *     every getter reads without locking.
+ *   Activating an instance records the calling thread, and an assertion flags
+ *   any API call, or activation of another instance, from a different thread
+ *   while an instance is active.
  * @api none
  */
 class ScriptObject : public SimpleCountedObject {
@@ -89,6 +104,7 @@ protected:
 		ScriptAllocatorScope alc_scope; ///< Keep the correct allocator for the script instance activated
 
 		static ScriptInstance *active;  ///< The global current active instance.
+		static std::thread::id active_thread; ///< The thread which activated the outermost active instance.
 	};
 
 	/**
@@ -12,6 +12,8 @@
 #include "script_group.hpp"
 #include "script_map.hpp"
 #include "script_station.hpp"
+#include "../../date_func.h"
+#include "../../departures_func.h"
 #include "../../depot_map.h"
 #include "../../vehicle_base.h"
 #include "../../vehiclelist_func.h"
@@ -78,6 +80,26 @@ ScriptVehicleList_Station::ScriptVehicleList_Station(StationID station_id)
 	);
 }
 
+ScriptVehicleList_Departures::ScriptVehicleList_Departures(StationID station_id, bool arrivals)
+{
+	EnforceDeityOrCompanyModeValid_Void();
+	if (!ScriptStation::IsValidStation(station_id)) return;
+
+	bool is_deity = ScriptCompanyMode::IsDeity();
+	::CompanyID owner = ScriptObject::GetCompany();
+
+	DepartureCallingSettings settings;
+	settings.SetCargoFilter(true, true);
+	const DepartureList departures = MakeStationDepartureList(station_id, DSM_LIVE, arrivals ? D_ARRIVAL : D_DEPARTURE, settings);
+
+	/* The list is sorted by scheduled time, so the first entry of each vehicle is its earliest. */
+	for (const std::unique_ptr<Departure> &d : departures) {
+		if (!is_deity && d->vehicle->owner != owner) continue;
+		if (this->HasItem(d->vehicle->index)) continue;
+		this->AddItem(d->vehicle->index, (d->scheduled_tick - _state_ticks).AsTicks());
+	}
+}
+
 ScriptVehicleList_Depot::ScriptVehicleList_Depot(TileIndex tile)
 {
 	EnforceDeityOrCompanyModeValid_Void();
@@ -65,6 +65,23 @@ public:
 	ScriptVehicleList_Station(StationID station_id);
 };
 
+/**
+ * Creates a list of vehicles which are next due to depart from, or arrive at, a given station,
+ * as shown on the station's departure board.
+ * The value of each vehicle is the number of ticks until its first scheduled departure or arrival.
+ * @api ai game
+ * @ingroup ScriptList
+ */
+class ScriptVehicleList_Departures : public ScriptList {
+public:
+	/**
+	 * @param station_id The station to get the departures or arrivals of.
+	 * @param arrivals Whether to list arrivals instead of departures.
+	 * @pre ScriptStation::IsValidStation(station_id)
+	 */
+	ScriptVehicleList_Departures(StationID station_id, bool arrivals);
+};
+
 /**
  * Creates a list of vehicles that have orders to a given depot.
  * The list is created with a tile. If the tile is part of an airport all
@@ -878,6 +878,29 @@ struct ScriptDebugWindow : public Window {
 		}
 	}
 
+	bool OnTooltip([[maybe_unused]] Point pt, WidgetID widget, TooltipCloseCondition close_cond) override
+	{
+		if (widget != WID_SCRD_NAME_TEXT) return false;
+
+		const ScriptInstance *instance = nullptr;
+		if (this->filter.script_debug_company == OWNER_DEITY) {
+			instance = Game::GetInstance();
+		} else if (Company::IsValidAiID(this->filter.script_debug_company)) {
+			instance = Company::Get(this->filter.script_debug_company)->ai_instance.get();
+		}
+		if (instance == nullptr) return false;
+
+		const ScriptAllocatorStats stats = instance->GetAllocatorStats();
+		SetDParam(0, STR_AI_DEBUG_NAME_TOOLTIP);
+		SetDParam(1, stats.allocated_size);
+		SetDParam(2, stats.small_allocations);
+		SetDParam(3, stats.slab_in_use);
+		SetDParam(4, stats.slab_reserved);
+		SetDParam(5, stats.large_allocations);
+		GuiShowTooltips(this, STR_AI_DEBUG_NAME_TOOLTIP_MEMORY, close_cond, 6);
+		return true;
+	}
+
 	void DrawWidget(const Rect &r, WidgetID widget) const override
 	{
 		switch (widget) {
@@ -297,6 +297,20 @@ void ScriptInstance::GameLoop()
 	}
 }
 
+/**
+ * Advance a script which keeps sleeping during this tick, without the setup needed to run its VM.
+ * The result is the same as that of #GameLoop for such a script.
+ * @return True if the tick has been handled, false if #GameLoop needs to be called.
+ */
+bool ScriptInstance::SkipSleepingTick()
+{
+	if (this->IsDead() || this->is_paused || this->suspend <= 1 || this->engine->HasScriptCrashed()) return false;
+
+	this->controller->ticks++;
+	this->suspend--;
+	return true;
+}
+
 void ScriptInstance::CollectGarbage()
 {
 	if (this->is_started && !this->IsDead()) {
@@ -874,6 +888,16 @@ size_t ScriptInstance::GetAllocatedMemory() const
 	return this->engine->GetAllocatedMemory();
 }
 
+ScriptAllocatorStats ScriptInstance::GetAllocatorStats() const
+{
+	if (this->engine == nullptr) {
+		ScriptAllocatorStats stats;
+		stats.allocated_size = this->last_allocated_memory;
+		return stats;
+	}
+	return this->engine->GetAllocatorStats();
+}
+
 void ScriptInstance::SetMemoryAllocationLimit(size_t limit) const
 {
 	if (this->engine != nullptr) this->engine->SetMemoryAllocationLimit(limit);
@@ -85,6 +85,8 @@ public:
 	 */
 	void GameLoop();
 
+	bool SkipSleepingTick();
+
 	/**
 	 * Let the VM collect any garbage.
 	 */
@@ -258,6 +260,8 @@ public:
 
 	size_t GetAllocatedMemory() const;
 
+	ScriptAllocatorStats GetAllocatorStats() const;
+
 	void SetMemoryAllocationLimit(size_t limit) const;
 
 	/**
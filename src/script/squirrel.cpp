@@ -38,6 +38,81 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 		throw Script_FatalError("Maximum memory allocation exceeded");
 	}
 
+	/**
+	 * Allocate a block of memory, from the slabs when it is small enough.
+	 * @param size The size of the block.
+	 * @return The block, or nullptr when the system allocator failed.
+	 */
+	void *ScriptAllocator::AllocateBlock(size_t size)
+	{
+		if (size > SLAB_MAX_BLOCK_SIZE) {
+			void *p = malloc(size);
+			if (p != nullptr) this->large_allocations++;
+			return p;
+		}
+
+		size_t size_class = GetSizeClass(size);
+		size_t block_size = (size_class + 1) * SLAB_GRANULARITY;
+		FreeSlabBlock *block = this->free_blocks[size_class];
+		if (block != nullptr) {
+			this->free_blocks[size_class] = block->next;
+		} else {
+			if (static_cast<size_t>(this->slab_end - this->slab_pos) < block_size) {
+				/* The remainder of the current slab is too small, it is left unused. */
+				uint8_t *slab = static_cast<uint8_t *>(malloc(SLAB_SIZE));
+				if (slab == nullptr) return nullptr;
+				this->slabs.push_back(slab);
+				this->slab_pos = slab;
+				this->slab_end = slab + SLAB_SIZE;
+			}
+			block = reinterpret_cast<FreeSlabBlock *>(this->slab_pos);
+			this->slab_pos += block_size;
+		}
+
+		this->slab_in_use += block_size;
+		this->small_allocations++;
+		return block;
+	}
+
+	/**
+	 * Free a block of memory allocated by #AllocateBlock.
+	 * Blocks from the slabs are kept in the free list of their size class for reuse.
+	 * @param p The block.
+	 * @param size The size the block was allocated with.
+	 */
+	void ScriptAllocator::FreeBlock(void *p, size_t size)
+	{
+		if (size > SLAB_MAX_BLOCK_SIZE) {
+			free(p);
+			this->large_allocations--;
+			return;
+		}
+
+		size_t size_class = GetSizeClass(size);
+		FreeSlabBlock *block = static_cast<FreeSlabBlock *>(p);
+		block->next = this->free_blocks[size_class];
+		this->free_blocks[size_class] = block;
+
+		this->slab_in_use -= (size_class + 1) * SLAB_GRANULARITY;
+		this->small_allocations--;
+	}
+
+	/**
+	 * Release all slabs back to the system, when no small allocations remain.
+	 */
+	void ScriptAllocator::ReleaseSlabs()
+	{
+		assert(this->small_allocations == 0);
+
+		for (void *slab : this->slabs) {
+			free(slab);
+		}
+		this->slabs.clear();
+		this->free_blocks.fill(nullptr);
+		this->slab_pos = nullptr;
+		this->slab_end = nullptr;
+	}
+
 	/**
 	 * Catch all validation for the allocation; did it allocate too much memory according
 	 * to the allocation limit or did the allocation at the OS level maybe fail? In those
@@ -46,15 +121,16 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 	 * clean everything up.
 	 * @param requested_size The requested size that was requested to be allocated.
 	 * @param p              The pointer to the allocated object, or null if allocation failed.
+	 * @param block_size     The size \a p was allocated with.
 	 */
-	void ScriptAllocator::CheckAllocation(size_t requested_size, void *p)
+	void ScriptAllocator::CheckAllocation(size_t requested_size, void *p, size_t block_size)
 	{
 		if (this->allocated_size + requested_size > this->allocation_limit && !this->error_thrown) {
 			/* Do not allow allocating more than the allocation limit, except when an error is
 			 * already as then the allocation is for throwing that error in Squirrel, the
 			 * associated stack trace information and while cleaning up the AI. */
 			/* Don't leak the rejected allocation. */
-			free(p);
+			if (p != nullptr) this->FreeBlock(p, block_size);
 			this->error_thrown = true;
 			throw Script_FatalError(fmt::format("Maximum memory allocation exceeded by {} bytes when allocating {} bytes",
 					this->allocated_size + requested_size - this->allocation_limit, requested_size));
@@ -77,9 +153,9 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 
 	void *ScriptAllocator::Malloc(SQUnsignedInteger size)
 	{
-		void *p = malloc(size);
+		void *p = this->AllocateBlock(size);
 
-		this->CheckAllocation(size, p);
+		this->CheckAllocation(size, p, size);
 
 		this->allocated_size += size;
 
@@ -102,6 +178,18 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 			return nullptr;
 		}
 
+		if (oldsize <= SLAB_MAX_BLOCK_SIZE && size <= SLAB_MAX_BLOCK_SIZE && GetSizeClass(oldsize) == GetSizeClass(size) &&
+				this->allocated_size + size <= this->allocation_limit + oldsize) {
+			/* The block is large enough already, only the accounting changes. */
+			this->allocated_size -= oldsize;
+			this->allocated_size += size;
+#ifdef SCRIPT_DEBUG_ALLOCATIONS
+			assert(this->allocations[p] == oldsize);
+			this->allocations[p] = size;
+#endif
+			return p;
+		}
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations[p] == oldsize);
 		this->allocations.erase(p);
@@ -110,13 +198,13 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 		 * If memory exception is thrown, the old pointer is expected
 		 * to be valid for engine cleanup.
 		 */
-		void *new_p = malloc(size);
+		void *new_p = this->AllocateBlock(size);
 
-		this->CheckAllocation(size - oldsize, new_p);
+		this->CheckAllocation(size - oldsize, new_p, size);
 
 		/* Memory limit test passed, we can copy data and free old pointer. */
 		memcpy(new_p, p, std::min(oldsize, size));
-		free(p);
+		this->FreeBlock(p, oldsize);
 
 		this->allocated_size -= oldsize;
 		this->allocated_size += size;
@@ -133,7 +221,7 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 	void ScriptAllocator::Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		free(p);
+		this->FreeBlock(p, size);
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -142,6 +230,17 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 #endif
 	}
 
+	ScriptAllocatorStats ScriptAllocator::GetStats() const
+	{
+		ScriptAllocatorStats stats;
+		stats.allocated_size = this->allocated_size;
+		stats.slab_reserved = this->slabs.size() * SLAB_SIZE;
+		stats.slab_in_use = this->slab_in_use;
+		stats.small_allocations = this->small_allocations;
+		stats.large_allocations = this->large_allocations;
+		return stats;
+	}
+
 	ScriptAllocator::ScriptAllocator()
 	{
 		this->allocated_size = 0;
@@ -155,6 +254,7 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.empty());
 #endif
+		this->ReleaseSlabs();
 	}
 
 /**
@@ -747,6 +847,9 @@ void Squirrel::Uninitialize()
 
 	assert(this->allocator.allocated_size == 0);
 
+	/* Everything of the VM has been freed, release its whole arena at once. */
+	this->allocator.ReleaseSlabs();
+
 	/* Reset memory allocation errors. */
 	this->allocator.error_thrown = false;
 }
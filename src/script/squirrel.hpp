@@ -17,6 +17,8 @@
  */
 
 #include <squirrel.h>
+#include <array>
+#include <vector>
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 #	include <map>
 #endif
@@ -27,12 +29,45 @@ enum class ScriptType : uint8_t {
 	GS, ///< The script is for Game scripts.
 };
 
+/** Statistics of the memory allocator of a script. */
+struct ScriptAllocatorStats {
+	size_t allocated_size = 0;    ///< Sum of allocated data size, as counted against the allocation limit.
+	size_t slab_reserved = 0;     ///< Memory reserved for slabs of small allocations.
+	size_t slab_in_use = 0;       ///< Memory of the slab blocks currently in use, including size class rounding.
+	size_t small_allocations = 0; ///< Number of live allocations served from the slabs.
+	size_t large_allocations = 0; ///< Number of live allocations served by the system allocator.
+};
+
+/**
+ * Memory allocator of a single script VM.
+ * Small allocations, which are most of the tables, arrays, closures and their nodes,
+ * are served from per size class free lists in slabs owned by the allocator.
+ * The slabs are only released when the VM is torn down.
+ */
 class ScriptAllocator {
 	friend class Squirrel;
 
 private:
+	static constexpr size_t SLAB_GRANULARITY = 8;                                      ///< Size difference between two successive size classes, also the alignment of small allocations.
+	static constexpr size_t SLAB_MAX_BLOCK_SIZE = 256;                                 ///< Largest allocation which is served from the slabs.
+	static constexpr size_t SLAB_SIZE_CLASSES = SLAB_MAX_BLOCK_SIZE / SLAB_GRANULARITY; ///< Number of size classes.
+	static constexpr size_t SLAB_SIZE = 64 * 1024;                                     ///< Size of a single slab.
+
+	/** Header of a free block within a slab. */
+	struct FreeSlabBlock {
+		FreeSlabBlock *next; ///< Next free block of the same size class.
+	};
+
 	size_t allocated_size;   ///< Sum of allocated data size
 	size_t allocation_limit; ///< Maximum this allocator may use before allocations fail
+
+	std::array<FreeSlabBlock *, SLAB_SIZE_CLASSES> free_blocks{}; ///< Free lists of each size class.
+	std::vector<void *> slabs;                                ///< All slabs owned by this allocator.
+	uint8_t *slab_pos = nullptr;                              ///< First unused byte of the last slab.
+	uint8_t *slab_end = nullptr;                              ///< End of the last slab.
+	size_t slab_in_use = 0;                                   ///< Memory of the slab blocks currently in use.
+	size_t small_allocations = 0;                             ///< Number of live allocations served from the slabs.
+	size_t large_allocations = 0;                             ///< Number of live allocations served by the system allocator.
 	/**
 	 * Whether the error has already been thrown, so to not throw secondary errors in
 	 * the handling of the allocation error. This as the handling of the error will
@@ -47,17 +82,33 @@ private:
 
 	void CheckLimitFailed() const;
 
+	/**
+	 * Get the size class of a small allocation.
+	 * @param size The size of the allocation, at most #SLAB_MAX_BLOCK_SIZE.
+	 * @return The index of the size class.
+	 */
+	static inline size_t GetSizeClass(size_t size)
+	{
+		return size == 0 ? 0 : (size - 1) / SLAB_GRANULARITY;
+	}
+
+	void *AllocateBlock(size_t size);
+	void FreeBlock(void *p, size_t size);
+	void ReleaseSlabs();
+
 public:
 	inline void CheckLimit() const
 	{
 		if (this->allocated_size > this->allocation_limit) this->CheckLimitFailed();
 	}
 
-	void CheckAllocation(size_t requested_size, void *p);
+	void CheckAllocation(size_t requested_size, void *p, size_t block_size);
 	void *Malloc(SQUnsignedInteger size);
 	void *Realloc(void *p, SQUnsignedInteger oldsize, SQUnsignedInteger size);
 	void Free(void *p, SQUnsignedInteger size);
 
+	ScriptAllocatorStats GetStats() const;
+
 	ScriptAllocator();
 	~ScriptAllocator();
 };
@@ -330,6 +381,11 @@ public:
 	 */
 	size_t GetAllocatedMemory() const noexcept;
 
+	/**
+	 * Get the statistics of the memory allocator of this engine.
+	 */
+	ScriptAllocatorStats GetAllocatorStats() const noexcept { return this->allocator.GetStats(); }
+
 	void SetMemoryAllocationLimit(size_t limit) noexcept;
 
 	static inline void IncreaseAllocatedSize(size_t bytes);
@@ -3159,6 +3159,7 @@ void IntSettingDesc::ChangeValue(const void *object, int32_t newval, SaveToConfi
 
 	this->Write(object, newval);
 	if (this->post_callback != nullptr) this->post_callback(newval);
+	InvalidateFormattedStringCache();
 
 	if (this->flags.Test(SettingFlag::NoNetwork) || this->flags.Test(SettingFlag::Sandbox)) {
 		GamelogStartAction(GLAT_SETTING);
@@ -3444,6 +3445,7 @@ void StringSettingDesc::ChangeValue(const void *object, std::string &newval, Sav
 
 	this->Write(object, newval);
 	if (this->post_callback != nullptr) this->post_callback(newval);
+	InvalidateFormattedStringCache();
 
 	if (_save_config) SaveToConfig(ini_save_flags);
 }
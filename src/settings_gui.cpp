@@ -3680,6 +3680,7 @@ struct CustomCurrencyWindow : Window {
 				break;
 			}
 		}
+		InvalidateFormattedStringCache();
 		MarkWholeScreenDirty();
 		SetButtonState();
 	}
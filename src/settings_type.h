@@ -475,6 +475,7 @@ struct NetworkSettings {
 	uint16_t      server_port;                            ///< port the server listens on
 	uint16_t      server_admin_port;                      ///< port the server listens on for the admin network
 	bool        server_admin_chat;                        ///< allow private chat for the server to be distributed to the admin network
+	uint16_t      admin_performance_interval;             ///< interval in seconds between automatic performance updates to the admin network
 	ServerGameType server_game_type;                      ///< Server type: local / public / invite-only.
 	std::string server_invite_code;                       ///< Invite code to use when registering as server.
 	std::string server_invite_code_secret;                ///< Secret to proof we got this invite code from the Game Coordinator.
@@ -637,6 +638,7 @@ struct YAPFSettings {
 	uint32_t road_stop_penalty;                ///< penalty for going through a drive-through road stop
 	uint32_t road_stop_occupied_penalty;       ///< penalty multiplied by the fill percentage of a drive-through road stop
 	uint32_t road_stop_bay_occupied_penalty;   ///< penalty multiplied by the fill percentage of a road bay
+	uint16_t road_region_max_detour;            ///< maximum detour in percent of a path restricted to a corridor of road regions, 0 to not restrict road vehicle searches
 	bool   rail_firstred_twoway_eol;           ///< treat first red two-way signal as dead end
 	uint32_t rail_firstred_penalty;            ///< penalty for first red signal
 	uint32_t rail_firstred_exit_penalty;       ///< penalty for first red exit signal
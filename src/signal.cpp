@@ -106,11 +106,16 @@ SignalType NextSignalType(SignalType cur, SignalCycleGroups which_signals)
 /**
  * Set containing 'items' items of 'tile and Tdir'
  * No tree structure is used because it would cause
- * slowdowns in most usual cases
+ * slowdowns in most usual cases.
+ * The number of items in each of a small number of hash buckets is counted, so that
+ * searches for items which are not in the set (the usual case) can mostly be skipped.
  */
 template <typename Tdir, uint items>
 struct SmallSet {
 private:
+	static constexpr uint BUCKET_COUNT = 64;
+	static_assert(items <= UINT16_MAX);
+
 	uint n;           // actual number of units
 	bool overflowed;  // did we try to overflow the set?
 	const char *name; // name, used for debugging purposes...
@@ -121,15 +126,24 @@ private:
 		Tdir dir;
 	} data[items];
 
+	uint16_t bucket_items[BUCKET_COUNT]; // number of units in each bucket
+
+	static inline uint GetBucket(TileIndex tile, Tdir dir)
+	{
+		return ((tile.base() * 4 + (uint)dir) * 0x9E3779B1U) >> 26;
+	}
+	static_assert(BUCKET_COUNT == 1 << (32 - 26));
+
 public:
 	/** Constructor - just set default values and 'name' */
-	SmallSet(const char *name) : n(0), overflowed(false), name(name) { }
+	SmallSet(const char *name) : n(0), overflowed(false), name(name), bucket_items{} { }
 
 	/** Reset variables to default values */
 	void Reset()
 	{
 		this->n = 0;
 		this->overflowed = false;
+		std::fill(std::begin(this->bucket_items), std::end(this->bucket_items), 0);
 	}
 
 	/**
@@ -177,9 +191,13 @@ public:
 	 */
 	bool Remove(TileIndex tile, Tdir dir)
 	{
+		const uint bucket = GetBucket(tile, dir);
+		if (this->bucket_items[bucket] == 0) return false;
+
 		for (uint i = 0; i < this->n; i++) {
 			if (this->data[i].tile == tile && this->data[i].dir == dir) {
 				this->data[i] = this->data[--this->n];
+				this->bucket_items[bucket]--;
 				return true;
 			}
 		}
@@ -195,6 +213,8 @@ public:
 	 */
 	bool IsIn(TileIndex tile, Tdir dir)
 	{
+		if (this->bucket_items[GetBucket(tile, dir)] == 0) return false;
+
 		for (uint i = 0; i < this->n; i++) {
 			if (this->data[i].tile == tile && this->data[i].dir == dir) return true;
 		}
@@ -220,6 +240,7 @@ public:
 		this->data[this->n].tile = tile;
 		this->data[this->n].dir = dir;
 		this->n++;
+		this->bucket_items[GetBucket(tile, dir)]++;
 
 		return true;
 	}
@@ -237,6 +258,7 @@ public:
 		this->n--;
 		*tile = this->data[this->n].tile;
 		*dir = this->data[this->n].dir;
+		this->bucket_items[GetBucket(*tile, *dir)]--;
 
 		return true;
 	}
@@ -39,6 +39,7 @@ Sign::~Sign()
 	if (CleaningPool()) return;
 
 	DeleteRenameSignWindow(this->index);
+	InvalidateFormattedStringCache();
 }
 
 /**
@@ -135,7 +135,7 @@ const std::initializer_list<SlxiSubChunkInfo> _sl_xv_sub_chunk_infos = {
 	{ XSLFI_RV_OVERTAKING,                    XSCF_NULL,                2,   2, "roadveh_overtaking",               nullptr, nullptr, nullptr          },
 	{ XSLFI_LINKGRAPH_MODES,                  XSCF_NULL,                1,   1, "linkgraph_modes",                  nullptr, nullptr, nullptr          },
 	{ XSLFI_GAME_EVENTS,                      XSCF_NULL,                1,   1, "game_events",                      nullptr, nullptr, nullptr          },
-	{ XSLFI_ROAD_LAYOUT_CHANGE_CTR,           XSCF_NULL,                1,   1, "road_layout_change_ctr",           nullptr, nullptr, nullptr          },
+	{ XSLFI_ROAD_LAYOUT_CHANGE_CTR,           XSCF_NULL,                3,   3, "road_layout_change_ctr",           nullptr, nullptr, "RLRV"           },
 	{ XSLFI_TOWN_CARGO_MATRIX,                XSCF_NULL,                0,   1, "town_cargo_matrix",                nullptr, nullptr, nullptr          },
 	{ XSLFI_STATE_CHECKSUM,                   XSCF_NULL,                1,   1, "state_checksum",                   nullptr, nullptr, nullptr          },
 	{ XSLFI_DEBUG,                            XSCF_IGNORABLE_ALL,       2,   2, "debug",                            nullptr, nullptr, "DBGD"           },
@@ -57,7 +57,7 @@ static void Check_MAPS()
 
 static void Load_MAPT()
 {
-	Tile *m = _m.tile_data;
+	auto m = _m.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		m->type = val;
 		m++;
@@ -86,7 +86,7 @@ static void Load_MAPH()
 		if (SlGetFieldLength() != 0) {
 			_sl_xv_feature_versions[XSLFI_HEIGHT_8_BIT] = 2;
 
-			Tile *m = _m.tile_data;
+			auto m = _m.begin();
 			ReadBuffer::GetCurrent()->ReadUint16sToHandler(Map::Size(), [&](uint16_t val) {
 				m->height = val;
 				m++;
@@ -95,7 +95,7 @@ static void Load_MAPH()
 		return;
 	}
 
-	Tile *m = _m.tile_data;
+	auto m = _m.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		m->height = val;
 		m++;
@@ -104,7 +104,7 @@ static void Load_MAPH()
 
 static void Load_MAP1()
 {
-	Tile *m = _m.tile_data;
+	auto m = _m.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		m->m1 = val;
 		m++;
@@ -113,7 +113,7 @@ static void Load_MAP1()
 
 static void Load_MAP2()
 {
-	Tile *m = _m.tile_data;
+	auto m = _m.begin();
 	if (IsSavegameVersionBefore(SLV_5)) {
 		/* In those versions the m2 was 8 bits */
 		ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
@@ -130,7 +130,7 @@ static void Load_MAP2()
 
 static void Load_MAP3()
 {
-	Tile *m = _m.tile_data;
+	auto m = _m.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		m->m3 = val;
 		m++;
@@ -139,7 +139,7 @@ static void Load_MAP3()
 
 static void Load_MAP4()
 {
-	Tile *m = _m.tile_data;
+	auto m = _m.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		m->m4 = val;
 		m++;
@@ -148,7 +148,7 @@ static void Load_MAP4()
 
 static void Load_MAP5()
 {
-	Tile *m = _m.tile_data;
+	auto m = _m.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		m->m5 = val;
 		m++;
@@ -159,7 +159,7 @@ static void Load_MAP6()
 {
 	const uint32_t size = Map::Size();
 
-	TileExtended *me = _me.tile_data;
+	auto me = _me.begin();
 	if (IsSavegameVersionBefore(SLV_42)) {
 		ReadBuffer::GetCurrent()->ReadBytesToHandler(size / 4, [&](uint8_t val) {
 			me[0].m6 = GB(val, 0, 2);
@@ -178,7 +178,7 @@ static void Load_MAP6()
 
 static void Load_MAP7()
 {
-	TileExtended *me = _me.tile_data;
+	auto me = _me.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		me->m7 = val;
 		me++;
@@ -187,7 +187,7 @@ static void Load_MAP7()
 
 static void Load_MAP8()
 {
-	TileExtended *me = _me.tile_data;
+	auto me = _me.begin();
 	ReadBuffer::GetCurrent()->ReadUint16sToHandler(Map::Size(), [&](uint16_t val) {
 		me->m8 = val;
 		me++;
@@ -195,7 +195,7 @@ static void Load_MAP8()
 }
 static void Load_MAP9()
 {
-	TileExtended *me = _me.tile_data;
+	auto me = _me.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		me->m9 = val;
 		me++;
@@ -203,7 +203,7 @@ static void Load_MAP9()
 }
 static void Load_MAPX()
 {
-	TileExtended *me = _me.tile_data;
+	auto me = _me.begin();
 	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
 		me->m10= val;
 		me++;
@@ -218,12 +218,10 @@ static void Load_WMAP()
 	ReadBuffer *reader = ReadBuffer::GetCurrent();
 	const uint32_t size = Map::Size();
 
-	if constexpr (std::endian::native == std::endian::little) {
+	if constexpr (std::endian::native == std::endian::little && !MAP_INTERLEAVED) {
 		reader->CopyBytes((uint8_t *) _m.tile_data, size * 8);
 	} else {
-		Tile *m_start = _m.tile_data;
-		Tile *m_end = _m.tile_data + size;
-		for (Tile *m = m_start; m != m_end; m++) {
+		for (auto m = _m.begin(); m != _m.end(); m++) {
 			RawReadBuffer buf = reader->ReadRawBytes(8);
 			m->type = buf.RawReadByte();
 			m->height = buf.RawReadByte();
@@ -237,10 +235,8 @@ static void Load_WMAP()
 		}
 	}
 
-	TileExtended *me_start = _me.tile_data;
-	TileExtended *me_end = _me.tile_data + size;
 	if (_sl_xv_feature_versions[XSLFI_WHOLE_MAP_CHUNK] == 1) {
-		for (TileExtended *me = me_start; me != me_end; me++) {
+		for (auto me = _me.begin(); me != _me.end(); me++) {
 			RawReadBuffer buf = reader->ReadRawBytes(4);
 			me->m6 = buf.RawReadByte();
 			me->m7 = buf.RawReadByte();
@@ -248,10 +244,10 @@ static void Load_WMAP()
 			me->m10 = buf.RawReadByte();
 		}
 	} else if (_sl_xv_feature_versions[XSLFI_WHOLE_MAP_CHUNK] == 2) {
-		if constexpr (std::endian::native == std::endian::little) {
+		if constexpr (std::endian::native == std::endian::little && !MAP_INTERLEAVED) {
 			reader->CopyBytes((uint8_t *) _me.tile_data, size * 6);
 		} else {
-			for (TileExtended *me = me_start; me != me_end; me++) {
+			for (auto me = _me.begin(); me != _me.end(); me++) {
 				RawReadBuffer buf = reader->ReadRawBytes(6);
 				me->m6 = buf.RawReadByte();
 				me->m7 = buf.RawReadByte();
@@ -277,13 +273,11 @@ static void Save_WMAP()
 	const uint32_t size = Map::Size();
 	SlSetLength(size * 14	);
 
-	if constexpr (std::endian::native == std::endian::little) {
+	if constexpr (std::endian::native == std::endian::little && !MAP_INTERLEAVED) {
 		dumper->CopyBytes((uint8_t *) _m.tile_data, size * 8);
 		dumper->CopyBytes((uint8_t *) _me.tile_data, size * 6);
 	} else {
-		Tile *m_start = _m.tile_data;
-		Tile *m_end = _m.tile_data + size;
-		for (Tile *m = m_start; m != m_end; m++) {
+		for (auto m = _m.begin(); m != _m.end(); m++) {
 			RawMemoryDumper dump = dumper->RawWriteBytes(8);
 			dump.RawWriteByte(m->type);
 			dump.RawWriteByte(m->height);
@@ -294,9 +288,7 @@ static void Save_WMAP()
 			dump.RawWriteByte(m->m4);
 			dump.RawWriteByte(m->m5);
 		}
-		TileExtended *me_start = _me.tile_data;
-		TileExtended *me_end = _me.tile_data + size;
-		for (TileExtended *me = me_start; me != me_end; me++) {
+		for (auto me = _me.begin(); me != _me.end(); me++) {
 			RawMemoryDumper dump = dumper->RawWriteBytes(6);
 			dump.RawWriteByte(me->m6);
 			dump.RawWriteByte(me->m7);
@@ -309,17 +301,17 @@ static void Save_WMAP()
 }
 
 struct MapTileReader {
-	Tile *m;
+	MapTilePtr<Tile>::iterator m;
 
-	MapTileReader() { this->m = _m.tile_data; }
-	Tile *Next() { return this->m++; }
+	MapTileReader() : m(_m.begin()) {}
+	Tile *Next() { return &*(this->m++); }
 };
 
 struct MapTileExtendedReader {
-	TileExtended *me;
+	MapTilePtr<TileExtended>::iterator me;
 
-	MapTileExtendedReader() { this->me = _me.tile_data; }
-	TileExtended *Next() { return this->me++; }
+	MapTileExtendedReader() : me(_me.begin()) {}
+	TileExtended *Next() { return &*(this->me++); }
 };
 
 struct MAPT : MapTileReader {
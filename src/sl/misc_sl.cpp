@@ -18,6 +18,7 @@
 #include "../fios.h"
 #include "../load_check.h"
 #include "../road_type.h"
+#include "../road_func.h"
 #include "../core/checksum_func.hpp"
 #include "../event_logs.h"
 #include "../timer/timer.h"
@@ -207,10 +208,29 @@ static void Load_MISC()
 	SlGlobList(_misc_desc);
 }
 
+/* Save load the per-region road layout versions */
+static void Save_RLRV()
+{
+	SlSetLength(_road_layout_region_versions.size() * sizeof(uint32_t));
+	for (uint32_t version : _road_layout_region_versions) {
+		SlWriteUint32(version);
+	}
+}
+
+static void Load_RLRV()
+{
+	const size_t count = SlGetFieldLength() / sizeof(uint32_t);
+	if (count != _road_layout_region_versions.size()) SlErrorCorrupt("RLRV chunk size does not match map size");
+	for (uint32_t &version : _road_layout_region_versions) {
+		version = SlReadUint32();
+	}
+}
+
 static const ChunkHandler misc_chunk_handlers[] = {
 	{ 'DATE', Save_DATE, Load_DATE, nullptr, Check_DATE, CH_TABLE },
 	MakeSaveUpstreamFeatureConditionalLoadUpstreamChunkHandler<'VIEW', XSLFI_TABLE_MISC_SL>(Load_VIEW, nullptr, nullptr),
 	{ 'MISC', nullptr, Load_MISC, nullptr, nullptr, CH_READONLY },
+	{ 'RLRV', Save_RLRV, Load_RLRV, nullptr, nullptr, CH_RIFF },
 };
 
 extern const ChunkHandlerTable _misc_chunk_handlers(misc_chunk_handlers);
@@ -50,6 +50,7 @@
 #include "../core/ring_buffer.hpp"
 #include "../timer/timer_game_tick.h"
 #include <atomic>
+#include <chrono>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -3852,6 +3853,19 @@ static inline void ClearSaveLoadState()
 	GamelogStopAnyAction();
 }
 
+static std::chrono::steady_clock::time_point _save_start_time; ///< Start time of the save in progress.
+static SaveDurations _last_save_durations;                     ///< Durations of the most recently completed save.
+static uint64_t _save_serialise_duration;                      ///< Serialisation duration of the save in progress.
+
+/**
+ * Get the durations of the most recently completed save.
+ * @return The save durations.
+ */
+const SaveDurations &GetLastSaveDurations()
+{
+	return _last_save_durations;
+}
+
 /** Update the gui accordingly when starting saving and set locks on saveload. */
 static void SaveFileStart()
 {
@@ -3869,6 +3883,10 @@ static void SaveFileDone()
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_FINISH);
 	_sl.saveinprogress = false;
 
+	_last_save_durations.serialise = _save_serialise_duration;
+	_last_save_durations.total = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _save_start_time).count();
+	_last_save_durations.count++;
+
 #ifdef __EMSCRIPTEN__
 	EM_ASM(if (window["openttd_syncfs"]) openttd_syncfs());
 #endif
@@ -3963,6 +3981,8 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
 {
 	assert(!_sl.saveinprogress);
 
+	_save_start_time = std::chrono::steady_clock::now();
+
 	_sl.dumper = std::make_unique<MemoryDumper>();
 	_sl.sf = std::move(writer);
 
@@ -3972,6 +3992,8 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
 	SaveViewportBeforeSaveGame();
 	SlSaveChunks();
 
+	_save_serialise_duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _save_start_time).count();
+
 	SaveFileStart();
 
 	if (!threaded || !StartNewThread(&_async_save_thread.save_thread, "ottd:savegame", &SaveFileToDisk, true)) {
@@ -77,6 +77,14 @@ void DoExitSave();
 void DoAutoOrNetsave(FiosNumberedSaveName &counter, bool threaded, FiosNumberedSaveName *lt_counter = nullptr);
 
 SaveOrLoadResult SaveWithFilter(std::shared_ptr<struct SaveFilter> writer, bool threaded, SaveModeFlags flags);
+
+/** Durations of the most recently completed save, in microseconds. */
+struct SaveDurations {
+	uint64_t serialise = 0; ///< Time spent serialising the game state into memory, the game loop is blocked during this.
+	uint64_t total = 0;     ///< Total time until the save was completely written, including compression and writing.
+	uint32_t count = 0;     ///< Number of saves completed since start-up.
+};
+const SaveDurations &GetLastSaveDurations();
 SaveOrLoadResult LoadWithFilter(std::shared_ptr<struct LoadFilter> reader);
 bool IsNetworkServerSave();
 bool IsScenarioSave();
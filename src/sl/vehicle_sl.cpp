@@ -12,6 +12,7 @@
 #include "../vehicle_func.h"
 #include "../train.h"
 #include "../roadveh.h"
+#include "../road_func.h"
 #include "../ship.h"
 #include "../aircraft.h"
 #include "../station_base.h"
@@ -742,6 +743,8 @@ std::map<VehicleID, CargoPacketList> _veh_cpp_packets;
 static std::vector<Trackdir> _path_td;
 static std::vector<TileIndex> _path_tile;
 static uint32_t _path_layout_ctr;
+static std::vector<uint32_t> _path_regions;
+static std::vector<uint16_t> _path_region_counts;
 
 static uint32_t _old_ahead_separation;
 static uint16_t _old_timetable_start_subticks;
@@ -1234,6 +1237,8 @@ NamedSaveLoadTable GetVehicleDescription(VehicleType vt)
 		NSL("path.td",                SLEG_CONDVARVEC(_path_td,                              SLE_UINT8,              SLV_ROADVEH_PATH_CACHE, SL_MAX_VERSION)),
 		NSL("path.tile",              SLEG_CONDVARVEC(_path_tile,                            SLE_UINT32,             SLV_ROADVEH_PATH_CACHE, SL_MAX_VERSION)),
 		NSL("path.layout_ctr",         SLEG_CONDVAR_X(_path_layout_ctr,                      SLE_UINT32,             SL_MIN_VERSION, SL_MAX_VERSION, SlXvFeatureTest(XSLFTO_AND, XSLFI_ROAD_LAYOUT_CHANGE_CTR))),
+		NSL("path.regions",         SLEG_CONDVARVEC_X(_path_regions,                         SLE_UINT32,             SL_MIN_VERSION, SL_MAX_VERSION, SlXvFeatureTest(XSLFTO_AND, XSLFI_ROAD_LAYOUT_CHANGE_CTR, 3))),
+		NSL("path.region_counts",   SLEG_CONDVARVEC_X(_path_region_counts,                   SLE_UINT16,             SL_MIN_VERSION, SL_MAX_VERSION, SlXvFeatureTest(XSLFTO_AND, XSLFI_ROAD_LAYOUT_CHANGE_CTR, 3))),
 
 		NSL("",                          SLE_CONDNULL(2,                                                             SLV_6,  SLV_69)),
 		NSL("gv_flags",                   SLE_CONDVAR(RoadVehicle, gv_flags,                 SLE_UINT16,             SLV_139, SL_MAX_VERSION)),
@@ -1390,16 +1395,28 @@ static void Save_VEHS()
 			_path_td.clear();
 			_path_tile.clear();
 			_path_layout_ctr = 0;
+			_path_regions.clear();
+			_path_region_counts.clear();
 
 			RoadVehicle *rv = RoadVehicle::From(v);
 			if (rv->cached_path != nullptr && !rv->cached_path->empty()) {
+				auto save_regions = [](const std::vector<uint32_t> &regions) {
+					_path_regions.insert(_path_regions.end(), regions.begin(), regions.end());
+					_path_region_counts.push_back(static_cast<uint16_t>(regions.size()));
+				};
 				uint idx = rv->cached_path->start;
 				for (uint i = 0; i < rv->cached_path->size(); i++) {
 					_path_td.push_back(rv->cached_path->td[idx]);
 					_path_tile.push_back(rv->cached_path->tile[idx]);
+					save_regions(rv->cached_path->regions[idx]);
 					idx = (idx + 1) & RV_PATH_CACHE_SEGMENT_MASK;
 				}
+				save_regions(rv->cached_path->tail_regions);
 				_path_layout_ctr = rv->cached_path->layout_ctr;
+				if (!rv->cached_path->regions_known) {
+					_path_regions.clear();
+					_path_region_counts.clear();
+				}
 			}
 		}
 		SlSetArrayIndex(v->index);
@@ -1418,6 +1435,8 @@ void Load_VEHS()
 	_path_td.clear();
 	_path_tile.clear();
 	_path_layout_ctr = 0;
+	_path_regions.clear();
+	_path_region_counts.clear();
 
 	_old_timetable_start_subticks = 0;
 	_old_timetable_start_subticks_map.clear();
@@ -1502,6 +1521,23 @@ void Load_VEHS()
 				rv->cached_path->tile[i] = _path_tile[i];
 			}
 			rv->cached_path->layout_ctr = _path_layout_ctr;
+
+			/* Older savegames, and paths loaded from them, do not have the regions crossed by each leg */
+			rv->cached_path->regions_known = (_path_region_counts.size() == _path_td.size() + 1);
+			if (rv->cached_path->regions_known) {
+				auto iter = _path_regions.begin();
+				auto load_regions = [&](std::vector<uint32_t> &regions, uint16_t count) -> bool {
+					if (count > _path_regions.end() - iter) return false;
+					if (std::any_of(iter, iter + count, [](uint32_t region) { return region >= _road_layout_region_versions.size(); })) return false;
+					regions.assign(iter, iter + count);
+					iter += count;
+					return true;
+				};
+				for (size_t i = 0; i < _path_td.size(); i++) {
+					if (!load_regions(rv->cached_path->regions[i], _path_region_counts[i])) rv->cached_path->regions_known = false;
+				}
+				if (!load_regions(rv->cached_path->tail_regions, _path_region_counts.back())) rv->cached_path->regions_known = false;
+			}
 		}
 	}
 }
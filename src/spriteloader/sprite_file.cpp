@@ -45,6 +45,54 @@ static uint8_t GetGRFContainerVersion(SpriteFile &file)
 SpriteFile::SpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap)
 	: RandomAccessFile(filename, subdir), palette_remap(palette_remap)
 {
+	/* Sprite files are read intensively while loading NewGRFs, see #FinishLoading. */
+	this->TryMemoryMap();
 	this->container_version = GetGRFContainerVersion(*this);
 	this->content_begin = this->GetPos();
 }
+
+/**
+ * Find the sprite starting at the given position in the index built by earlier loading stages.
+ * Sprites are mostly looked up in order, so the entry following the previous lookup is tried first.
+ * @param pos Position of the length field of the sprite.
+ * @return The index entry, or nullptr when the sprite has not been indexed.
+ */
+const SpriteFileIndexEntry *SpriteFile::FindIndexedSprite(size_t pos)
+{
+	if (this->sprite_index_cursor < this->sprite_index.size() && this->sprite_index[this->sprite_index_cursor].pos == pos) {
+		return &this->sprite_index[this->sprite_index_cursor++];
+	}
+
+	auto it = std::ranges::lower_bound(this->sprite_index, pos, std::less{}, &SpriteFileIndexEntry::pos);
+	if (it == this->sprite_index.end() || it->pos != pos) return nullptr;
+
+	this->sprite_index_cursor = std::distance(this->sprite_index.begin(), it) + 1;
+	return &*it;
+}
+
+/**
+ * Add a sprite to the index, so later loading stages do not need to parse it again.
+ * Only sprites past the last indexed sprite are added, as the index must stay sorted;
+ * sprites reached by jumping backwards have already been indexed when they were passed the first time.
+ * @param entry The location of the sprite.
+ */
+void SpriteFile::AddIndexedSprite(const SpriteFileIndexEntry &entry)
+{
+	if (!this->sprite_index.empty() && entry.pos <= this->sprite_index.back().pos) return;
+
+	this->sprite_index.push_back(entry);
+	this->sprite_index_cursor = this->sprite_index.size();
+}
+
+/**
+ * Release the resources which are only needed while loading NewGRFs.
+ * This returns to buffered reads, so that the file can be safely replaced on disk while the game runs,
+ * and drops the sprite index, which would otherwise be kept for the whole session.
+ */
+void SpriteFile::FinishLoading()
+{
+	this->ReleaseMemoryMap();
+	this->sprite_index.clear();
+	this->sprite_index.shrink_to_fit();
+	this->sprite_index_cursor = 0;
+}
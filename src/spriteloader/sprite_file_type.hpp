@@ -11,6 +11,7 @@
 #define SPRITE_FILE_TYPE_HPP
 
 #include "../random_access_file_type.h"
+#include <vector>
 
 enum SpriteFileFlags : uint8_t {
 	SFF_NONE                  = 0,
@@ -20,6 +21,14 @@ enum SpriteFileFlags : uint8_t {
 };
 DECLARE_ENUM_AS_BIT_SET(SpriteFileFlags)
 
+/** Location of a single (pseudo) sprite within a NewGRF, as found while loading an earlier stage. */
+struct SpriteFileIndexEntry {
+	size_t pos;      ///< Position of the length field of the sprite.
+	size_t next_pos; ///< Position of the length field of the next sprite.
+	uint32_t num;    ///< Length of the sprite as stored in the file.
+	uint8_t type;    ///< Type of the sprite; 0xFF for pseudo sprites.
+};
+
 /**
  * RandomAccessFile with some extra information specific for sprite files.
  * It automatically detects and stores the container version upload opening the file.
@@ -29,6 +38,9 @@ class SpriteFile : public RandomAccessFile {
 	bool palette_remap;     ///< Whether or not a remap of the palette is required for this file.
 	uint8_t container_version; ///< Container format of the sprite file.
 
+	std::vector<SpriteFileIndexEntry> sprite_index; ///< Sprites seen by earlier NewGRF loading stages, sorted by position.
+	size_t sprite_index_cursor = 0; ///< Index of the entry expected to be looked up next.
+
 public:
 	SpriteFileFlags flags = SFF_NONE;
 
@@ -51,7 +63,15 @@ public:
 	/**
 	 * Seek to the begin of the content, i.e. the position just after the container version has been determined.
 	 */
-	void SeekToBegin() { this->SeekTo(this->content_begin, SEEK_SET); }
+	void SeekToBegin()
+	{
+		this->SeekTo(this->content_begin, SEEK_SET);
+		this->sprite_index_cursor = 0;
+	}
+
+	const SpriteFileIndexEntry *FindIndexedSprite(size_t pos);
+	void AddIndexedSprite(const SpriteFileIndexEntry &entry);
+	void FinishLoading();
 };
 
 #endif /* SPRITE_FILE_TYPE_HPP */
@@ -0,0 +1,167 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_hash.cpp Hash tree over the game state, to localise desyncs. */
+
+#include "stdafx.h"
+#include "cargopacket.h"
+#include "core/format.hpp"
+#include "debug_desync.h"
+#include "map_func.h"
+#include "order_base.h"
+#include "station_base.h"
+#include "vehicle_base.h"
+
+#include "safeguards.h"
+
+/** Number of map rows which are hashed together. */
+static const uint STATE_HASH_MAP_ROWS_PER_CHUNK = 16;
+/** Number of pool items which are hashed together. */
+static const uint STATE_HASH_POOL_ITEMS_PER_CHUNK = 1024;
+
+/** Simple non-cryptographic hash of a sequence of 64-bit values. */
+struct StateHasher {
+	uint64_t state = 0xCBF29CE484222325ULL;
+
+	void Update(uint64_t input)
+	{
+		this->state = (std::rotl(this->state, 5) ^ input) * 0x100000001B3ULL;
+	}
+};
+
+/**
+ * Finish a section of the tree, by hashing the hashes of its chunks.
+ * @param section The section.
+ */
+static void FinishStateHashSection(StateHashSection &section)
+{
+	StateHasher hasher;
+	for (uint64_t chunk : section.chunks) {
+		hasher.Update(chunk);
+	}
+	section.hash = hasher.state;
+}
+
+/**
+ * Build the section of the tree for the map, each chunk covers a fixed number of rows of tiles.
+ * @return The section.
+ */
+static StateHashSection BuildMapStateHashSection()
+{
+	StateHashSection section{ "map rows", STATE_HASH_MAP_ROWS_PER_CHUNK, {}, 0 };
+
+	const uint size_x = Map::SizeX();
+	for (uint y = 0; y < Map::SizeY(); y += STATE_HASH_MAP_ROWS_PER_CHUNK) {
+		StateHasher hasher;
+		const uint end = std::min<uint>(y + STATE_HASH_MAP_ROWS_PER_CHUNK, Map::SizeY()) * size_x;
+		for (uint index = y * size_x; index < end; index++) {
+			uint64_t tile;
+			static_assert(sizeof(tile) == sizeof(Tile));
+			memcpy(&tile, &_m[TileIndex{index}], sizeof(Tile));
+			uint64_t tile_extended = 0;
+			memcpy(&tile_extended, &_me[TileIndex{index}], sizeof(TileExtended));
+			hasher.Update(tile);
+			hasher.Update(tile_extended);
+		}
+		section.chunks.push_back(hasher.state);
+	}
+
+	FinishStateHashSection(section);
+	return section;
+}
+
+/**
+ * Build the section of the tree for the items of a pool.
+ * Each chunk covers a fixed range of pool indices, so an added or removed item only changes the hash of its own chunk.
+ * @param name The name of the section.
+ * @param hash_item Function which hashes the state of a single item.
+ * @return The section.
+ */
+template <typename T, typename F>
+static StateHashSection BuildPoolStateHashSection(std::string_view name, F hash_item)
+{
+	StateHashSection section{ name, STATE_HASH_POOL_ITEMS_PER_CHUNK, {}, 0 };
+	section.chunks.resize(CeilDiv(T::GetPoolSize(), STATE_HASH_POOL_ITEMS_PER_CHUNK), StateHasher{}.state);
+
+	for (const T *item : T::Iterate()) {
+		uint64_t &chunk = section.chunks[item->index / STATE_HASH_POOL_ITEMS_PER_CHUNK];
+		StateHasher hasher{ chunk };
+		hasher.Update(item->index);
+		hash_item(hasher, item);
+		chunk = hasher.state;
+	}
+
+	FinishStateHashSection(section);
+	return section;
+}
+
+/**
+ * Build a hash tree over the game state: the map and the vehicle, station, order and cargo packet pools.
+ * Only state which is saved is included, so the tree of a client and of the server are the same when they are in sync.
+ * When they are not, comparing the trees tells which part of the state diverged.
+ * @return The tree.
+ */
+StateHashTree BuildStateHashTree()
+{
+	StateHashTree tree;
+
+	tree.sections.push_back(BuildMapStateHashSection());
+
+	tree.sections.push_back(BuildPoolStateHashSection<Vehicle>("vehicles", [](StateHasher &hasher, const Vehicle *v) {
+		hasher.Update(v->type | (v->subtype << 8) | (v->owner << 16) | (static_cast<uint64_t>(v->vehstatus) << 24) | (static_cast<uint64_t>(v->direction) << 32));
+		hasher.Update(v->tile.base());
+		hasher.Update(static_cast<uint32_t>(v->x_pos) | (static_cast<uint64_t>(static_cast<uint32_t>(v->y_pos)) << 32));
+		hasher.Update(static_cast<uint32_t>(v->z_pos) | (static_cast<uint64_t>(v->progress) << 32) | (static_cast<uint64_t>(v->cur_speed) << 40) | (static_cast<uint64_t>(v->subspeed) << 56));
+		hasher.Update(v->cargo_type | (v->cargo_cap << 8) | (static_cast<uint64_t>(v->cargo.StoredCount()) << 32));
+		hasher.Update(v->reliability | (v->breakdown_ctr << 16) | (static_cast<uint64_t>(v->breakdown_delay) << 24) | (static_cast<uint64_t>(v->random_bits) << 32));
+		hasher.Update(static_cast<int64_t>(v->profit_this_year));
+		hasher.Update(static_cast<int64_t>(v->value));
+	}));
+
+	tree.sections.push_back(BuildPoolStateHashSection<Station>("stations", [](StateHasher &hasher, const Station *st) {
+		hasher.Update(st->xy.base() | (static_cast<uint64_t>(st->owner) << 32) | (static_cast<uint64_t>(st->facilities) << 40));
+		for (const GoodsEntry &ge : st->goods) {
+			hasher.Update(ge.rating | (ge.time_since_pickup << 8) | (ge.status << 16) | (static_cast<uint64_t>(ge.CargoTotalCount()) << 32));
+		}
+	}));
+
+	tree.sections.push_back(BuildPoolStateHashSection<OrderPoolItem>("orders", [](StateHasher &hasher, const OrderPoolItem *item) {
+		const Order &o = item->order;
+		hasher.Update(o.GetType() | (o.GetRawFlags() << 8) | (static_cast<uint64_t>(o.GetDestination().base()) << 32));
+	}));
+
+	tree.sections.push_back(BuildPoolStateHashSection<CargoPacket>("cargo packets", [](StateHasher &hasher, const CargoPacket *cp) {
+		hasher.Update(cp->Count() | (static_cast<uint64_t>(cp->GetPeriodsInTransit()) << 16) | (static_cast<uint64_t>(cp->GetFirstStation()) << 32) | (static_cast<uint64_t>(cp->GetNextHop()) << 48));
+		hasher.Update(static_cast<int64_t>(cp->GetFeederShare()));
+	}));
+
+	StateHasher hasher;
+	for (const StateHashSection &section : tree.sections) {
+		hasher.Update(section.hash);
+	}
+	tree.root = hasher.state;
+
+	return tree;
+}
+
+/**
+ * Write a hash tree over the game state in a form which can be compared with that of another client or the server.
+ * @param buffer The buffer to write to.
+ * @param tree The tree.
+ * @param include_chunks Whether to write the hash of each chunk of each section, or only the hashes of the sections.
+ */
+void DumpStateHashTree(format_target &buffer, const StateHashTree &tree, bool include_chunks)
+{
+	buffer.format("State hash: {:016X}\n", tree.root);
+	for (const StateHashSection &section : tree.sections) {
+		buffer.format("  {}: {:016X}, {} chunks of {}\n", section.name, section.hash, section.chunks.size(), section.items_per_chunk);
+		if (!include_chunks) continue;
+		for (size_t i = 0; i < section.chunks.size(); i++) {
+			buffer.format("    {:>5}: {:016X}\n", i, section.chunks[i]);
+		}
+	}
+}
@@ -29,6 +29,7 @@
 #include "linkgraph/linkgraphschedule.h"
 #include "tracerestrict.h"
 #include "newgrf_debug.h"
+#include "strings_func.h"
 #include "3rdparty/cpp-btree/btree_set.h"
 #include "3rdparty/robin_hood/robin_hood.h"
 
@@ -67,6 +68,7 @@ BaseStation::~BaseStation()
 	CloseWindowById(WC_SHIPS_LIST,    VehicleListIdentifier(VL_STATION_LIST, VEH_SHIP,     this->owner, this->index).ToWindowNumber());
 	CloseWindowById(WC_AIRCRAFT_LIST, VehicleListIdentifier(VL_STATION_LIST, VEH_AIRCRAFT, this->owner, this->index).ToWindowNumber());
 	CloseWindowById(WC_STATION_CARGO, this->index);
+	InvalidateFormattedStringCache();
 
 	extern void CloseStationDeparturesWindow(StationID station);
 	CloseStationDeparturesWindow(this->index);
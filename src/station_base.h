@@ -511,6 +511,8 @@ public:
 
 	void SortStorage();
 
+	void MergeFlows(FlowStatMap &&other);
+
 	std::span<const FlowStat> IterateUnordered() const
 	{
 		return std::span<const FlowStat>(this->flows_storage.data(), this->flows_storage.size());
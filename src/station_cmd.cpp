@@ -24,6 +24,7 @@
 #include "newgrf_station.h"
 #include "newgrf_canal.h" /* For the buoy */
 #include "pathfinder/yapf/yapf_cache.h"
+#include "pathfinder/road_regions.h"
 #include "road_internal.h" /* For drawing catenary/checking road removal */
 #include "autoslope.h"
 #include "water.h"
@@ -63,6 +64,7 @@
 #include "core/math_func.hpp"
 #include "landscape_cmd.h"
 #include "rail_cmd.h"
+#include "zone_profiler.h"
 
 #include "widgets/station_widget.h"
 
@@ -2268,7 +2270,8 @@ CommandCost CmdBuildRoadStop(DoCommandFlag flags, TileIndex tile, uint8_t width,
 			UpdateRoadCachedOneWayStatesAroundTile(cur_tile);
 		}
 		ZoningMarkDirtyStationCoverageArea(st);
-		NotifyRoadLayoutChanged(true);
+		InvalidateRoadRegions(roadstop_area.tile, TileAddXY(roadstop_area.tile, roadstop_area.w - 1, roadstop_area.h - 1));
+		NotifyRoadLayoutChanged(roadstop_area.tile, TileAddXY(roadstop_area.tile, roadstop_area.w - 1, roadstop_area.h - 1), true);
 
 		if (st != nullptr) {
 			st->AfterStationTileSetChange(true, station_type);
@@ -2346,7 +2349,8 @@ CommandCost RemoveRoadWaypointStop(TileIndex tile, DoCommandFlag flags, int repl
 			}
 		}
 
-		NotifyRoadLayoutChanged(false);
+		InvalidateRoadRegion(tile);
+		NotifyRoadLayoutChanged(tile, false);
 	}
 
 	return CommandCost(EXPENSES_CONSTRUCTION, spec != nullptr ? spec->GetClearCost(PR_CLEAR_STATION_TRUCK) : _price[PR_CLEAR_STATION_TRUCK]);
@@ -2461,7 +2465,8 @@ CommandCost RemoveRoadStop(TileIndex tile, DoCommandFlag flags, int replacement_
 			for (const RoadStop *rs = st->bus_stops; rs != nullptr; rs = rs->next) st->bus_station.Add(rs->xy);
 		}
 
-		NotifyRoadLayoutChanged(false);
+		InvalidateRoadRegion(tile);
+		NotifyRoadLayoutChanged(tile, false);
 	}
 
 	Price category = is_truck ? PR_CLEAR_STATION_TRUCK : PR_CLEAR_STATION_BUS;
@@ -4169,18 +4174,28 @@ bool GetNewGrfRating(const Station *st, const CargoSpec *cs, const GoodsEntry *g
 	return is_using_newgrf_rating;
 }
 
-int GetSpeedRating(const GoodsEntry *ge)
+static inline int GetSpeedRatingFromLastSpeed(uint8_t last_speed)
 {
-	const int b = ge->last_speed - 85;
+	const int b = last_speed - 85;
 
 	return (b >= 0) ? (b >> 2) : 0;
 }
 
-int GetWaitTimeRating(const CargoSpec *cs, const GoodsEntry *ge)
+int GetSpeedRating(const GoodsEntry *ge)
 {
-	int rating = 0;
+	return GetSpeedRatingFromLastSpeed(ge->last_speed);
+}
 
-	uint wait_time = ge->time_since_pickup;
+/**
+ * Get the waiting time used by the wait time rating, adjusted for the cargo class and last vehicle type.
+ * @param cs Cargo spec.
+ * @param time_since_pickup Time since cargo was last picked up.
+ * @param last_vehicle_type Type of the last vehicle which tried to load the cargo.
+ * @return Adjusted waiting time.
+ */
+static uint GetRatingWaitTime(const CargoSpec *cs, uint time_since_pickup, uint8_t last_vehicle_type)
+{
+	uint wait_time = time_since_pickup;
 
 	if (_settings_game.station.cargo_class_rating_wait_time) {
 		if (cs->classes & CC_PASSENGERS) {
@@ -4194,33 +4209,48 @@ int GetWaitTimeRating(const CargoSpec *cs, const GoodsEntry *ge)
 		}
 	}
 
-	if (ge->last_vehicle_type == VEH_SHIP) wait_time >>= 2;
-	if (wait_time <= 21) rating += 25;
-	if (wait_time <= 12) rating += 25;
-	if (wait_time <= 6) rating += 45;
-	if (wait_time <= 3) rating += 35;
+	if (last_vehicle_type == VEH_SHIP) wait_time >>= 2;
 
-	return rating;
+	return wait_time;
 }
 
-int GetWaitingCargoRating(const Station *st, const GoodsEntry *ge)
+static inline int GetWaitTimeRatingFromWaitTime(uint wait_time)
+{
+	return (wait_time <= 21 ? 25 : 0) + (wait_time <= 12 ? 25 : 0) + (wait_time <= 6 ? 45 : 0) + (wait_time <= 3 ? 35 : 0);
+}
+
+int GetWaitTimeRating(const CargoSpec *cs, const GoodsEntry *ge)
 {
-	int rating = -90;
+	return GetWaitTimeRatingFromWaitTime(GetRatingWaitTime(cs, ge->time_since_pickup, ge->last_vehicle_type));
+}
 
-	uint normalised_max_waiting_cargo = ge->max_waiting_cargo;
+/**
+ * Get the maximum amount of waiting cargo used by the waiting cargo rating, adjusted for the station size.
+ * @param st Station.
+ * @param max_waiting_cargo Maximum amount of waiting cargo.
+ * @return Adjusted amount of waiting cargo.
+ */
+static uint GetRatingWaitingCargo(const Station *st, uint max_waiting_cargo)
+{
+	uint normalised_max_waiting_cargo = max_waiting_cargo;
 
 	if (_settings_game.station.station_size_rating_cargo_amount) {
 		normalised_max_waiting_cargo *= 8;
 		if (st->station_tiles > 1) normalised_max_waiting_cargo /= st->station_tiles;
 	}
 
-	if (normalised_max_waiting_cargo <= 1500) rating += 55;
-	if (normalised_max_waiting_cargo <= 1000) rating += 35;
-	if (normalised_max_waiting_cargo <= 600) rating += 10;
-	if (normalised_max_waiting_cargo <= 300) rating += 20;
-	if (normalised_max_waiting_cargo <= 100) rating += 10;
+	return normalised_max_waiting_cargo;
+}
+
+static inline int GetWaitingCargoRatingFromWaitingCargo(uint normalised_max_waiting_cargo)
+{
+	return -90 + (normalised_max_waiting_cargo <= 1500 ? 55 : 0) + (normalised_max_waiting_cargo <= 1000 ? 35 : 0) +
+			(normalised_max_waiting_cargo <= 600 ? 10 : 0) + (normalised_max_waiting_cargo <= 300 ? 20 : 0) + (normalised_max_waiting_cargo <= 100 ? 10 : 0);
+}
 
-	return rating;
+int GetWaitingCargoRating(const Station *st, const GoodsEntry *ge)
+{
+	return GetWaitingCargoRatingFromWaitingCargo(GetRatingWaitingCargo(st, ge->max_waiting_cargo));
 }
 
 int GetStatueRating(const Station *st)
@@ -4228,17 +4258,14 @@ int GetStatueRating(const Station *st)
 	return Company::IsValidID(st->owner) && st->town->statues.Test(st->owner) ? 26 : 0;
 }
 
-int GetVehicleAgeRating(const GoodsEntry *ge)
+static inline int GetVehicleAgeRatingFromAge(uint8_t age)
 {
-	int rating = 0;
-
-	const uint8_t age = ge->last_age;
-
-	if (age < 30) rating += 10;
-	if (age < 20) rating += 10;
-	if (age < 10) rating += 13;
+	return (age < 30 ? 10 : 0) + (age < 20 ? 10 : 0) + (age < 10 ? 13 : 0);
+}
 
-	return rating;
+int GetVehicleAgeRating(const GoodsEntry *ge)
+{
+	return GetVehicleAgeRatingFromAge(ge->last_age);
 }
 
 int GetTargetRating(const Station *st, const CargoSpec *cs, const GoodsEntry *ge)
@@ -4270,7 +4297,119 @@ int GetTargetRating(const Station *st, const CargoSpec *cs, const GoodsEntry *ge
 	return ClampTo<uint8_t>(rating);
 }
 
-static void UpdateStationRating(Station *st)
+/**
+ * Target ratings of the stations whose ratings are due to be updated this tick, for the cargoes which use the
+ * standard rating calculation. The inputs of all due stations are gathered into packed arrays first, so that
+ * the rating components can be computed in a single branch-free loop which the compiler can vectorise.
+ * The rating components are computed by the same functions as GetTargetRating, so the results are identical.
+ */
+struct StationRatingBatch {
+	/** Precomputed target ratings of a single station. */
+	struct StationEntry {
+		StationID station; ///< Station.
+		CargoTypes cargoes; ///< Cargoes with a precomputed target rating.
+		uint first;         ///< Index of the target rating of the lowest cargo in cargoes.
+	};
+
+	std::vector<StationEntry> stations; ///< Due stations, in station index order.
+	uint next_station = 0;              ///< Index of the next entry in stations to be looked up.
+
+	std::vector<uint8_t> last_speed;
+	std::vector<uint8_t> last_age;
+	std::vector<uint> wait_time;
+	std::vector<uint> waiting_cargo;
+	std::vector<uint> max_waiting_cargo; ///< Unadjusted max waiting cargo, used to detect changes since the inputs were gathered.
+	std::vector<int> statue;
+	std::vector<uint8_t> target_rating;
+
+	void Clear()
+	{
+		this->stations.clear();
+		this->next_station = 0;
+		this->last_speed.clear();
+		this->last_age.clear();
+		this->wait_time.clear();
+		this->waiting_cargo.clear();
+		this->max_waiting_cargo.clear();
+		this->statue.clear();
+		this->target_rating.clear();
+	}
+
+	/**
+	 * Gather the rating inputs of a station, as they will be when UpdateStationRating evaluates them.
+	 * @param st Station which is due for a rating update.
+	 */
+	void Add(const Station *st)
+	{
+		StationEntry entry{ st->index, 0, (uint)this->last_speed.size() };
+		const int statue = GetStatueRating(st);
+		for (const CargoSpec *cs : CargoSpec::Iterate()) {
+			if (cs->callback_mask.Test(CargoCallbackMask::StationRatingCalc)) continue;
+
+			const GoodsEntry &ge = st->goods[cs->Index()];
+			if (!ge.HasRating()) continue;
+
+			/* UpdateStationRating increments time_since_pickup before calculating the rating */
+			uint8_t time_since_pickup = ge.time_since_pickup;
+			byte_inc_sat(&time_since_pickup);
+
+			SetBit(entry.cargoes, cs->Index());
+			this->last_speed.push_back(ge.last_speed);
+			this->last_age.push_back(ge.last_age);
+			this->wait_time.push_back(GetRatingWaitTime(cs, time_since_pickup, ge.last_vehicle_type));
+			this->waiting_cargo.push_back(GetRatingWaitingCargo(st, ge.max_waiting_cargo));
+			this->max_waiting_cargo.push_back(ge.max_waiting_cargo);
+			this->statue.push_back(statue);
+		}
+		if (entry.cargoes != 0) this->stations.push_back(entry);
+	}
+
+	/** Compute the target ratings of all gathered goods entries. */
+	void Compute()
+	{
+		const size_t count = this->last_speed.size();
+		this->target_rating.resize(count);
+		for (size_t i = 0; i < count; i++) {
+			const int rating = GetSpeedRatingFromLastSpeed(this->last_speed[i]) + GetWaitTimeRatingFromWaitTime(this->wait_time[i]) +
+					GetWaitingCargoRatingFromWaitingCargo(this->waiting_cargo[i]) + this->statue[i] + GetVehicleAgeRatingFromAge(this->last_age[i]);
+			this->target_rating[i] = ClampTo<uint8_t>(rating);
+		}
+	}
+
+	/**
+	 * Find the precomputed target ratings of a station, stations must be looked up in station index order.
+	 * @param station Station.
+	 * @return Entry of the station, or nullptr if there are no precomputed ratings.
+	 */
+	const StationEntry *Find(StationID station)
+	{
+		while (this->next_station < this->stations.size() && this->stations[this->next_station].station < station) this->next_station++;
+		if (this->next_station < this->stations.size() && this->stations[this->next_station].station == station) return &this->stations[this->next_station++];
+		return nullptr;
+	}
+
+	/**
+	 * Get the precomputed target rating of a goods entry.
+	 * @param entry Station entry.
+	 * @param cargo Cargo.
+	 * @param ge Goods entry.
+	 * @return Target rating, or -1 if this is not available.
+	 */
+	int GetTargetRating(const StationEntry *entry, CargoType cargo, const GoodsEntry *ge) const
+	{
+		if (entry == nullptr || !HasBit(entry->cargoes, cargo)) return -1;
+		const uint index = entry->first + CountBits(GB(entry->cargoes, 0, cargo));
+
+		/* Truncating cargo at one station can increase the max waiting cargo of the source stations */
+		if (this->max_waiting_cargo[index] != ge->max_waiting_cargo) return -1;
+
+		return this->target_rating[index];
+	}
+};
+
+static StationRatingBatch _station_rating_batch;
+
+static void UpdateStationRating(Station *st, const StationRatingBatch::StationEntry *batch_entry = nullptr)
 {
 	bool waiting_changed = false;
 
@@ -4300,7 +4439,8 @@ static void UpdateStationRating(Station *st)
 			}
 
 			{
-				int rating = GetTargetRating(st, cs, ge);
+				int rating = _station_rating_batch.GetTargetRating(batch_entry, cs->Index(), ge);
+				if (rating < 0) rating = GetTargetRating(st, cs, ge);
 
 				uint waiting = ge->CargoAvailableCount();
 
@@ -4616,7 +4756,20 @@ static void StationHandleSmallTick(BaseStation *st)
 	if (b >= STATION_RATING_TICKS) b = 0;
 	st->delete_ctr = b;
 
-	if (b == 0) UpdateStationRating(Station::From(st));
+	if (b == 0) UpdateStationRating(Station::From(st), _station_rating_batch.Find(st->index));
+}
+
+/** Gather and compute the target ratings of the stations whose ratings are due to be updated this tick. */
+static void PrepareStationRatingBatch()
+{
+	_station_rating_batch.Clear();
+	if (_cheats.station_rating.value) return;
+
+	for (const Station *st : Station::Iterate()) {
+		if (!st->IsInUse() || st->delete_ctr + 1 < STATION_RATING_TICKS) continue;
+		_station_rating_batch.Add(st);
+	}
+	_station_rating_batch.Compute();
 }
 
 void UpdateAllStationRatings()
@@ -4632,8 +4785,10 @@ void OnTick_Station()
 	if (_game_mode == GM_EDITOR) return;
 
 	ClearDeleteStaleLinksVehicleCache();
+	PrepareStationRatingBatch();
 
 	for (BaseStation *st : BaseStation::Iterate()) {
+		ZoneProfilerScope zone(ZPZ_STATION_TICK, st->index);
 		StationHandleSmallTick(st);
 
 		/* Clean up the link graph about once a week. */
@@ -4641,6 +4796,13 @@ void OnTick_Station()
 			DeleteStaleLinks(Station::From(st));
 		};
 
+		/* Merge compatible cargo packets about once a week, half a cycle apart from the link graph clean up. */
+		if (Station::IsExpected(st) && (_tick_counter + st->index + (STATION_LINKGRAPH_TICKS / 2)) % STATION_LINKGRAPH_TICKS == 0) {
+			for (GoodsEntry &ge : Station::From(st)->goods) {
+				if (ge.data != nullptr) ge.data->cargo.Compact();
+			}
+		}
+
 		/* Run STATION_ACCEPTANCE_TICKS = 250 tick interval trigger for station animation.
 		 * Station index is included so that triggers are not all done
 		 * at the same time. */
@@ -4795,6 +4957,7 @@ CommandCost CmdRenameStation(DoCommandFlag flags, StationID station_id, bool gen
 		}
 
 		st->UpdateVirtCoord();
+		InvalidateFormattedStringCache();
 		InvalidateWindowData(WC_STATION_LIST, st->owner, 1);
 	}
 
@@ -4837,6 +5000,7 @@ CommandCost CmdExchangeStationNames(DoCommandFlag flags, StationID station_id1,
 		std::swap(st->extra_name_index, st2->extra_name_index);
 		st->UpdateVirtCoord();
 		st2->UpdateVirtCoord();
+		InvalidateFormattedStringCache();
 		InvalidateWindowData(WC_STATION_LIST, st->owner, 1);
 	}
 
@@ -5695,6 +5859,41 @@ void FlowStatMap::SortStorage()
 	}
 }
 
+/**
+ * Merge the flows of another map into this one, in a single pass.
+ * Flows from origins which are already present in this map are kept, those of the other map are discarded.
+ * The storage of the result is sorted by origin, and both the storage and the index are built in order,
+ * instead of inserting each new flow individually and sorting afterwards.
+ * @param other Flows to merge in, this is left empty.
+ */
+void FlowStatMap::MergeFlows(FlowStatMap &&other)
+{
+	std::vector<FlowStat> storage;
+	storage.reserve(this->flows_storage.size() + other.flows_storage.size());
+	btree::btree_map<StationID, uint16_t> index;
+
+	auto own_it = this->flows_index.begin();
+	auto other_it = other.flows_index.begin();
+	while (own_it != this->flows_index.end() || other_it != other.flows_index.end()) {
+		FlowStat *source;
+		if (other_it == other.flows_index.end() || (own_it != this->flows_index.end() && own_it->first <= other_it->first)) {
+			if (other_it != other.flows_index.end() && own_it->first == other_it->first) ++other_it;
+			source = &this->flows_storage[own_it->second];
+			++own_it;
+		} else {
+			source = &other.flows_storage[other_it->second];
+			++other_it;
+		}
+		index.insert(index.end(), std::pair<StationID, uint16_t>(source->GetOrigin(), (uint16_t)storage.size()));
+		storage.push_back(std::move(*source));
+	}
+
+	this->flows_storage = std::move(storage);
+	this->flows_index = std::move(index);
+	other.flows_storage.clear();
+	other.flows_index.clear();
+}
+
 void DumpStationFlowStats(format_target &buffer)
 {
 	btree::btree_map<uint, uint> count_map;
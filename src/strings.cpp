@@ -391,6 +391,100 @@ std::string GetStringWithArgs(StringID string, std::span<StringParameter> args)
 	return result.to_string();
 }
 
+/** Maximum number of parameters of a string in the formatted string cache. */
+static constexpr size_t FORMATTED_STRING_CACHE_MAX_PARAMS = 4;
+/** Number of entries of the formatted string cache, must be a power of 2. */
+static constexpr size_t FORMATTED_STRING_CACHE_SIZE = 1024;
+
+/**
+ * Cache of the results of formatting strings with only numeric parameters.
+ * Each key maps to a single entry, which is replaced by the result of the next key mapping to it, so the size of the cache is bounded.
+ * Invalidating the cache increases the generation, so entries of an older generation are not used any more.
+ */
+struct FormattedStringCache {
+	/** Formatted string together with its key. */
+	struct Entry {
+		uint32_t generation = 0;                                          ///< Generation of the cache when the string was formatted, 0 for an unused entry.
+		StringID string = INVALID_STRING_ID;                              ///< ID of the formatted string.
+		uint8_t param_count = 0;                                          ///< Number of parameters of the formatted string.
+		std::array<uint64_t, FORMATTED_STRING_CACHE_MAX_PARAMS> params{}; ///< Values of the parameters of the formatted string.
+		std::string result;                                               ///< The formatted string.
+	};
+
+	std::array<Entry, FORMATTED_STRING_CACHE_SIZE> entries; ///< All entries.
+	uint32_t generation = 1;                                ///< Current generation of the cache.
+	std::string uncached;                                   ///< Result of formatting a string which cannot be cached.
+};
+
+static FormattedStringCache _formatted_string_cache;
+
+/**
+ * Invalidate all strings in the formatted string cache.
+ * This must be called whenever the result of formatting a string may change for the same parameters,
+ * e.g. when something is renamed, when a pool item is deleted and its ID may be reused, or when the language or a setting changes.
+ */
+void InvalidateFormattedStringCache()
+{
+	_formatted_string_cache.generation++;
+	if (_formatted_string_cache.generation == 0) {
+		/* Wrapped around, entries of the first generations could otherwise be mistaken for current ones. */
+		for (FormattedStringCache::Entry &entry : _formatted_string_cache.entries) {
+			entry.generation = 0;
+		}
+		_formatted_string_cache.generation = 1;
+	}
+}
+
+/**
+ * Get a parsed string with most special stringcodes replaced by the string parameters, using the formatted string cache.
+ * This is intended for strings which are drawn every time a window or viewport repaints, with the same parameters each time.
+ * Strings with more than #FORMATTED_STRING_CACHE_MAX_PARAMS parameters or with string parameters are not cached.
+ * @param string The ID of the string to parse.
+ * @param args Span of arguments for the string.
+ * @return The parsed string, which is only valid until the next call of this function or invalidation of the cache.
+ */
+std::string_view GetCachedStringWithArgs(StringID string, std::span<StringParameter> args)
+{
+	FormattedStringCache &cache = _formatted_string_cache;
+
+	bool cacheable = args.size() <= FORMATTED_STRING_CACHE_MAX_PARAMS;
+	uint64_t hash = string * 0x9E3779B97F4A7C15ULL;
+	for (const StringParameter &param : args) {
+		const uint64_t *value = std::get_if<uint64_t>(&param.data);
+		if (value == nullptr) {
+			cacheable = false;
+			break;
+		}
+		hash = (std::rotl(hash, 5) ^ *value) * 0x100000001B3ULL;
+	}
+
+	if (!cacheable) {
+		cache.uncached = GetStringWithArgs(string, args);
+		return cache.uncached;
+	}
+
+	FormattedStringCache::Entry &entry = cache.entries[(hash ^ (hash >> 32)) & (FORMATTED_STRING_CACHE_SIZE - 1)];
+	auto matches = [&]() -> bool {
+		if (entry.generation != cache.generation || entry.string != string || entry.param_count != args.size()) return false;
+		for (size_t i = 0; i < args.size(); i++) {
+			if (entry.params[i] != std::get<uint64_t>(args[i].data)) return false;
+		}
+		return true;
+	};
+	if (matches()) return entry.result;
+
+	entry.generation = cache.generation;
+	entry.string = string;
+	entry.param_count = static_cast<uint8_t>(args.size());
+	for (size_t i = 0; i < args.size(); i++) {
+		entry.params[i] = std::get<uint64_t>(args[i].data);
+	}
+	format_buffer result;
+	GetStringWithArgs(StringBuilder(result), string, args);
+	entry.result.assign((std::string_view)result);
+	return entry.result;
+}
+
 /**
  * This function is used to "bind" a C string to a OpenTTD dparam slot.
  * @param n slot of the string
@@ -2409,6 +2503,7 @@ bool ReadLanguagePack(const LanguageMetadata *lang)
 	_config_language_file = c_file;
 	SetCurrentGrfLangID(_current_language->newgrflangid);
 	_langpack.list_separator = GetString(STR_LIST_SEPARATOR);
+	InvalidateFormattedStringCache();
 
 #ifdef _WIN32
 	extern void Win32SetCurrentLocaleName(std::string iso_code);
@@ -67,6 +67,8 @@ const char *GetStringPtr(StringID string);
 void AppendStringInPlace(std::string &result, StringID string);
 void AppendStringInPlace(struct format_buffer &result, StringID string);
 void AppendStringInPlaceWithArgs(struct format_buffer &result, StringID string, std::span<StringParameter> args);
+std::string_view GetCachedStringWithArgs(StringID string, std::span<StringParameter> args);
+void InvalidateFormattedStringCache();
 uint32_t GetStringGRFID(StringID string);
 
 uint ConvertKmhishSpeedToDisplaySpeed(uint speed, VehicleType type);
@@ -177,6 +179,19 @@ void AppendStringInPlace(struct format_buffer &result, StringID string, Args &&.
 	return AppendStringInPlaceWithArgs(result, string, params);
 }
 
+/**
+ * Get a parsed string with most special stringcodes replaced by the string parameters, using the formatted string cache.
+ * @param string String ID to format.
+ * @param args The parameters to set.
+ * @return The parsed string, which is only valid until the next call of this function or invalidation of the cache.
+ */
+template <typename... Args>
+std::string_view GetCachedString(StringID string, Args &&... args)
+{
+	auto params = MakeParameters(std::forward<Args>(args)...);
+	return GetCachedStringWithArgs(string, params);
+}
+
 /**
  * A searcher for missing glyphs.
  */
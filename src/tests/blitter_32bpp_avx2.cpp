@@ -0,0 +1,293 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file blitter_32bpp_avx2.cpp Tests that the AVX2 32bpp blitters draw exactly like the SSE4 blitters they extend. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../blitter/32bpp_anim_avx2.hpp"
+#include "../blitter/32bpp_avx2.hpp"
+#include "../core/random_func.hpp"
+#include "../gfx_func.h"
+#include "../palette_func.h"
+#include "../spritecache.h"
+#include "../table/palettes.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "../safeguards.h"
+
+static constexpr int SCREEN_WIDTH = 320;  ///< Width of the buffer the sprites are drawn to.
+static constexpr int SCREEN_HEIGHT = 240; ///< Height of the buffer the sprites are drawn to.
+static constexpr uint SPRITE_COUNT = 96;  ///< Number of sprites drawn in each blitter mode.
+
+static constexpr BlitterMode BLITTER_MODES[] = {
+	BlitterMode::Normal, BlitterMode::ColourRemap, BlitterMode::Transparent, BlitterMode::TransparentRemap,
+	BlitterMode::CrashRemap, BlitterMode::BlackRemap, BlitterMode::NormalWithBrightness, BlitterMode::ColourRemapWithBrightness,
+};
+
+/** Source pixels of a sprite, in the form the sprite loaders produce them. */
+struct SourceSprite {
+	uint16_t width;
+	uint16_t height;
+	std::vector<SpriteLoader::CommonPixel> pixels;
+};
+
+/** Position of a sprite on the screen. */
+struct SpritePlacement {
+	uint sprite;
+	int x;
+	int y;
+};
+
+/**
+ * Generate sprites resembling the sprites of a game: runs of transparent pixels, opaque and translucent
+ * pixels, and pixels using company colours or animated colours. Not every sprite has every kind of pixel,
+ * so the blitters' paths for sprites without remapping, animation or translucency are used as well.
+ * @param rnd The randomizer to generate the sprites with.
+ * @return The sprites.
+ */
+static std::vector<SourceSprite> GenerateSprites(Randomizer &rnd)
+{
+	std::vector<SourceSprite> sprites;
+	for (uint i = 0; i < SPRITE_COUNT; i++) {
+		SourceSprite &sprite = sprites.emplace_back();
+		sprite.width = 1 + rnd.Next(80);
+		sprite.height = 1 + rnd.Next(48);
+		sprite.pixels.resize(sprite.width * sprite.height);
+
+		const bool use_remap = HasBit(i, 0);
+		const bool use_anim = HasBit(i, 1);
+		const bool use_translucency = HasBit(i, 2);
+
+		for (uint y = 0; y < sprite.height; y++) {
+			/* Transparent margins of varying size on both sides, like the outline of most sprites. */
+			const uint left = rnd.Next(sprite.width / 2 + 1);
+			const uint right = sprite.width - rnd.Next(sprite.width / 2 + 1);
+			for (uint x = left; x < right; x++) {
+				SpriteLoader::CommonPixel &px = sprite.pixels[y * sprite.width + x];
+				const uint kind = rnd.Next(16);
+				if (kind == 0) continue; // Transparent pixel within the sprite.
+
+				px.r = GB(rnd.Next(), 0, 8);
+				px.g = GB(rnd.Next(), 0, 8);
+				px.b = GB(rnd.Next(), 0, 8);
+				px.a = (use_translucency && kind < 4) ? 1 + rnd.Next(254) : 255;
+				if (use_remap && kind >= 12) px.m = 1 + rnd.Next(PALETTE_ANIM_START - 1);
+				if (use_anim && kind == 11) px.m = PALETTE_ANIM_START + rnd.Next(245 - PALETTE_ANIM_START);
+			}
+		}
+	}
+	return sprites;
+}
+
+/**
+ * Generate the sprite positions, including sprites which are partially off screen.
+ * @param rnd The randomizer to generate the positions with.
+ * @param sprites The sprites to place.
+ * @return The placements.
+ */
+static std::vector<SpritePlacement> GeneratePlacements(Randomizer &rnd, const std::vector<SourceSprite> &sprites)
+{
+	std::vector<SpritePlacement> placements;
+	for (uint i = 0; i < sprites.size() * 4; i++) {
+		const uint sprite = i % sprites.size();
+		placements.push_back({ sprite, (int)rnd.Next(SCREEN_WIDTH + sprites[sprite].width) - sprites[sprite].width, (int)rnd.Next(SCREEN_HEIGHT + sprites[sprite].height) - sprites[sprite].height });
+	}
+	return placements;
+}
+
+/** A blitter with the sprites encoded for it, and a screen to draw them to. */
+struct BlitterTestScreen {
+	std::unique_ptr<Blitter> blitter;
+	std::vector<UniquePtrSpriteAllocator> allocators;
+	std::vector<const Sprite *> sprites;
+	std::vector<uint32_t> screen;
+	std::vector<uint8_t> background; ///< Contents of the screen before drawing, see #GetContents.
+
+	BlitterTestScreen(Blitter *blitter, const std::vector<SourceSprite> &source, const std::vector<uint32_t> &colours, const std::vector<uint16_t> &anim) : blitter(blitter), screen(SCREEN_WIDTH * SCREEN_HEIGHT)
+	{
+		/* Blitters with an animation buffer store each line of the animation buffer after the line of the screen. */
+		const bool has_anim_buffer = this->blitter->BufferSize(SCREEN_WIDTH, SCREEN_HEIGHT) > SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint32_t);
+		for (int y = 0; y < SCREEN_HEIGHT; y++) {
+			const uint8_t *line = reinterpret_cast<const uint8_t *>(colours.data() + y * SCREEN_WIDTH);
+			this->background.insert(this->background.end(), line, line + SCREEN_WIDTH * sizeof(uint32_t));
+			if (has_anim_buffer) {
+				const uint8_t *anim_line = reinterpret_cast<const uint8_t *>(anim.data() + y * SCREEN_WIDTH);
+				this->background.insert(this->background.end(), anim_line, anim_line + SCREEN_WIDTH * sizeof(uint16_t));
+			}
+		}
+
+		this->allocators.resize(source.size());
+		for (size_t i = 0; i < source.size(); i++) {
+			SpriteLoader::SpriteCollection collection{};
+			SpriteLoader::Sprite &s = collection[ZOOM_LVL_MIN];
+			s.width = source[i].width;
+			s.height = source[i].height;
+			s.type = SpriteType::Font; // Only the normal zoom level is encoded for fonts.
+			s.colours = SCC_RGB | SCC_ALPHA | SCC_PAL;
+			s.data = const_cast<SpriteLoader::CommonPixel *>(source[i].pixels.data());
+			this->sprites.push_back(this->blitter->Encode(collection, this->allocators[i]));
+		}
+	}
+
+	/**
+	 * Draw the sprites to the screen, on top of a background.
+	 * @param mode The blitter mode to draw in.
+	 * @param placements The sprites to draw, and where.
+	 * @param remap The colour remap to use.
+	 */
+	void Draw(BlitterMode mode, const std::vector<SpritePlacement> &placements, const uint8_t *remap)
+	{
+		_screen.dst_ptr = this->screen.data();
+		_screen.width = SCREEN_WIDTH;
+		_screen.height = SCREEN_HEIGHT;
+		_screen.pitch = SCREEN_WIDTH;
+		this->blitter->PostResize();
+		this->blitter->CopyFromBuffer(_screen.dst_ptr, this->background.data(), SCREEN_WIDTH, SCREEN_HEIGHT);
+
+		for (const SpritePlacement &placement : placements) {
+			const Sprite *sprite = this->sprites[placement.sprite];
+
+			Blitter::BlitterParams bp;
+			bp.skip_left = std::max(0, -placement.x);
+			bp.skip_top = std::max(0, -placement.y);
+			bp.left = std::max(0, placement.x);
+			bp.top = std::max(0, placement.y);
+			bp.width = std::min<int>(sprite->width - bp.skip_left, SCREEN_WIDTH - bp.left);
+			bp.height = std::min<int>(sprite->height - bp.skip_top, SCREEN_HEIGHT - bp.top);
+			if (bp.width <= 0 || bp.height <= 0) continue;
+
+			bp.sprite = sprite->data;
+			bp.sprite_width = sprite->width;
+			bp.sprite_height = sprite->height;
+			bp.dst = _screen.dst_ptr;
+			bp.pitch = _screen.pitch;
+			bp.remap = remap;
+			bp.brightness_adjust = 40;
+			this->blitter->Draw(&bp, mode, ZOOM_LVL_MIN);
+		}
+	}
+
+	/**
+	 * Get the contents of the screen, including the animation buffer of animated blitters.
+	 * @return The contents of the screen.
+	 */
+	std::vector<uint8_t> GetContents()
+	{
+		std::vector<uint8_t> contents(this->blitter->BufferSize(SCREEN_WIDTH, SCREEN_HEIGHT));
+		this->blitter->CopyToBuffer(_screen.dst_ptr, contents.data(), SCREEN_WIDTH, SCREEN_HEIGHT);
+		return contents;
+	}
+};
+
+/** The data drawn in every test. */
+struct BlitterTestData {
+	std::vector<SourceSprite> sprites;
+	std::vector<SpritePlacement> placements;
+	std::vector<uint32_t> background;
+	std::vector<uint16_t> anim_background;
+	std::array<uint8_t, 256> remap;
+
+	BlitterTestData()
+	{
+		Randomizer rnd;
+		rnd.SetSeed(0x32B99A2);
+
+		for (uint i = 0; i < 256; i++) {
+			_cur_palette.palette[i] = _palette.palette[i];
+			this->remap[i] = GB(rnd.Next(), 0, 8);
+		}
+
+		this->sprites = GenerateSprites(rnd);
+		this->placements = GeneratePlacements(rnd, this->sprites);
+		this->background.resize(SCREEN_WIDTH * SCREEN_HEIGHT);
+		for (uint32_t &px : this->background) px = rnd.Next() | 0xFF000000;
+		this->anim_background.resize(SCREEN_WIDTH * SCREEN_HEIGHT);
+		for (uint16_t &px : this->anim_background) px = (rnd.Next(4) == 0) ? (PALETTE_ANIM_START + rnd.Next(245 - PALETTE_ANIM_START)) | (DEFAULT_BRIGHTNESS << 8) : 0;
+	}
+};
+
+/**
+ * Draw the test data in every blitter mode with both blitters, and check that the results are the same.
+ * @param reference The blitter to compare with.
+ * @param blitter The blitter to check.
+ */
+static void CheckBlittersDrawTheSame(Blitter *reference, Blitter *blitter)
+{
+	BlitterTestData data;
+	BlitterTestScreen reference_screen(reference, data.sprites, data.background, data.anim_background);
+	BlitterTestScreen test_screen(blitter, data.sprites, data.background, data.anim_background);
+
+	for (BlitterMode mode : BLITTER_MODES) {
+		INFO("Blitter " << test_screen.blitter->GetName() << ", mode " << to_underlying(mode));
+
+		reference_screen.Draw(mode, data.placements, data.remap.data());
+		const std::vector<uint8_t> expected = reference_screen.GetContents();
+
+		test_screen.Draw(mode, data.placements, data.remap.data());
+		const std::vector<uint8_t> result = test_screen.GetContents();
+
+		CHECK(result == expected);
+	}
+}
+
+/**
+ * Time drawing the test data in every blitter mode with both blitters.
+ * @param reference The blitter to compare with.
+ * @param blitter The blitter to time.
+ */
+static void TimeBlitters(Blitter *reference, Blitter *blitter)
+{
+	constexpr uint PASSES = 200;
+
+	BlitterTestData data;
+	BlitterTestScreen screens[] = {
+		{ reference, data.sprites, data.background, data.anim_background },
+		{ blitter, data.sprites, data.background, data.anim_background },
+	};
+
+	for (BlitterMode mode : BLITTER_MODES) {
+		std::chrono::steady_clock::duration durations[2];
+		for (size_t i = 0; i < std::size(screens); i++) {
+			const auto start = std::chrono::steady_clock::now();
+			for (uint pass = 0; pass < PASSES; pass++) {
+				screens[i].Draw(mode, data.placements, data.remap.data());
+			}
+			durations[i] = std::chrono::steady_clock::now() - start;
+		}
+
+		auto us = [](std::chrono::steady_clock::duration d) { return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / PASSES; };
+		WARN(screens[1].blitter->GetName() << ", mode " << to_underlying(mode) << ": " << us(durations[1]) << " us per pass, "
+				<< screens[0].blitter->GetName() << ": " << us(durations[0]) << " us per pass");
+	}
+}
+
+TEST_CASE("Blitter_32bppAVX2 draws the same as Blitter_32bppSSE4")
+{
+	if (!HasCPUAVX2Support()) return;
+	CheckBlittersDrawTheSame(new Blitter_32bppSSE4(), new Blitter_32bppAVX2());
+}
+
+TEST_CASE("Blitter_32bppAVX2_Anim draws the same as Blitter_32bppSSE4_Anim")
+{
+	if (!HasCPUAVX2Support()) return;
+	_screen_disable_anim = false;
+	CheckBlittersDrawTheSame(static_cast<Blitter_32bppSSE2_Anim *>(new Blitter_32bppSSE4_Anim()), static_cast<Blitter_32bppSSE2_Anim *>(new Blitter_32bppAVX2_Anim()));
+}
+
+TEST_CASE("Blitter_32bppAVX2 drawing time", "[.][blitter]")
+{
+	if (!HasCPUAVX2Support()) return;
+	TimeBlitters(new Blitter_32bppSSE4(), new Blitter_32bppAVX2());
+	_screen_disable_anim = false;
+	TimeBlitters(static_cast<Blitter_32bppSSE2_Anim *>(new Blitter_32bppSSE4_Anim()), static_cast<Blitter_32bppSSE2_Anim *>(new Blitter_32bppAVX2_Anim()));
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bucket_queue.cpp Test functionality from pathfinder/queue.h */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../pathfinder/queue.h"
+
+TEST_CASE("BucketQueue - Monotone")
+{
+	BucketQueue queue;
+
+	queue.Push(0, 5);
+	queue.Push(1, 3);
+	queue.Push(2, 8);
+	queue.Push(3, 3);
+	CHECK(queue.Size() == 4);
+
+	/* Equal priorities are popped in LIFO order */
+	CHECK(queue.Pop() == 3);
+	CHECK(queue.Pop() == 1);
+
+	queue.Push(4, 6);
+	CHECK(queue.Pop() == 0);
+	CHECK(queue.Pop() == 4);
+	CHECK(queue.Pop() == 2);
+	CHECK(queue.Pop() == UINT32_MAX);
+	CHECK(queue.Size() == 0);
+}
+
+TEST_CASE("BucketQueue - Delete and re-push")
+{
+	BucketQueue queue;
+
+	queue.Push(0, 10);
+	queue.Push(1, 12);
+	queue.Push(2, 12);
+
+	/* Decrease key */
+	queue.Delete(2);
+	queue.Push(2, 11);
+
+	CHECK(queue.Pop() == 0);
+	CHECK(queue.Pop() == 2);
+	CHECK(queue.Pop() == 1);
+	CHECK(queue.Pop() == UINT32_MAX);
+}
+
+TEST_CASE("BucketQueue - Non-monotone")
+{
+	BucketQueue queue;
+
+	queue.Push(0, 10);
+	queue.Push(1, 20);
+	CHECK(queue.Pop() == 0);
+
+	/* Below the last popped priority and below the first bucket */
+	queue.Push(2, 15);
+	queue.Push(3, 2);
+	CHECK(queue.Pop() == 3);
+	CHECK(queue.Pop() == 2);
+	CHECK(queue.Pop() == 1);
+
+	queue.Clear();
+	queue.Push(5, 100);
+	CHECK(queue.Pop() == 5);
+	CHECK(queue.Pop() == UINT32_MAX);
+}
@@ -105,6 +105,7 @@ static void ChangeTimetable(Vehicle *v, VehicleOrderID order_number, uint32_t va
 	}
 	v->orders->UpdateTotalDuration(total_delta);
 	v->orders->UpdateTimetableDuration(timetable_delta);
+	v->orders->OnScheduleChanged();
 
 	SetTimetableWindowsDirty(v, (mtf == MTF_ASSIGN_SCHEDULE) ? STWDF_SCHEDULED_DISPATCH : STWDF_NONE);
 
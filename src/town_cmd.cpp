@@ -174,6 +174,7 @@ Town::~Town()
  */
 void Town::PostDestructor(size_t)
 {
+	InvalidateFormattedStringCache();
 	InvalidateWindowData(WC_TOWN_DIRECTORY, 0, TDIWD_FORCE_REBUILD);
 	UpdateNearestTownForRoadTiles(false);
 
@@ -3334,6 +3335,7 @@ CommandCost CmdRenameTown(DoCommandFlag flags, TownID town_id, const std::string
 		ClearAllStationCachedNames();
 		ClearAllIndustryCachedNames();
 		UpdateAllStationVirtCoords();
+		InvalidateFormattedStringCache();
 	}
 	return CommandCost();
 }
@@ -1157,7 +1157,7 @@ public:
 					}
 
 					format_buffer buffer;
-					AppendStringInPlace(buffer, GetTownString(t), t->index, t->cache.population);
+					buffer.append(GetCachedString(GetTownString(t), t->index, t->cache.population));
 					if (_settings_client.gui.show_town_growth_status) {
 						AppendStringInPlaceWithArgs(buffer, GetTownGrowthStatusString(t), {});
 					}
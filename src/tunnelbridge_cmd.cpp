@@ -21,6 +21,7 @@
 #include "roadveh.h"
 #include "pathfinder/yapf/yapf_cache.h"
 #include "pathfinder/water_regions.h"
+#include "pathfinder/road_regions.h"
 #include "newgrf_sound.h"
 #include "autoslope.h"
 #include "tunnelbridge_map.h"
@@ -769,9 +770,11 @@ CommandCost CmdBuildBridge(DoCommandFlag flags, TileIndex tile_end, TileIndex ti
 				make_bridge_ramp(tile_start, dir);
 				make_bridge_ramp(tile_end, ReverseDiagDir(dir));
 				AddRoadTunnelBridgeInfrastructure(tile_start, tile_end);
+				InvalidateRoadRegion(tile_start);
+				InvalidateRoadRegion(tile_end);
 				if (RoadLayoutChangeNotificationEnabled(true)) {
 					if (IsRoadCustomBridgeHead(tile_start) || IsRoadCustomBridgeHead(tile_end)) {
-						NotifyRoadLayoutChanged();
+						NotifyRoadLayoutChanged(tile_start, tile_end);
 					} else {
 						NotifyRoadLayoutChangedIfSimpleTunnelBridgeNonLeaf(tile_start, tile_end, dir, GetRoadTramType(roadtype));
 					}
@@ -1142,6 +1145,8 @@ CommandCost CmdBuildTunnel(DoCommandFlag flags, TileIndex start_tile, TransportT
 			RoadType tram_rt = RoadTypeIsTram(roadtype) ? roadtype : INVALID_ROADTYPE;
 			MakeRoadTunnel(start_tile, company, t->index, direction,                 road_rt, tram_rt);
 			MakeRoadTunnel(end_tile,   company, t->index, ReverseDiagDir(direction), road_rt, tram_rt);
+			InvalidateRoadRegion(start_tile);
+			InvalidateRoadRegion(end_tile);
 			UpdateRoadCachedOneWayStatesAroundTile(start_tile);
 			UpdateRoadCachedOneWayStatesAroundTile(end_tile);
 		}
@@ -1311,6 +1316,8 @@ static CommandCost DoClearTunnel(TileIndex tile, DoCommandFlag flags)
 
 			DoClearSquare(tile);
 			DoClearSquare(endtile);
+			InvalidateRoadRegion(tile);
+			InvalidateRoadRegion(endtile);
 
 			UpdateRoadCachedOneWayStatesAroundTile(tile);
 			UpdateRoadCachedOneWayStatesAroundTile(endtile);
@@ -1420,9 +1427,11 @@ static CommandCost DoClearBridge(TileIndex tile, DoCommandFlag flags)
 			}
 		} else if (GetTunnelBridgeTransportType(tile) == TRANSPORT_ROAD) {
 			SubtractRoadTunnelBridgeInfrastructure(tile, endtile);
+			InvalidateRoadRegion(tile);
+			InvalidateRoadRegion(endtile);
 			if (RoadLayoutChangeNotificationEnabled(false)) {
 				if (IsRoadCustomBridgeHead(tile) || IsRoadCustomBridgeHead(endtile)) {
-					NotifyRoadLayoutChanged();
+					NotifyRoadLayoutChanged(tile, endtile);
 				} else {
 					if (HasRoadTypeRoad(tile)) NotifyRoadLayoutChangedIfSimpleTunnelBridgeNonLeaf(tile, endtile, direction, RTT_ROAD);
 					if (HasRoadTypeTram(tile)) NotifyRoadLayoutChangedIfSimpleTunnelBridgeNonLeaf(tile, endtile, direction, RTT_TRAM);
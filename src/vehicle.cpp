@@ -56,6 +56,7 @@
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/refresh.h"
 #include "framerate_type.h"
+#include "zone_profiler.h"
 #include "blitter/factory.hpp"
 #include "tbtr_template_vehicle_func.h"
 #include "tbtr_template_vehicle_cmd.h"
@@ -1066,6 +1067,7 @@ void InitializeVehicles()
 	_vehicles_to_autoreplace.clear();
 	ResetVehicleHash();
 	ResetDisasterVehicleTargeting();
+	ClearEffectParticles();
 }
 
 uint CountVehiclesInChain(const Vehicle *v)
@@ -1227,6 +1229,9 @@ void Vehicle::PreDestructor()
 
 	Company::Get(this->owner)->freeunits[this->type].ReleaseID(this->unitnumber);
 
+	/* The ID of a primary vehicle may be reused by a vehicle with another name. */
+	if (this->IsPrimaryVehicle()) InvalidateFormattedStringCache();
+
 	if (this->type == VEH_AIRCRAFT && this->IsPrimaryVehicle()) {
 		Aircraft *a = Aircraft::From(this);
 		Station *st = GetTargetAirportIfValid(a);
@@ -1665,6 +1670,7 @@ void CallVehicleTicks()
 		SCOPE_INFO_FMT([&si_st], "CallVehicleTicks: LoadUnloadStation: {}", StationInfoDumper(si_st));
 		for (Station *st : Station::Iterate()) {
 			si_st = st;
+			ZoneProfilerScope zone(ZPZ_STATION_LOAD_UNLOAD, st->index);
 			LoadUnloadStation(st);
 		}
 	}
@@ -1690,14 +1696,17 @@ void CallVehicleTicks()
 		for (VehicleID id : _tick_effect_veh_cache) {
 			EffectVehicle *u = EffectVehicle::Get(id);
 			v = u;
+			ZoneProfilerScope zone(ZPZ_VEHICLE_EFFECT, id);
 			u->EffectVehicle::Tick();
 		}
 	}
 	if (!_tick_effect_veh_cache.empty()) RecordSyncEvent(NSRE_VEH_EFFECT);
+	TickEffectParticles();
 	{
 		PerformanceMeasurer framerate(PFE_GL_TRAINS);
 		for (Train *front : _tick_train_front_cache) {
 			v = front;
+			ZoneProfilerScope zone(ZPZ_VEHICLE_TRAIN, front->index);
 			if (!front->Train::Tick()) continue;
 			for (Train *u = front; u != nullptr; u = u->Next()) {
 				u->tick_counter++;
@@ -1711,6 +1720,7 @@ void CallVehicleTicks()
 		PerformanceMeasurer framerate(PFE_GL_ROADVEHS);
 		for (RoadVehicle *front : _tick_road_veh_front_cache) {
 			v = front;
+			ZoneProfilerScope zone(ZPZ_VEHICLE_ROAD, front->index);
 			if (!front->RoadVehicle::Tick()) continue;
 			for (RoadVehicle *u = front; u != nullptr; u = u->Next()) {
 				u->tick_counter++;
@@ -1724,6 +1734,7 @@ void CallVehicleTicks()
 		PerformanceMeasurer framerate(PFE_GL_AIRCRAFT);
 		for (Aircraft *front : _tick_aircraft_front_cache) {
 			v = front;
+			ZoneProfilerScope zone(ZPZ_VEHICLE_AIRCRAFT, front->index);
 			if (!front->Aircraft::Tick()) continue;
 			for (Aircraft *u = front; u != nullptr; u = u->Next()) {
 				VehicleTickCargoAging(u);
@@ -1736,6 +1747,7 @@ void CallVehicleTicks()
 		PerformanceMeasurer framerate(PFE_GL_SHIPS);
 		for (Ship *s : _tick_ship_cache) {
 			v = s;
+			ZoneProfilerScope zone(ZPZ_VEHICLE_SHIP, s->index);
 			if (!s->Ship::Tick()) continue;
 			for (Ship *u = s; u != nullptr; u = u->Next()) {
 				VehicleTickCargoAging(u);
@@ -1748,6 +1760,7 @@ void CallVehicleTicks()
 		for (Vehicle *u : _tick_other_veh_cache) {
 			if (!u) continue;
 			v = u;
+			ZoneProfilerScope zone(ZPZ_VEHICLE_OTHER, u->index);
 			u->Tick();
 		}
 	}
@@ -2413,8 +2426,7 @@ bool Vehicle::HandleBreakdown()
 								SndPlayVehicleFx((_settings_game.game_creation.landscape != LandscapeType::Toyland) ? SND_10_BREAKDOWN_TRAIN_SHIP : SND_3A_BREAKDOWN_TRAIN_SHIP_TOYLAND, this);
 							}
 							if (!(this->vehstatus & VS_HIDDEN) && !EngInfo(this->engine_type)->misc_flags.Test(EngineMiscFlag::NoBreakdownSmoke) && this->breakdown_delay > 0) {
-								EffectVehicle *u = CreateEffectVehicleRel(this, 4, 4, 5, EV_BREAKDOWN_SMOKE);
-								if (u != nullptr) u->animation_state = this->breakdown_delay * 2;
+								CreateEffectParticleRel(this, 4, 4, 5, EV_BREAKDOWN_SMOKE, this->breakdown_delay * 2);
 							}
 							/* Max Speed reduction*/
 							if (_settings_game.vehicle.improved_breakdowns) {
@@ -2455,8 +2467,7 @@ bool Vehicle::HandleBreakdown()
 				}
 				if ((!(this->vehstatus & VS_HIDDEN)) && (this->breakdown_type == BREAKDOWN_LOW_SPEED || this->breakdown_type == BREAKDOWN_LOW_POWER)
 						&& !EngInfo(this->engine_type)->misc_flags.Test(EngineMiscFlag::NoBreakdownSmoke)) {
-					EffectVehicle *u = CreateEffectVehicleRel(this, 0, 0, 2, EV_BREAKDOWN_SMOKE); //some grey clouds to indicate a broken engine
-					if (u != nullptr) u->animation_state = 25;
+					CreateEffectParticleRel(this, 0, 0, 2, EV_BREAKDOWN_SMOKE, 25); //some grey clouds to indicate a broken engine
 				}
 			} else {
 				switch (this->breakdown_type) {
@@ -2468,8 +2479,7 @@ bool Vehicle::HandleBreakdown()
 								(train_or_ship ? SND_3A_BREAKDOWN_TRAIN_SHIP_TOYLAND : SND_35_BREAKDOWN_ROADVEHICLE_TOYLAND), this);
 						}
 						if (!(this->vehstatus & VS_HIDDEN) && !EngInfo(this->engine_type)->misc_flags.Test(EngineMiscFlag::NoBreakdownSmoke) && this->breakdown_delay > 0) {
-							EffectVehicle *u = CreateEffectVehicleRel(this, 4, 4, 5, EV_BREAKDOWN_SMOKE);
-							if (u != nullptr) u->animation_state = this->breakdown_delay * 2;
+							CreateEffectParticleRel(this, 4, 4, 5, EV_BREAKDOWN_SMOKE, this->breakdown_delay * 2);
 						}
 						if (_settings_game.vehicle.improved_breakdowns) {
 							if (this->type == VEH_ROAD) {
@@ -2496,8 +2506,7 @@ bool Vehicle::HandleBreakdown()
 						(this->breakdown_type == BREAKDOWN_LOW_SPEED || this->breakdown_type == BREAKDOWN_LOW_POWER) &&
 						!EngInfo(this->engine_type)->misc_flags.Test(EngineMiscFlag::NoBreakdownSmoke)) {
 					/* Some gray clouds to indicate a broken RV */
-					EffectVehicle *u = CreateEffectVehicleRel(this, 0, 0, 2, EV_BREAKDOWN_SMOKE);
-					if (u != nullptr) u->animation_state = 25;
+					CreateEffectParticleRel(this, 0, 0, 2, EV_BREAKDOWN_SMOKE, 25);
 				}
 				this->First()->MarkDirty();
 				SetWindowDirty(WC_VEHICLE_VIEW, this->index);
@@ -4270,10 +4279,10 @@ static void SpawnAdvancedVisualEffect(const Vehicle *v)
 
 		if (type >= 0xF0) {
 			switch (type) {
-				case 0xF1: CreateEffectVehicleRel(v, x_center + x, y_center + y, z, EV_STEAM_SMOKE); break;
-				case 0xF2: CreateEffectVehicleRel(v, x_center + x, y_center + y, z, EV_DIESEL_SMOKE); break;
-				case 0xF3: CreateEffectVehicleRel(v, x_center + x, y_center + y, z, EV_ELECTRIC_SPARK); break;
-				case 0xFA: CreateEffectVehicleRel(v, x_center + x, y_center + y, z, EV_BREAKDOWN_SMOKE_AIRCRAFT); break;
+				case 0xF1: CreateEffectParticleRel(v, x_center + x, y_center + y, z, EV_STEAM_SMOKE); break;
+				case 0xF2: CreateEffectParticleRel(v, x_center + x, y_center + y, z, EV_DIESEL_SMOKE); break;
+				case 0xF3: CreateEffectParticleRel(v, x_center + x, y_center + y, z, EV_ELECTRIC_SPARK); break;
+				case 0xFA: CreateEffectParticleRel(v, x_center + x, y_center + y, z, EV_BREAKDOWN_SMOKE_AIRCRAFT); break;
 				default: break;
 			}
 		}
@@ -4430,7 +4439,7 @@ void Vehicle::ShowVisualEffect(uint max_speed) const
 				y = -y;
 			}
 
-			CreateEffectVehicleRel(v, x, y, 10, evt);
+			CreateEffectParticleRel(v, x, y, 10, evt);
 		}
 
 		if (HasBit(v->vcache.cached_veh_flags, VCF_LAST_VISUAL_EFFECT)) break;
@@ -4987,6 +4996,7 @@ void DumpVehicleStats(struct format_target &buffer)
 	buffer.append("Totals\n");
 	print_stats(totals, true);
 	buffer.format("Total vehicles: {}\n", Vehicle::GetNumItems());
+	buffer.format("Effect particles: {}\n", GetEffectParticleCount());
 }
 
 void AdjustVehicleStateTicksBase(StateTicksDelta delta)
@@ -18,6 +18,7 @@
 #include "newgrf_text.h"
 #include "vehicle_func.h"
 #include "string_func.h"
+#include "strings_func.h"
 #include "depot_map.h"
 #include "vehiclelist.h"
 #include "engine_func.h"
@@ -1662,6 +1663,7 @@ CommandCost CmdRenameVehicle(DoCommandFlag flags, VehicleID veh_id, const std::s
 		} else {
 			v->name = text;
 		}
+		InvalidateFormattedStringCache();
 		InvalidateWindowClassesData(GetWindowClassForVehicleType(v->type), 1);
 		InvalidateWindowClassesData(WC_DEPARTURES_BOARD, 0);
 		MarkWholeScreenDirty();
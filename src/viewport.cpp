@@ -87,6 +87,7 @@
 #include "core/string_builder.hpp"
 #include "zoom_func.h"
 #include "vehicle_func.h"
+#include "effectvehicle_func.h"
 #include "company_func.h"
 #include "waypoint_func.h"
 #include "window_func.h"
@@ -2560,8 +2561,7 @@ static void ViewportDrawStrings(ViewportDrawerDynamic *vdd, ZoomLevel zoom, cons
 		int y = UnScaleByZoom(ss.y, zoom);
 		int h = WidgetDimensions::scaled.fullbevel.Vertical() + GetCharacterHeight(small ? FS_SMALL : FS_NORMAL);
 
-		format_buffer string;
-		AppendStringInPlace(string, ss.string, ss.params[0], ss.params[1]);
+		const std::string_view string = GetCachedString(ss.string, ss.params[0], ss.params[1]);
 
 		TextColour colour = TC_WHITE;
 		if (ss.flags.Test(ViewportStringFlag::ColourRect)) {
@@ -4102,6 +4102,7 @@ void ViewportDoDraw(Viewport *vp, int left, int top, int right, int bottom, NWid
 		/* Classic rendering. */
 		ViewportAddLandscape();
 		ViewportAddVehicles(&_vdd->dpi, vp->update_vehicles);
+		ViewportAddEffectParticles(&_vdd->dpi);
 
 		for (const TileSpriteToDraw &ts : _vdd->tile_sprites_to_draw) {
 			PrepareDrawSpriteViewportSpriteStore(_vdd->sprite_data, &_vdd->dpi, ts.image, ts.pal);
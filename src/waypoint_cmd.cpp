@@ -17,6 +17,7 @@
 #include "waypoint_base.h"
 #include "pathfinder/yapf/yapf_cache.h"
 #include "pathfinder/water_regions.h"
+#include "pathfinder/road_regions.h"
 #include "strings_func.h"
 #include "viewport_func.h"
 #include "viewport_kdtree.h"
@@ -473,7 +474,8 @@ CommandCost CmdBuildRoadWaypoint(DoCommandFlag flags, TileIndex start_tile, Axis
 			MarkTileDirtyByTile(cur_tile);
 			UpdateRoadCachedOneWayStatesAroundTile(cur_tile);
 		}
-		NotifyRoadLayoutChanged(true);
+		InvalidateRoadRegions(roadstop_area.tile, TileAddXY(roadstop_area.tile, roadstop_area.w - 1, roadstop_area.h - 1));
+		NotifyRoadLayoutChanged(roadstop_area.tile, TileAddXY(roadstop_area.tile, roadstop_area.w - 1, roadstop_area.h - 1), true);
 		DirtyCompanyInfrastructureWindows(wp->owner);
 	}
 	return cost;
@@ -620,6 +622,7 @@ CommandCost CmdRenameWaypoint(DoCommandFlag flags, StationID waypoint_id, const
 		}
 
 		wp->UpdateVirtCoord();
+		InvalidateFormattedStringCache();
 	}
 	return CommandCost();
 }
@@ -689,6 +692,7 @@ CommandCost CmdExchangeWaypointNames(DoCommandFlag flags, StationID waypoint_id1
 		std::swap(wp->town_cn, wp2->town_cn);
 		wp->UpdateVirtCoord();
 		wp2->UpdateVirtCoord();
+		InvalidateFormattedStringCache();
 	}
 
 	return CommandCost();
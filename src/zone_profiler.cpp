@@ -0,0 +1,194 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file zone_profiler.cpp Scoped-zone profiler, for finding out what makes individual game ticks slow. */
+
+#include "stdafx.h"
+#include "zone_profiler.h"
+#include "fileio_func.h"
+#include "thread.h"
+#include "core/format.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "safeguards.h"
+
+std::atomic<bool> _zone_profiler_enabled{ false };
+
+namespace {
+	/** A completed zone. */
+	struct ZoneEvent {
+		const char *name; ///< Zone name.
+		uint32_t id;      ///< Entity ID, or #ZONE_PROFILER_NO_ID.
+		uint64_t start;   ///< Start timestamp in nanoseconds.
+		uint64_t end;     ///< End timestamp in nanoseconds.
+	};
+
+	static const size_t ZONE_BUFFER_SIZE = 1 << 18; ///< Number of zones kept per thread.
+
+	/** Ring buffer of completed zones of a single thread. */
+	struct ZoneThreadBuffer {
+		std::mutex lock;                     ///< Lock between the owning thread and #ZoneProfilerWriteChromeTrace.
+		std::unique_ptr<ZoneEvent[]> events; ///< Ring buffer of #ZONE_BUFFER_SIZE events.
+		size_t next = 0;                     ///< Next position to write.
+		size_t count = 0;                    ///< Number of valid events.
+		std::string thread_name;             ///< Name of the owning thread.
+	};
+
+	std::mutex _zone_buffers_lock;                               ///< Lock for #_zone_buffers.
+	std::vector<std::unique_ptr<ZoneThreadBuffer>> _zone_buffers; ///< Buffers of all threads which ever recorded a zone, never freed.
+	thread_local ZoneThreadBuffer *_zone_thread_buffer = nullptr; ///< Buffer of the current thread.
+
+	ZoneThreadBuffer *GetZoneThreadBuffer()
+	{
+		if (_zone_thread_buffer != nullptr) return _zone_thread_buffer;
+
+		std::unique_ptr<ZoneThreadBuffer> buffer = std::make_unique<ZoneThreadBuffer>();
+		buffer->events.reset(new ZoneEvent[ZONE_BUFFER_SIZE]);
+
+		format_buffer name;
+		GetCurrentThreadName(name);
+		if (name.empty()) name.append(IsMainThread() ? "main" : "unnamed");
+		buffer->thread_name = name.to_string();
+
+		std::lock_guard<std::mutex> guard(_zone_buffers_lock);
+		_zone_thread_buffer = buffer.get();
+		_zone_buffers.push_back(std::move(buffer));
+		return _zone_thread_buffer;
+	}
+}
+
+/**
+ * Get the current profiler timestamp.
+ * @return Timestamp in nanoseconds.
+ */
+uint64_t ZoneProfilerNow()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Record a completed zone in the ring buffer of the current thread.
+ * @param name Zone name, one of the ZPZ_* constants.
+ * @param id Entity ID, or #ZONE_PROFILER_NO_ID.
+ * @param start Start timestamp, as returned by #ZoneProfilerNow.
+ */
+void ZoneProfilerRecord(const char *name, uint32_t id, uint64_t start)
+{
+	const uint64_t end = ZoneProfilerNow();
+	ZoneThreadBuffer *buffer = GetZoneThreadBuffer();
+
+	std::lock_guard<std::mutex> guard(buffer->lock);
+	buffer->events[buffer->next] = { name, id, start, end };
+	buffer->next = (buffer->next + 1) % ZONE_BUFFER_SIZE;
+	if (buffer->count < ZONE_BUFFER_SIZE) buffer->count++;
+}
+
+/**
+ * Start recording zones, this discards all previously recorded zones.
+ */
+void ZoneProfilerStart()
+{
+	{
+		std::lock_guard<std::mutex> guard(_zone_buffers_lock);
+		for (auto &buffer : _zone_buffers) {
+			std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+			buffer->next = 0;
+			buffer->count = 0;
+		}
+	}
+	_zone_profiler_enabled.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * Stop recording zones, the recorded zones are kept until the next #ZoneProfilerStart.
+ */
+void ZoneProfilerStop()
+{
+	_zone_profiler_enabled.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Write the zones of the last ticks in the Chrome trace event JSON format.
+ * @param filename File to write.
+ * @param ticks Number of most recent ticks to write, zones of all threads which ended before the oldest of these ticks started are skipped.
+ *              If 0 or fewer ticks were recorded, all recorded zones are written.
+ * @param[out] events_written Number of zones written.
+ * @return Whether the file could be written.
+ */
+bool ZoneProfilerWriteChromeTrace(const std::string &filename, uint ticks, size_t &events_written)
+{
+	struct ThreadEvents {
+		std::string name;
+		std::vector<ZoneEvent> events;
+	};
+	std::vector<ThreadEvents> threads;
+
+	{
+		std::lock_guard<std::mutex> guard(_zone_buffers_lock);
+		for (auto &buffer : _zone_buffers) {
+			std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+			ThreadEvents &te = threads.emplace_back();
+			te.name = buffer->thread_name;
+			te.events.reserve(buffer->count);
+			size_t pos = (buffer->next + ZONE_BUFFER_SIZE - buffer->count) % ZONE_BUFFER_SIZE;
+			for (size_t i = 0; i < buffer->count; i++) {
+				te.events.push_back(buffer->events[pos]);
+				pos = (pos + 1) % ZONE_BUFFER_SIZE;
+			}
+		}
+	}
+
+	/* Find the start of the oldest tick to include */
+	std::vector<uint64_t> tick_starts;
+	for (const ThreadEvents &te : threads) {
+		for (const ZoneEvent &ev : te.events) {
+			if (ev.name == ZPZ_TICK) tick_starts.push_back(ev.start);
+		}
+	}
+	uint64_t cutoff = 0;
+	if (ticks > 0 && ticks <= tick_starts.size()) {
+		std::nth_element(tick_starts.begin(), tick_starts.begin() + (ticks - 1), tick_starts.end(), std::greater<uint64_t>());
+		cutoff = tick_starts[ticks - 1];
+	}
+
+	uint64_t base = UINT64_MAX;
+	for (const ThreadEvents &te : threads) {
+		for (const ZoneEvent &ev : te.events) {
+			if (ev.end >= cutoff) base = std::min(base, ev.start);
+		}
+	}
+
+	auto f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (!f.has_value()) return false;
+
+	events_written = 0;
+	fmt::print(*f, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+	for (size_t tid = 0; tid < threads.size(); tid++) {
+		ThreadEvents &te = threads[tid];
+		for (char &c : te.name) {
+			if (c == '"' || c == '\\' || static_cast<uint8_t>(c) < 0x20) c = '_';
+		}
+		fmt::print(*f, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", first ? "" : ",\n", tid, te.name);
+		first = false;
+
+		for (const ZoneEvent &ev : te.events) {
+			if (ev.end < cutoff) continue;
+			fmt::print(*f, ",\n{{\"name\":\"{}\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}", ev.name, tid, (ev.start - base) / 1000.0, (ev.end - ev.start) / 1000.0);
+			if (ev.id != ZONE_PROFILER_NO_ID) fmt::print(*f, ",\"args\":{{\"id\":{}}}", ev.id);
+			fmt::print(*f, "}}");
+			events_written++;
+		}
+	}
+	fmt::print(*f, "\n]}}\n");
+
+	return true;
+}
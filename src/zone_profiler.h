@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file zone_profiler.h Scoped-zone profiler, for finding out what makes individual game ticks slow. */
+
+#ifndef ZONE_PROFILER_H
+#define ZONE_PROFILER_H
+
+#include <atomic>
+#include <string>
+
+/**
+ * Scoped-zone profiling.
+ * The profiler is always compiled in, but disabled by default. When disabled a zone costs a single relaxed atomic load.
+ * When enabled, each completed zone is recorded into a ring buffer of the thread it ran on, and the last few ticks can be
+ * written out in the Chrome trace event format (chrome://tracing, Perfetto).
+ *
+ * Usage:
+ * ZoneProfilerScope zone(ZPZ_VEHICLE_TRAIN, v->index);
+ * --Do your code--
+ */
+
+/** Names of profiled zones. The zone name pointers are compared by identity, so always use these constants. */
+inline constexpr char ZPZ_TICK[]                = "Tick";
+inline constexpr char ZPZ_TILE_LOOP[]           = "TileLoop";
+inline constexpr char ZPZ_VEHICLE_TRAIN[]       = "Train";
+inline constexpr char ZPZ_VEHICLE_ROAD[]        = "RoadVehicle";
+inline constexpr char ZPZ_VEHICLE_SHIP[]        = "Ship";
+inline constexpr char ZPZ_VEHICLE_AIRCRAFT[]    = "Aircraft";
+inline constexpr char ZPZ_VEHICLE_EFFECT[]      = "EffectVehicle";
+inline constexpr char ZPZ_VEHICLE_OTHER[]       = "OtherVehicle";
+inline constexpr char ZPZ_STATION_LOAD_UNLOAD[] = "LoadUnloadStation";
+inline constexpr char ZPZ_STATION_TICK[]        = "StationTick";
+inline constexpr char ZPZ_LINK_GRAPH_JOB[]      = "LinkGraphJob";
+inline constexpr char ZPZ_SCRIPT_AI[]           = "AI";
+inline constexpr char ZPZ_SCRIPT_GS[]           = "GameScript";
+inline constexpr char ZPZ_PF_TRAIN[]            = "PathfinderTrain";
+inline constexpr char ZPZ_PF_ROAD[]             = "PathfinderRoadVehicle";
+inline constexpr char ZPZ_PF_SHIP[]             = "PathfinderShip";
+
+static const uint32_t ZONE_PROFILER_NO_ID = UINT32_MAX; ///< Entity ID of zones which do not belong to an entity.
+
+extern std::atomic<bool> _zone_profiler_enabled;
+
+uint64_t ZoneProfilerNow();
+void ZoneProfilerRecord(const char *name, uint32_t id, uint64_t start);
+
+void ZoneProfilerStart();
+void ZoneProfilerStop();
+bool ZoneProfilerWriteChromeTrace(const std::string &filename, uint ticks, size_t &events_written);
+
+/** RAII class for recording a profiled zone, see #ZoneProfilerRecord. */
+struct ZoneProfilerScope {
+	const char *name; ///< Zone name, one of the ZPZ_* constants.
+	uint32_t id;      ///< Entity ID (vehicle, station, company, ...), or #ZONE_PROFILER_NO_ID.
+	uint64_t start;   ///< Start timestamp.
+	bool active;      ///< Whether the profiler was enabled when the zone was entered.
+
+	inline ZoneProfilerScope(const char *name, uint32_t id = ZONE_PROFILER_NO_ID) : name(name), id(id), start(0), active(_zone_profiler_enabled.load(std::memory_order_relaxed))
+	{
+		if (this->active) [[unlikely]] this->start = ZoneProfilerNow();
+	}
+
+	inline ~ZoneProfilerScope()
+	{
+		if (this->active) [[unlikely]] ZoneProfilerRecord(this->name, this->id, this->start);
+	}
+
+	ZoneProfilerScope(const ZoneProfilerScope &) = delete;
+	ZoneProfilerScope &operator=(const ZoneProfilerScope &) = delete;
+};
+
+#endif /* ZONE_PROFILER_H */